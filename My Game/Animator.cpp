@@ -0,0 +1,145 @@
+/// \file Animator.cpp
+/// \brief Code for the sprite animator CAnimator.
+
+#include <algorithm>
+
+#include "Animator.h"
+#include "Object.h"
+
+CAnimClip CAnimator::m_cClip[(UINT)eSprite::Size];
+
+/// Build the clip table from the number of frames in each sprite. Every clip
+/// plays at `ANIM_FRAME_TIME` seconds per frame and loops, except for the
+/// player's attacks, which stop on their last frame. The renderer must have
+/// loaded the sprites before this is called.
+
+void CAnimator::BuildClips(){
+  for(UINT i=0; i<(UINT)eSprite::Size; i++){
+    CAnimClip& c = m_cClip[i]; //shorthand
+    c = CAnimClip();
+    c.m_nFrames = std::max(1U, (UINT)m_pRenderer->GetNumFrames(i));
+  } //for
+
+  const eSprite attack[] = {
+    eSprite::PlayerAttackLeft, eSprite::PlayerAttackRight,
+    eSprite::PlayerAttackUp, eSprite::PlayerAttackDown
+  }; //attack
+
+  for(eSprite t: attack)
+    m_cClip[(UINT)t].m_bLoop = false;
+} //BuildClips
+
+/// Reader function for the clip that a sprite is played as.
+/// \param t Sprite index.
+/// \return Clip.
+
+const CAnimClip& CAnimator::GetClip(UINT t){
+  return m_cClip[t];
+} //GetClip
+
+/// Reserve space for a number of entries in each of the arrays.
+/// \param n Number of entries.
+
+void CAnimator::reserve(size_t n){
+  m_vecSprite.reserve(n);
+  m_vecFrame.reserve(n);
+  m_vecTime.reserve(n);
+  m_vecOwner.reserve(n);
+} //reserve
+
+/// Unregister every object and empty the arrays, keeping their capacity.
+
+void CAnimator::clear(){
+  for(CObject* pObj: m_vecOwner)
+    pObj->m_nAnim = UINT_MAX;
+
+  m_vecSprite.clear();
+  m_vecFrame.clear();
+  m_vecTime.clear();
+  m_vecOwner.clear();
+} //clear
+
+/// Register an object by appending an entry that plays its current sprite
+/// from its current frame, starting that frame now.
+/// \param pObj Pointer to the object.
+
+void CAnimator::Add(CObject* pObj){
+  pObj->m_nAnim = (UINT)m_vecOwner.size();
+
+  m_vecSprite.push_back(pObj->m_nSpriteIndex);
+  m_vecFrame.push_back(pObj->m_nCurrentFrame);
+  m_vecTime.push_back(0.0f);
+  m_vecOwner.push_back(pObj);
+} //Add
+
+/// Unregister an object by moving the last entry into its place.
+/// \param pObj Pointer to the object.
+
+void CAnimator::Remove(CObject* pObj){
+  const UINT i = pObj->m_nAnim;
+  if(i >= m_vecOwner.size())return; //not registered
+
+  const UINT last = (UINT)m_vecOwner.size() - 1;
+
+  if(i != last){
+    m_vecSprite[i] = m_vecSprite[last];
+    m_vecFrame[i] = m_vecFrame[last];
+    m_vecTime[i] = m_vecTime[last];
+    m_vecOwner[i] = m_vecOwner[last];
+    m_vecOwner[i]->m_nAnim = i;
+  } //if
+
+  m_vecSprite.pop_back();
+  m_vecFrame.pop_back();
+  m_vecTime.pop_back();
+  m_vecOwner.pop_back();
+
+  pObj->m_nAnim = UINT_MAX;
+} //Remove
+
+/// Start an entry playing a clip from a given frame, which starts now. The
+/// owner has already set its own sprite and frame to match.
+/// \param i Entry index.
+/// \param t Sprite index.
+/// \param f Frame number.
+
+void CAnimator::Play(UINT i, UINT t, UINT f){
+  m_vecSprite[i] = t;
+  m_vecFrame[i] = f;
+  m_vecTime[i] = 0.0f;
+} //Play
+
+/// Advance every entry by the frame time, moving it on by as many frames as
+/// the time allows, wrapping or stopping at the end of its clip. The loop
+/// touches only the animator's own arrays and the clip table, except that a
+/// frame that changes is written back to its owner. Single-frame clips, such
+/// as the standing sprites, cost a table lookup. Sleeping and dormant objects
+/// are advanced too, but they are standing still, and so showing a
+/// single-frame clip, or out of sight.
+/// \param dt Frame time in seconds.
+
+void CAnimator::Advance(float dt){
+  const size_t n = m_vecOwner.size();
+
+  for(size_t i=0; i<n; i++){
+    const CAnimClip& c = m_cClip[m_vecSprite[i]]; //shorthand
+    if(c.m_nFrames <= 1)continue;
+
+    float& time = m_vecTime[i]; //shorthand
+    time += dt;
+    if(time < c.m_fFrameTime)continue;
+
+    const UINT steps = (UINT)(time/c.m_fFrameTime);
+    time -= steps*c.m_fFrameTime;
+
+    UINT f = m_vecFrame[i] + steps;
+
+    if(f >= c.m_nFrames)
+      f = c.m_bLoop? f%c.m_nFrames: c.m_nFrames - 1;
+
+    if(f != m_vecFrame[i]){ //write back only if changed
+      m_vecFrame[i] = f;
+      m_vecOwner[i]->m_nCurrentFrame = f;
+    } //if
+  } //for
+} //Advance
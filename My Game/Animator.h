@@ -0,0 +1,62 @@
+/// \file Animator.h
+/// \brief Interface for the sprite animator CAnimator.
+
+#ifndef __L4RC_GAME_ANIMATOR_H__
+#define __L4RC_GAME_ANIMATOR_H__
+
+#include <vector>
+
+#include "Common.h"
+#include "GameDefines.h"
+
+class CObject;
+
+/// \brief Animation clip.
+///
+/// How the frames of a sprite are played.
+
+struct CAnimClip{
+  UINT m_nFrames = 1; ///< Number of frames.
+  float m_fFrameTime = ANIM_FRAME_TIME; ///< Seconds per frame.
+  bool m_bLoop = true; ///< Loop, or stop on the last frame.
+}; //CAnimClip
+
+/// \brief The animator.
+///
+/// The animator advances the animation frames of every registered object in
+/// a single pass over parallel arrays, one entry per object, instead of each
+/// object polling a timer of its own. Each sprite is played as a clip from a
+/// table built once after the sprites are loaded, so the pass never asks the
+/// renderer how many frames a sprite has. The animator owns the sprite and
+/// frame of each entry, so the pass reads nothing from the objects, and it
+/// only writes the frame number back to an object when the frame changes,
+/// which is a few times a second at most. An object changes clip through
+/// `CObject::SetAnimation()`, which tells the animator with `Play()`.
+/// Entries are removed by swapping the last entry into the hole, so indices
+/// change and each object's `m_nAnim` is kept up to date.
+
+class CAnimator: public CCommon{
+  private:
+    static CAnimClip m_cClip[(UINT)eSprite::Size]; ///< Clip for each sprite.
+
+    std::vector<UINT> m_vecSprite; ///< Sprite that each entry is playing.
+    std::vector<UINT> m_vecFrame; ///< Current frame of each entry.
+    std::vector<float> m_vecTime; ///< Time spent on the current frame.
+    std::vector<CObject*> m_vecOwner; ///< Object that each entry belongs to.
+
+  public:
+    void reserve(size_t); ///< Reserve space for entries.
+    void clear(); ///< Remove all entries.
+    const size_t size() const{return m_vecOwner.size();} ///< Number of entries.
+
+    void Add(CObject*); ///< Register an object.
+    void Remove(CObject*); ///< Unregister an object.
+    void Play(UINT, UINT, UINT); ///< Start a clip.
+
+    void Advance(float); ///< Advance all entries.
+
+    static void BuildClips(); ///< Build the clip table.
+    static const CAnimClip& GetClip(UINT); ///< Get the clip for a sprite.
+}; //CAnimator
+
+#endif //__L4RC_GAME_ANIMATOR_H__
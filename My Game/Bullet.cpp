@@ -15,6 +15,7 @@ CBullet::CBullet(eSprite t, const Vector2& p): CObject(t, p){
   m_bIsBullet = true;
   m_bStatic = false;
   m_bIsTarget = false;
+  m_eKind = eObjectKind::Bullet;
 } //constructor
 
 /// Response to collision, which for a bullet means playing a sound and a
@@ -12,13 +12,20 @@
 /// cloud of smoke when they collide with anything.
 
 class CBullet: public CObject{
+  friend class CCollisionTable;
+
   protected:
+    int m_nDamage = 1; ///< Damage done to whatever it hits.
+
     virtual void CollisionResponse(const Vector2&, float,
       CObject* = nullptr); ///< Collision response.
     virtual void DeathFX(); ///< Death special effects.
 
   public:
     CBullet(eSprite t, const Vector2& p); ///< Constructor.
+
+    void SetDamage(int n){m_nDamage = n;} ///< Set damage.
+    const int GetDamage() const{return m_nDamage;} ///< Get damage.
 }; //CBullet
 
 #endif //__L4RC_GAME_BULLET_H__
\ No newline at end of file
@@ -8,6 +8,7 @@ CBulletEnemy::CBulletEnemy(eSprite t, const Vector2& p) : CObject(t, p) {
 	m_bIsBullet = true;
 	m_bStatic = false;
 	m_bIsTarget = false;
+	m_eKind = eObjectKind::EnemyBullet;
 } 
 
 void CBulletEnemy::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
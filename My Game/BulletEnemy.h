@@ -5,6 +5,8 @@
 
 
 class CBulletEnemy : public CObject {
+	friend class CCollisionTable;
+
 protected:
 	virtual void CollisionResponse(const Vector2&, float d, CObject* = nullptr); 
 	virtual void DeathFX(); 
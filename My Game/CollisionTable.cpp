@@ -0,0 +1,244 @@
+/// \file CollisionTable.cpp
+/// \brief Code for the collision dispatch table CCollisionTable.
+
+#include "CollisionTable.h"
+#include "Object.h"
+#include "Player.h"
+#include "Zombie.h"
+#include "Turret.h"
+#include "StationaryTurret.h"
+#include "Bullet.h"
+#include "BulletEnemy.h"
+
+/// Determine whether objects of a given kind are projectiles, which die on
+/// contact and damage whatever they hit.
+/// \param k Object kind.
+/// \return true if objects of that kind are projectiles.
+
+static constexpr bool IsProjectile(eObjectKind k){
+  return k == eObjectKind::Bullet || k == eObjectKind::EnemyBullet;
+} //IsProjectile
+
+/// Determine whether objects of a given kind are scenery, which nothing
+/// collides with.
+/// \param k Object kind.
+/// \return true if objects of that kind are scenery.
+
+static constexpr bool IsScenery(eObjectKind k){
+  return k == eObjectKind::Furniture;
+} //IsScenery
+
+/// Determine whether a pair of object kinds is a contact, that is, whether
+/// objects of those kinds only ever push each other apart.
+/// \param a Kind of the first object.
+/// \param b Kind of the second object.
+/// \return true if neither kind is scenery or a projectile.
+
+static constexpr bool IsContactPair(eObjectKind a, eObjectKind b){
+  return !IsScenery(a) && !IsScenery(b) && !IsProjectile(a) && !IsProjectile(b);
+} //IsContactPair
+
+///////////////////////////////////////////////////////////////////////////////
+// Per-kind responses. The general versions are the default collision
+// response, and each kind that does something different specializes them.
+
+/// Response of an object to being hit by a projectile. By default it is
+/// pushed out by the overlap.
+/// \param p Pointer to the object.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param pProj Pointer to the projectile.
+/// \param n Damage done by the projectile.
+
+template<eObjectKind k> void CCollisionTable::Hit(CObject* p,
+  const Vector2& norm, float d, CObject* pProj, int n)
+{
+  p->CObject::CollisionResponse(norm, d, pProj);
+} //Hit
+
+/// The player may block the projectile with the shield, otherwise loses
+/// health.
+
+template<> void CCollisionTable::Hit<eObjectKind::Player>(CObject* p,
+  const Vector2& norm, float d, CObject* pProj, int)
+{
+  ((CPlayer*)p)->TakeHit(norm, d, pProj);
+} //Hit
+
+/// Zombies absorb the projectile and take its damage.
+
+template<> void CCollisionTable::Hit<eObjectKind::Zombie>(CObject* p,
+  const Vector2&, float, CObject* pProj, int n)
+{
+  if(p->m_bDead)return;
+  pProj->SetDead();
+  ((CZombie*)p)->TakeDamage(n);
+} //Hit
+
+/// Moving turrets absorb the projectile and take its damage.
+
+template<> void CCollisionTable::Hit<eObjectKind::Turret>(CObject* p,
+  const Vector2&, float, CObject* pProj, int n)
+{
+  if(p->m_bDead)return;
+  pProj->SetDead();
+  ((CTurret*)p)->TakeDamage(n);
+} //Hit
+
+/// Stationary turrets lose one point of health per hit.
+
+template<> void CCollisionTable::Hit<eObjectKind::StationaryTurret>(CObject* p,
+  const Vector2&, float, CObject*, int)
+{
+  ((CStationaryTurret*)p)->TakeHit();
+} //Hit
+
+/// A projectile's own response to hitting an object. Only the projectile
+/// kinds have one.
+/// \param p Pointer to the projectile.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param pOther Pointer to the object hit.
+
+template<> void CCollisionTable::Expire<eObjectKind::Bullet>(CObject* p,
+  const Vector2& norm, float d, CObject* pOther)
+{
+  ((CBullet*)p)->CBullet::CollisionResponse(norm, d, pOther);
+} //Expire
+
+/// Enemy bullets die the same way as the player's projectiles.
+
+template<> void CCollisionTable::Expire<eObjectKind::EnemyBullet>(CObject* p,
+  const Vector2& norm, float d, CObject* pOther)
+{
+  ((CBulletEnemy*)p)->CBulletEnemy::CollisionResponse(norm, d, pOther);
+} //Expire
+
+/// Damage done by a projectile. The player's projectiles carry the damage
+/// that their weapon does.
+/// \param p Pointer to the projectile.
+/// \return Damage.
+
+template<> int CCollisionTable::Damage<eObjectKind::Bullet>(CObject* p){
+  return ((CBullet*)p)->GetDamage();
+} //Damage
+
+/// Enemy bullets always do one point of damage.
+
+template<> int CCollisionTable::Damage<eObjectKind::EnemyBullet>(CObject*){
+  return 1;
+} //Damage
+
+///////////////////////////////////////////////////////////////////////////////
+// Pair handlers. Which of these a pair of kinds gets is decided at compile
+// time by whether each kind is a projectile. Pairs in which neither is a
+// projectile are contacts and don't get one.
+
+/// Collision handler for a pair of object kinds.
+/// \param p0 Pointer to an object of kind `a`.
+/// \param p1 Pointer to an object of kind `b`.
+/// \param norm Collision normal from `*p1` to `*p0`.
+/// \param d Overlap distance.
+
+template<eObjectKind a, eObjectKind b> void CCollisionTable::Collide(
+  CObject* p0, CObject* p1, const Vector2& norm, float d)
+{
+  Collide<a, b>(p0, p1, norm, d,
+    std::integral_constant<bool, IsProjectile(a)>(),
+    std::integral_constant<bool, IsProjectile(b)>());
+} //Collide
+
+/// The first object is a projectile that hit the second.
+
+template<eObjectKind a, eObjectKind b> void CCollisionTable::Collide(
+  CObject* p0, CObject* p1, const Vector2& norm, float d,
+  std::true_type, std::false_type)
+{
+  Hit<b>(p1, -norm, d, p0, Damage<a>(p0));
+  Expire<a>(p0, norm, d, p1);
+} //Collide
+
+/// The second object is a projectile that hit the first.
+
+template<eObjectKind a, eObjectKind b> void CCollisionTable::Collide(
+  CObject* p0, CObject* p1, const Vector2& norm, float d,
+  std::false_type, std::true_type)
+{
+  Hit<a>(p0, norm, d, p1, Damage<b>(p1));
+  Expire<b>(p1, -norm, d, p0);
+} //Collide
+
+/// Both objects are projectiles, and both die.
+
+template<eObjectKind a, eObjectKind b> void CCollisionTable::Collide(
+  CObject* p0, CObject* p1, const Vector2& norm, float d,
+  std::true_type, std::true_type)
+{
+  Expire<a>(p0,  norm, d, p1);
+  Expire<b>(p1, -norm, d, p0);
+} //Collide
+
+///////////////////////////////////////////////////////////////////////////////
+// The table.
+
+/// Table entry for a pair of object kinds.
+/// \return Handler, or `nullptr` if the kinds never collide or are a contact.
+
+template<eObjectKind a, eObjectKind b>
+  constexpr CollisionHandler CCollisionTable::Entry()
+{
+  return Entry<a, b>(std::integral_constant<bool,
+    IsScenery(a) || IsScenery(b) || IsContactPair(a, b)>());
+} //Entry
+
+/// Table entry for a pair of object kinds without a handler.
+/// \return `nullptr`.
+
+template<eObjectKind a, eObjectKind b>
+  constexpr CollisionHandler CCollisionTable::Entry(std::true_type)
+{
+  return nullptr;
+} //Entry
+
+/// Table entry for a pair of object kinds with a handler.
+/// \return Handler for the pair.
+
+template<eObjectKind a, eObjectKind b>
+  constexpr CollisionHandler CCollisionTable::Entry(std::false_type)
+{
+  return &Collide<a, b>;
+} //Entry
+
+/// Build the table with one entry for each ordered pair of object kinds.
+/// \return The table.
+
+template<size_t... i>
+  constexpr CCollisionTable::CTable CCollisionTable::MakeTable(std::index_sequence<i...>)
+{
+  return {
+    {Entry<(eObjectKind)(i/N), (eObjectKind)(i%N)>()...},
+    {IsContactPair((eObjectKind)(i/N), (eObjectKind)(i%N))...}
+  };
+} //MakeTable
+
+constexpr CCollisionTable::CTable CCollisionTable::m_cTable =
+  MakeTable(std::make_index_sequence<N*N>());
+
+/// Get the collision handler for a pair of object kinds.
+/// \param a Kind of the first object.
+/// \param b Kind of the second object.
+/// \return Handler, or `nullptr` if the kinds never collide or are a contact.
+
+const CollisionHandler CCollisionTable::Get(eObjectKind a, eObjectKind b){
+  return m_cTable.m_pHandler[(UINT)a*N + (UINT)b];
+} //Get
+
+/// Determine whether a pair of object kinds is a contact, which has no
+/// handler and goes to the position solver instead.
+/// \param a Kind of the first object.
+/// \param b Kind of the second object.
+/// \return true if the pair is a contact.
+
+const bool CCollisionTable::IsContact(eObjectKind a, eObjectKind b){
+  return m_cTable.m_bContact[(UINT)a*N + (UINT)b];
+} //IsContact
@@ -0,0 +1,64 @@
+/// \file CollisionTable.h
+/// \brief Interface for the collision dispatch table CCollisionTable.
+
+#ifndef __L4RC_GAME_COLLISIONTABLE_H__
+#define __L4RC_GAME_COLLISIONTABLE_H__
+
+#include <type_traits>
+#include <utility>
+
+#include "GameDefines.h"
+
+class CObject;
+
+/// \brief Collision handler.
+///
+/// A collision handler responds to a collision between two objects of known
+/// kinds, given the collision normal from the second object to the first
+/// and the overlap distance.
+
+typedef void (*CollisionHandler)(CObject*, CObject*, const Vector2&, float);
+
+/// \brief The collision dispatch table.
+///
+/// The collision dispatch table has a handler for each ordered pair of
+/// object kinds, generated at compile time from the templates in
+/// `CollisionTable.cpp`. Each handler makes direct, non-virtual calls to the
+/// responses of the two classes involved, so nothing in a response has to
+/// work out what it hit. Pairs in which neither object is a projectile are
+/// contacts, which just push each other apart. They have no handler and are
+/// left to the position solver. Pairs that never collide, such as anything
+/// with furniture, have neither a handler nor a contact.
+
+class CCollisionTable{
+  private:
+    static const UINT N = (UINT)eObjectKind::Size; ///< Number of kinds.
+
+    /// \brief The entries, indexed by first kind times `N` plus second kind.
+    struct CTable{
+      CollisionHandler m_pHandler[N*N]; ///< Handlers.
+      bool m_bContact[N*N]; ///< Whether each pair is a contact.
+    }; //CTable
+
+    static const CTable m_cTable; ///< Entry for each pair of kinds.
+
+    template<eObjectKind> static void Hit(CObject*, const Vector2&, float, CObject*, int); ///< Projectile hit response.
+    template<eObjectKind> static void Expire(CObject*, const Vector2&, float, CObject*); ///< Projectile's own response.
+    template<eObjectKind> static int Damage(CObject*); ///< Projectile damage.
+
+    template<eObjectKind a, eObjectKind b> static void Collide(CObject*, CObject*, const Vector2&, float); ///< Handler.
+    template<eObjectKind a, eObjectKind b> static void Collide(CObject*, CObject*, const Vector2&, float, std::true_type, std::false_type); ///< First is a projectile.
+    template<eObjectKind a, eObjectKind b> static void Collide(CObject*, CObject*, const Vector2&, float, std::false_type, std::true_type); ///< Second is a projectile.
+    template<eObjectKind a, eObjectKind b> static void Collide(CObject*, CObject*, const Vector2&, float, std::true_type, std::true_type); ///< Both are projectiles.
+
+    template<eObjectKind a, eObjectKind b> static constexpr CollisionHandler Entry(); ///< Table entry.
+    template<eObjectKind a, eObjectKind b> static constexpr CollisionHandler Entry(std::true_type); ///< Entry for a pair without a handler.
+    template<eObjectKind a, eObjectKind b> static constexpr CollisionHandler Entry(std::false_type); ///< Entry for a pair with a handler.
+    template<size_t... i> static constexpr CTable MakeTable(std::index_sequence<i...>); ///< Build table.
+
+  public:
+    static const CollisionHandler Get(eObjectKind, eObjectKind); ///< Get handler for a pair of kinds.
+    static const bool IsContact(eObjectKind, eObjectKind); ///< Is a pair of kinds a contact?
+}; //CCollisionTable
+
+#endif //__L4RC_GAME_COLLISIONTABLE_H__
@@ -10,10 +10,10 @@ LSpriteRenderer* CCommon::m_pRenderer = nullptr;
 CObjectManager* CCommon::m_pObjectManager = nullptr;
 LParticleEngine2D* CCommon::m_pParticleEngine = nullptr;
 CTileManager* CCommon::m_pTileManager = nullptr; 
+CHud* CCommon::m_pHud = nullptr;
 
 bool CCommon::m_bDrawAABBs = false;
 bool CCommon::m_bGodMode = false;
 bool CCommon::m_bPauseMode = false;
 
 Vector2 CCommon::m_vWorldSize = Vector2::Zero;
-CPlayer* CCommon::m_pPlayer = nullptr;
@@ -12,6 +12,7 @@ class CObjectManager;
 class LSpriteRenderer;
 class LParticleEngine2D;
 class CTileManager;
+class CHud;
 class CPlayer;
 
 /// \brief The common variables class.
@@ -28,13 +29,13 @@ class CCommon{
     static CObjectManager* m_pObjectManager; ///< Pointer to object manager.
     static LParticleEngine2D* m_pParticleEngine; ///< Pointer to particle engine.
     static CTileManager* m_pTileManager; ///< Pointer to tile manager. 
+    static CHud* m_pHud; ///< Pointer to heads-up display.
 
     static bool m_bDrawAABBs; ///< Draw AABB flag.
     static bool m_bGodMode; ///< God mode flag.
     static bool m_bPauseMode; ///< Pause mode flag
 
     static Vector2 m_vWorldSize; ///< World height and width.
-    static CPlayer* m_pPlayer; ///< Pointer to player character.
 }; //CCommon
 
 #endif //__L4RC_GAME_COMMON_H__
\ No newline at end of file
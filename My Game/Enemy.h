@@ -15,6 +15,7 @@ public:
 
 private:
     float m_fHealth = 0.0f; // health for the enemy
-    LEventTimer* m_pFrameEvent = nullptr;
     LEventTimer* m_pAttackCooldown = nullptr;
+
+    static UINT GetStandSprite(UINT t); // standing sprite facing the same way
 };
@@ -0,0 +1,187 @@
+/// \file FramePacer.cpp
+/// \brief Code for the frame pacer CFramePacer.
+
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif //WIN32_LEAN_AND_MEAN
+
+  #include <windows.h>
+#else
+  #include <ctime>
+#endif //_WIN32
+
+#include <thread>
+
+#include "FramePacer.h"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+  #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif //CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+
+static const double SAMPLE_TIME = 1.0; ///< Seconds in a utilization sample.
+static const auto SPIN_TIME = std::chrono::milliseconds(1); ///< Time spent yielding before an active deadline.
+
+/// Start the clocks. On Windows, make a high resolution waitable timer if
+/// there is one, since a plain sleep is only good to about 16 ms.
+
+CFramePacer::CFramePacer(){
+  m_tNext = m_tLast = CClock::now();
+  m_fLastCpuTime = GetCpuTime();
+
+  #ifdef _WIN32
+    m_hTimer = CreateWaitableTimerExW(nullptr, nullptr,
+      CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+  #endif //_WIN32
+} //constructor
+
+/// Close the waitable timer, if any.
+
+CFramePacer::~CFramePacer(){
+  #ifdef _WIN32
+    if(m_hTimer != nullptr)CloseHandle(m_hTimer);
+  #endif //_WIN32
+} //destructor
+
+/// Get the CPU time used by every thread of the process so far. The C
+/// library's `clock()` measures wall-clock time on Windows, so it won't do.
+/// \return CPU time in seconds.
+
+const double CFramePacer::GetCpuTime(){
+  #ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if(!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+      return 0.0;
+
+    auto seconds = [](const FILETIME& t){ //100 ns units to seconds
+      return (((unsigned long long)t.dwHighDateTime << 32) | t.dwLowDateTime)*1e-7;};
+
+    return seconds(kernel) + seconds(user);
+  #else
+    timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+  #endif //_WIN32
+} //GetCpuTime
+
+/// Set the most frames per second allowed in a pacing mode.
+/// \param mode Pacing mode.
+/// \param rate Frames per second, or 0 for no limit.
+
+void CFramePacer::SetRate(ePaceMode mode, float rate){
+  m_fRate[(unsigned)mode] = rate > 0.0f? rate: 0.0f;
+} //SetRate
+
+/// Reader function for the most frames per second allowed in a pacing mode.
+/// \param mode Pacing mode.
+/// \return Frames per second, or 0 for no limit.
+
+const float CFramePacer::GetRate(ePaceMode mode) const{
+  return m_fRate[(unsigned)mode];
+} //GetRate
+
+/// Sleep until a deadline, or at least until close to it. The waitable
+/// timer takes a due time in 100 ns units, negative for a relative one.
+/// \param t Deadline.
+
+void CFramePacer::SleepUntil(const CClock::time_point& t) const{
+  #ifdef _WIN32
+    if(m_hTimer != nullptr){
+      const long long n = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        t - CClock::now()).count()/100;
+      if(n <= 0)return;
+
+      LARGE_INTEGER due;
+      due.QuadPart = -n;
+
+      if(SetWaitableTimer(m_hTimer, &due, 0, nullptr, nullptr, FALSE))
+        WaitForSingleObject(m_hTimer, INFINITE);
+
+      return;
+    } //if
+  #endif //_WIN32
+
+  std::this_thread::sleep_until(t);
+} //SleepUntil
+
+/// End a frame by sleeping until the next one is due at the rate for a
+/// pacing mode, then charge the frame's wall-clock and CPU time to that mode.
+/// A change of mode, or a frame that ends after the next one was due, starts
+/// the deadlines over from now.
+/// \param mode Pacing mode for this frame.
+/// \return true if this frame completed a utilization sample for the mode.
+
+const bool CFramePacer::Wait(ePaceMode mode){
+  const float rate = m_fRate[(unsigned)mode];
+  CClock::time_point now = CClock::now();
+
+  if(rate > 0.0f){
+    const auto period = std::chrono::duration_cast<CClock::duration>(
+      std::chrono::duration<double>(1.0/rate));
+
+    if(mode != m_eMode || m_tNext + period < now)
+      m_tNext = now; //start over
+
+    m_tNext += period;
+
+    if(mode == ePaceMode::Active){
+      SleepUntil(m_tNext - SPIN_TIME);
+      while(CClock::now() < m_tNext)std::this_thread::yield();
+    } //if
+
+    else SleepUntil(m_tNext);
+
+    now = CClock::now();
+  } //if
+
+  m_eMode = mode;
+
+  //charge this frame to the mode
+
+  const double cpu = GetCpuTime();
+  const double wall = std::chrono::duration<double>(now - m_tLast).count();
+  CUsage& u = m_cUsage[(unsigned)mode]; //shorthand
+
+  u.m_fWallTime += wall;
+  u.m_fCpuTime += cpu - m_fLastCpuTime;
+  u.m_fSampleWallTime += wall;
+  u.m_fSampleCpuTime += cpu - m_fLastCpuTime;
+  u.m_nFrames++;
+
+  m_tLast = now;
+  m_fLastCpuTime = cpu;
+
+  if(u.m_fSampleWallTime < SAMPLE_TIME)
+    return false;
+
+  u.m_fUtilization = (float)(u.m_fSampleCpuTime/u.m_fSampleWallTime);
+  u.m_fSampleWallTime = u.m_fSampleCpuTime = 0.0;
+  return true;
+} //Wait
+
+/// Reader function for the CPU utilization in the last complete sample in a
+/// pacing mode. It can be more than 1 if more than one thread was busy.
+/// \param mode Pacing mode.
+/// \return CPU time over wall-clock time, or 0 if no sample is complete.
+
+const float CFramePacer::GetUtilization(ePaceMode mode) const{
+  return m_cUsage[(unsigned)mode].m_fUtilization;
+} //GetUtilization
+
+/// Reader function for the CPU utilization over all of the time spent in a
+/// pacing mode.
+/// \param mode Pacing mode.
+/// \return CPU time over wall-clock time, or 0 if no time was spent in it.
+
+const float CFramePacer::GetTotalUtilization(ePaceMode mode) const{
+  const CUsage& u = m_cUsage[(unsigned)mode]; //shorthand
+  return u.m_fWallTime > 0.0? (float)(u.m_fCpuTime/u.m_fWallTime): 0.0f;
+} //GetTotalUtilization
+
+/// Reader function for the number of frames paced in a pacing mode.
+/// \param mode Pacing mode.
+/// \return Number of frames.
+
+const size_t CFramePacer::GetNumFrames(ePaceMode mode) const{
+  return m_cUsage[(unsigned)mode].m_nFrames;
+} //GetNumFrames
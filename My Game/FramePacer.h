@@ -0,0 +1,79 @@
+/// \file FramePacer.h
+/// \brief Interface for the frame pacer CFramePacer.
+
+#ifndef __L4RC_GAME_FRAMEPACER_H__
+#define __L4RC_GAME_FRAMEPACER_H__
+
+#include <chrono>
+
+/// \brief Pacing mode enumerated type.
+///
+/// What the game is doing, which decides how fast frames may come.
+
+enum class ePaceMode: unsigned{
+  Active, Background, Idle,
+  Size  //MUST BE LAST
+}; //ePaceMode
+
+/// \brief The frame pacer.
+///
+/// The frame pacer ends each frame by sleeping until the next one is due at
+/// the most frames per second allowed in the current pacing mode, or not at
+/// all if that mode has no limit, so a paused game polls its input a few
+/// times a second instead of spinning a core. Deadlines are kept on a fixed
+/// grid so that the rate doesn't drift, but a frame that runs late starts a
+/// new grid rather than letting the next frames catch up. While active, the
+/// last millisecond before a deadline is spent yielding, since a sleep can
+/// overshoot by that much and an active frame rate cap should be accurate.
+///
+/// The frame pacer also measures CPU utilization, the process CPU time, all
+/// threads included, over the wall-clock time, separately for each pacing
+/// mode. Each frame's time, from one `Wait()` to the next, counts towards the
+/// mode that it was paced in. Utilization is reported both for the last
+/// complete one-second sample in a mode and for all of the time in it.
+
+class CFramePacer{
+  private:
+    typedef std::chrono::steady_clock CClock; ///< Clock for frame deadlines.
+
+    /// \brief Usage.
+    ///
+    /// Time spent in a pacing mode.
+
+    struct CUsage{
+      double m_fWallTime = 0.0; ///< Wall-clock seconds in total.
+      double m_fCpuTime = 0.0; ///< CPU seconds in total.
+      double m_fSampleWallTime = 0.0; ///< Wall-clock seconds in the current sample.
+      double m_fSampleCpuTime = 0.0; ///< CPU seconds in the current sample.
+      float m_fUtilization = 0.0f; ///< Utilization in the last complete sample.
+      size_t m_nFrames = 0; ///< Number of frames in total.
+    }; //CUsage
+
+    float m_fRate[(unsigned)ePaceMode::Size] = {0}; ///< Most frames per second in each mode, 0 for no limit.
+    CUsage m_cUsage[(unsigned)ePaceMode::Size]; ///< Time spent in each mode.
+
+    ePaceMode m_eMode = ePaceMode::Active; ///< Mode of the last frame.
+    CClock::time_point m_tNext; ///< Deadline for the next frame.
+    CClock::time_point m_tLast; ///< Wall-clock time at the end of the last frame.
+    double m_fLastCpuTime = 0.0; ///< CPU time at the end of the last frame.
+
+    void* m_hTimer = nullptr; ///< High resolution waitable timer, Windows only.
+
+    void SleepUntil(const CClock::time_point&) const; ///< Sleep until a deadline.
+    static const double GetCpuTime(); ///< Process CPU time.
+
+  public:
+    CFramePacer(); ///< Constructor.
+    ~CFramePacer(); ///< Destructor.
+
+    void SetRate(ePaceMode, float); ///< Set most frames per second.
+    const float GetRate(ePaceMode) const; ///< Get most frames per second.
+
+    const bool Wait(ePaceMode); ///< End a frame.
+
+    const float GetUtilization(ePaceMode) const; ///< Utilization in the last sample.
+    const float GetTotalUtilization(ePaceMode) const; ///< Utilization in total.
+    const size_t GetNumFrames(ePaceMode) const; ///< Number of frames in total.
+}; //CFramePacer
+
+#endif //__L4RC_GAME_FRAMEPACER_H__
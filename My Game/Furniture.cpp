@@ -14,6 +14,7 @@
 CFurniture::CFurniture(const Vector2& p):CObject(eSprite::Furniture,p)
 {
 	isFurniture = true;
+	m_eKind = eObjectKind::Furniture;
 	m_bStatic = true;
 	m_nCurrentFrame = 19;
 }
\ No newline at end of file
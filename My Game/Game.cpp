@@ -10,28 +10,36 @@
 #include "TileManager.h"
 #include "Zombie.h"
 #include "Turret.h"
-#include "HealthBar.h"
+#include "Hud.h"
+#include "Animator.h"
 #include "Enemy.h"
 #include "ObjectManager.h"
+#include "Log.h"
 
 #include "shellapi.h"
 
-/// Delete the renderer, the object manager, and the tile manager. The renderer
-/// needs to be deleted before this destructor runs so it will be done elsewhere.
+/// Delete the renderer, the object manager, the tile manager, and the
+/// heads-up display. The renderer needs to be deleted before this destructor
+/// runs so it will be done elsewhere.
 
 CGame::~CGame(){
   delete m_pParticleEngine;
   delete m_pObjectManager;
   delete m_pTileManager;
+  delete m_pHud;
 } //destructor
 
-/// Initialize the renderer, the tile manager and the object manager, load 
-/// images and sounds, and begin the game.
+/// Start the logger, initialize the renderer, load images and build their
+/// animation clips, set up the heads-up display, the tile manager and the
+/// object manager, load sounds, set the frame rates, and begin the game.
 
 void CGame::Initialize(){
+  CLog::Start(); //start logging thread
   m_pRenderer = new LSpriteRenderer(eSpriteMode::Batched2D); 
   m_pRenderer->Initialize(eSprite::Size); 
   LoadImages(); //load images from xml file list
+  CAnimator::BuildClips(); //animation clips for the sprites just loaded
+  m_pHud = new CHud; //set up the heads-up display
   
   m_pTileManager = new CTileManager((size_t)m_pRenderer->GetWidth(eSprite::Tile));
   m_pObjectManager = new CObjectManager; //set up the object manager 
@@ -39,6 +47,10 @@ void CGame::Initialize(){
 
   m_pParticleEngine = new LParticleEngine2D(m_pRenderer);
 
+  m_cFramePacer.SetRate(ePaceMode::Background, BACKGROUND_FRAME_RATE);
+  m_cFramePacer.SetRate(ePaceMode::Idle, IDLE_FRAME_RATE);
+  SetFrameRateCap(m_bFrameRateCap);
+
   BeginGame();
 } //Initialize
 
@@ -48,6 +60,10 @@ void CGame::Initialize(){
 /// image file. If the image tag or the image file are missing, then the game
 /// should abort from deeper in the Engine code leaving you with an error
 /// message in a dialog box.
+///
+/// The renderer decodes and uploads each sprite's image inside `Load()`, one
+/// after the other. Map images are decoded by the game instead, through the
+/// image decoder, when `BeginGame()` loads a level that uses one.
 
 void CGame::LoadImages(){  
   m_pRenderer->BeginResourceUpload();
@@ -60,6 +76,7 @@ void CGame::LoadImages(){
   m_pRenderer->Load(eSprite::Turret,  "turret");
   m_pRenderer->Load(eSprite::stationaryturret, "stationaryturret");
   m_pRenderer->Load(eSprite::Line,    "greenline");
+  m_pRenderer->Load(eSprite::Pixel,   "pixel");
   m_pRenderer->Load(eSprite::Furniture, "furniture");
   m_pRenderer->Load(eSprite::Fireball, "fireball");
   m_pRenderer->Load(eSprite::sword, "sword");
@@ -89,7 +106,6 @@ void CGame::LoadImages(){
   m_pRenderer->Load(eSprite::PlayerAttackDownSpriteSheet, "attackdownsheet");
   m_pRenderer->Load(eSprite::PlayerAttackDown, "attackdown");
 
-  m_pRenderer->Load(eSprite::HealthBar, "healthbar");
   m_pRenderer->Load(eSprite::HealthBar, "healthbar");
 
   m_pRenderer->Load(eSprite::ZombieStandLeft, "zombiestandleft");
@@ -104,6 +120,18 @@ void CGame::LoadImages(){
   m_pRenderer->Load(eSprite::ZombieWalkUp, "zombiewalkup");
   m_pRenderer->Load(eSprite::ZombieWalkDownSpriteSheet, "zombiewalkdownsheet");
   m_pRenderer->Load(eSprite::ZombieWalkDown, "zombiewalkdown");
+  m_pRenderer->Load(eSprite::SkeletonStandLeft, "skeletonstandleft");
+  m_pRenderer->Load(eSprite::SkeletonStandRight, "skeletonstandright");
+  m_pRenderer->Load(eSprite::SkeletonStandUp, "skeletonstandup");
+  m_pRenderer->Load(eSprite::SkeletonStandDown, "skeletonstanddown");
+  m_pRenderer->Load(eSprite::SkeletonWalkLeftSpriteSheet, "skeletonwalkleftsheet");
+  m_pRenderer->Load(eSprite::SkeletonWalkLeft, "skeletonwalkleft");
+  m_pRenderer->Load(eSprite::SkeletonWalkRightSpriteSheet, "skeletonwalkrightsheet");
+  m_pRenderer->Load(eSprite::SkeletonWalkRight, "skeletonwalkright");
+  m_pRenderer->Load(eSprite::SkeletonWalkUpSpriteSheet, "skeletonwalkupsheet");
+  m_pRenderer->Load(eSprite::SkeletonWalkUp, "skeletonwalkup");
+  m_pRenderer->Load(eSprite::SkeletonWalkDownSpriteSheet, "skeletonwalkdownsheet");
+  m_pRenderer->Load(eSprite::SkeletonWalkDown, "skeletonwalkdown");
 
   m_pRenderer->EndResourceUpload();
 } //LoadImages
@@ -121,75 +149,32 @@ void CGame::LoadSounds(){
   m_pAudio->Load(eSound::Boom, "boom");
 } //LoadSounds
 
-/// Release all of the DirectX12 objects by deleting the renderer.
+/// Release all of the DirectX12 objects by deleting the renderer, then stop
+/// the logger.
 
 void CGame::Release(){
   delete m_pRenderer;
   m_pRenderer = nullptr; //for safety
+  CLog::Stop(); //write out remaining log records
 } //Release
 
-/// Ask the object manager to create a player object and Turrets specified by
-/// the tile manager.
-
-
+/// Ask the object manager to create the player and the objects in the tile
+/// manager's spawn tables. Each table is handed over whole, so that the
+/// object manager can reserve storage once per table.
 
 void CGame::CreateObjects() {
-
-   
-   
-
-    
-    std::vector<Vector2> zombiepos = m_pTileManager->m_vecZombies;
-
-    const std::vector<Vector2>& movingTurretPos = m_pTileManager->GetTurrets();
-    const std::vector<Vector2>& stationaryTurretPos = m_pTileManager->GetStationaryTurrets();
-
-	const std::vector<CTileManager::furniture>& furniturepos = m_pTileManager->GetFurniture();
 	const Vector2& playerpos = m_pTileManager->GetPlayerPos();
 
+    m_pObjectManager->SpawnTurrets(m_pTileManager->GetTurrets());
+    m_pObjectManager->SpawnStationaryTurrets(m_pTileManager->GetStationaryTurrets());
+    m_pObjectManager->SpawnZombies(m_pTileManager->GetZombies());
+    m_pObjectManager->SpawnFurniture(m_pTileManager->GetFurniture());
 
-    //const std::vector<CTileManager::furniture>& furniturepos = m_pTileManager->GetFurniture();
-    
-
+    CPlayer* pPlayer = (CPlayer*)m_pObjectManager->create(eSprite::PlayerStandDown, playerpos);
 
-    for (const Vector2& pos : movingTurretPos) {
-        CTurret* pTurret = (CTurret*)m_pObjectManager->create(eSprite::Turret, pos);
-
-        std::vector<Vector2> patrolPath = {
-            pos,
-            pos + Vector2(100.0f, 0.0f)
-        };
-        pTurret->InitializePatrol(patrolPath);
-    }
 
-    for (const Vector2& pos : stationaryTurretPos) {
-        m_pObjectManager->create(eSprite::stationaryturret, pos);
-    }
-
-    for (const Vector2& pos : zombiepos) {
-        CZombie* pZombie = (CZombie*)m_pObjectManager->create(eSprite::ZombieStandDown, pos);
-        
-
-
-        std::vector<Vector2> patrolPath = {
-            pos,
-            pos + Vector2(100.0f, 0.0f)
-        };
-        pZombie->InitializePatrol(patrolPath);
-    }
-
-
-
-    for (CTileManager::furniture furn : furniturepos) {
-        Vector2 pos = furn.location;
-        m_pObjectManager->createFurniture(eSprite::Furniture, pos, furn.type);
-    }
-
-    m_pPlayer = (CPlayer*)m_pObjectManager->create(eSprite::PlayerStandDown, playerpos);
-
-
-    if (m_pPlayer) {
-        m_pPlayer->Stop();
+    if (pPlayer) {
+        pPlayer->Stop();
     }
 } //createObjects
 
@@ -209,6 +194,11 @@ void CGame::BeginGame(){
   m_pAudio->stop(); //stop all  currently playing sounds
   m_pAudio->play(eSound::Start); //play start-of-game sound
   m_eGameState = eGameState::Playing; //now playing
+  m_bDirty = true; //redraw if paused
+
+  LOG(Info, Level, "begin", "level", m_nNextLevel,
+    "zombies", m_pObjectManager->GetNumZombies(),
+    "turrets", m_pObjectManager->GetNumTurrets());
 } //BeginGame
 
 /// Poll the keyboard state and respond to the key presses that happened since
@@ -225,11 +215,15 @@ void CGame::KeyboardHandler(){
   if(m_pKeyboard->TriggerDown(VK_F1)) //help
     ShellExecute(0, 0, "https://larc.unt.edu/code/topdown/", 0, 0, SW_SHOW);
   
-  if(m_pKeyboard->TriggerDown(VK_F2)) //toggle frame rate
+  if(m_pKeyboard->TriggerDown(VK_F2)){ //toggle frame rate
     m_bDrawFrameRate = !m_bDrawFrameRate;
+    m_bDirty = true;
+  } //if
   
-  if(m_pKeyboard->TriggerDown(VK_F3)) //toggle AABB drawing
+  if(m_pKeyboard->TriggerDown(VK_F3)){ //toggle AABB drawing
     m_bDrawAABBs = !m_bDrawAABBs; 
+    m_bDirty = true;
+  } //if
 
   if (m_pKeyboard->TriggerDown(VK_F4)) // move to next level
   {
@@ -237,6 +231,28 @@ void CGame::KeyboardHandler(){
       BeginGame();
   }
 
+  if(m_pKeyboard->TriggerDown(VK_F6)) //object size report to debug console
+    CObjectManager::PrintSizeReport();
+
+  if(m_pKeyboard->TriggerDown(VK_F7)) //fewer position solver iterations
+    m_pObjectManager->SetSolverIterations(m_pObjectManager->GetSolverIterations() - 1);
+
+  if(m_pKeyboard->TriggerDown(VK_F8)) //more position solver iterations
+    m_pObjectManager->SetSolverIterations(m_pObjectManager->GetSolverIterations() + 1);
+
+  if(m_pKeyboard->TriggerDown(VK_F9)) //toggle frame rate cap
+    SetFrameRateCap(!m_bFrameRateCap);
+
+  if(m_pKeyboard->TriggerDown(VK_F11)){ //crowd separation check to log
+    m_pObjectManager->CrowdCheck(2, 60);
+    m_pObjectManager->CrowdCheck(16, 60);
+  } //if
+
+  if(m_pKeyboard->TriggerDown('M')){ //toggle minimap
+    m_pHud->ToggleMinimap();
+    m_bDirty = true;
+  } //if
+
 
 
   if(m_pKeyboard->TriggerDown(VK_BACK)) //start game
@@ -246,10 +262,18 @@ void CGame::KeyboardHandler(){
       m_eGameState = (m_eGameState == eGameState::Paused) ?
           eGameState::Playing :
           eGameState::Paused;
+      m_bDirty = true; //show or hide the paused text
+
+      LOG(Info, General, "cpu", "paused", m_eGameState == eGameState::Paused,
+        "playing", m_cFramePacer.GetTotalUtilization(ePaceMode::Active),
+        "background", m_cFramePacer.GetTotalUtilization(ePaceMode::Background),
+        "idle", m_cFramePacer.GetTotalUtilization(ePaceMode::Idle));
   }
 
-  if (m_eGameState != eGameState::Paused && m_pPlayer) {
-      m_pPlayer->SetRotSpeed(0.0f);
+  CPlayer* pPlayer = m_pObjectManager->GetPlayer();
+
+  if (m_eGameState != eGameState::Paused && pPlayer) {
+      pPlayer->SetRotSpeed(0.0f);
 
       float fTargetSpeed = 0.0f;
 
@@ -258,95 +282,96 @@ void CGame::KeyboardHandler(){
 
      
 
-      m_pPlayer->SetSpeed(0.0f);
+      pPlayer->SetSpeed(0.0f);
 
       // Vertical Movement
       if (m_pKeyboard->Down('W') && !m_pKeyboard->Down('S')) {
           fTargetSpeed = PLAYER_NORMAL_SPEED; 
-          m_pPlayer->WalkUp();
+          pPlayer->WalkUp();
       }
       else if (m_pKeyboard->Down('S') && !m_pKeyboard->Down('W')) {
           fTargetSpeed = -PLAYER_NORMAL_SPEED;
-          m_pPlayer->StrafeBack();
-          m_pPlayer->WalkDown();
+          pPlayer->StrafeBack();
+          pPlayer->WalkDown();
       }
 
       // Horizontal Movement 
       else if (!bMovementKeyHeld || m_pKeyboard->Down('A') || m_pKeyboard->Down('D')) {
           if (m_pKeyboard->Down('D') && !m_pKeyboard->Down('A')) {
               fTargetSpeed = PLAYER_NORMAL_SPEED;
-              m_pPlayer->StrafeRight();
-              m_pPlayer->WalkRight();
+              pPlayer->StrafeRight();
+              pPlayer->WalkRight();
           }
           else if (m_pKeyboard->Down('A') && !m_pKeyboard->Down('D')) {
               fTargetSpeed = -PLAYER_NORMAL_SPEED;
-              m_pPlayer->StrafeLeft();
-              m_pPlayer->WalkLeft();
+              pPlayer->StrafeLeft();
+              pPlayer->WalkLeft();
           }
       }
       if (!bMovementKeyHeld) {
-          m_pPlayer->Stop();
+          pPlayer->Stop();
       }
 
       // Weapons
 
       // Arrow
       if (m_pKeyboard->TriggerDown(VK_SPACE)) {
-          if (m_pPlayer->m_pBulletCooldown->Triggered()) {
-              Vector2 vDir = m_pPlayer->GetDirectionVector();
-              m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet, vDir);
+          if (pPlayer->m_pBulletCooldown->Triggered()) {
+              Vector2 vDir = pPlayer->GetDirectionVector();
+              m_pObjectManager->FireGun(pPlayer, eSprite::Bullet, vDir);
           }
       }
 
       // Fireball
       if (m_pKeyboard->TriggerDown('Q')) {
-          if (m_pPlayer->m_pFireballCooldown->Triggered()) {
-              Vector2 vDir = m_pPlayer->GetDirectionVector();
-              m_pObjectManager->FireGun(m_pPlayer, eSprite::Fireball, vDir);
+          if (pPlayer->m_pFireballCooldown->Triggered()) {
+              Vector2 vDir = pPlayer->GetDirectionVector();
+              m_pObjectManager->FireGun(pPlayer, eSprite::Fireball, vDir);
           }
       }
 
       // Regular Sword
       if (m_pKeyboard->TriggerDown('E')) {
-          if (m_pPlayer->m_pSwordCooldown->Triggered()) {
-              Vector2 vDir = m_pPlayer->GetDirectionVector();
-              m_pObjectManager->FireGun(m_pPlayer, eSprite::sword, vDir);
+          if (pPlayer->m_pSwordCooldown->Triggered()) {
+              Vector2 vDir = pPlayer->GetDirectionVector();
+              m_pObjectManager->FireGun(pPlayer, eSprite::sword, vDir);
           }
       }
 
       // Great Sword
       if (m_pKeyboard->TriggerDown('R')) {
-          if (m_pPlayer->m_pGreatswordCooldown->Triggered()) {
-              Vector2 vDir = m_pPlayer->GetDirectionVector();
-              m_pObjectManager->FireGun(m_pPlayer, eSprite::greatsword, vDir);
+          if (pPlayer->m_pGreatswordCooldown->Triggered()) {
+              Vector2 vDir = pPlayer->GetDirectionVector();
+              m_pObjectManager->FireGun(pPlayer, eSprite::greatsword, vDir);
           }
       }
 
       // Dagger
       if (m_pKeyboard->TriggerDown('T')) {
-          if (m_pPlayer->m_pDaggerCooldown->Triggered()) {
-              Vector2 vDir = m_pPlayer->GetDirectionVector();
-              m_pObjectManager->FireGun(m_pPlayer, eSprite::dagger, vDir);
+          if (pPlayer->m_pDaggerCooldown->Triggered()) {
+              Vector2 vDir = pPlayer->GetDirectionVector();
+              m_pObjectManager->FireGun(pPlayer, eSprite::dagger, vDir);
           }
       }
 
       // Trigger attack animation with 
       if (m_pKeyboard->TriggerDown('J')) {
-        m_pPlayer->TriggerAttack();  
+        pPlayer->TriggerAttack();  
 }
 
 
 
       // Shield
       if (m_pKeyboard->Down(VK_LSHIFT)) {
-          if (!m_pPlayer->m_bShieldActive) {
-              m_pPlayer->m_bShieldActive = true;
-
-              Vector2 playerDir = m_pPlayer->GetDirectionVector();
-              Vector2 shieldPos = m_pPlayer->m_vPos + playerDir * SHIELD_OFFSET;
-              m_pPlayer->m_pShieldObject = m_pObjectManager->create(eSprite::shield, shieldPos);
-              m_pPlayer->m_pShieldObject->SetStatic(true);
-              m_pPlayer->m_pShieldObject->m_fRoll = m_pPlayer->m_fRoll;
+          if (!pPlayer->m_bShieldActive) {
+              pPlayer->m_bShieldActive = true;
+
+              Vector2 playerDir = pPlayer->GetDirectionVector();
+              Vector2 shieldPos = pPlayer->m_vPos + playerDir * SHIELD_OFFSET;
+              CObject* pShield = m_pObjectManager->create(eSprite::shield, shieldPos);
+              pShield->SetStatic(true);
+              pShield->m_fRoll = pPlayer->m_fRoll;
+              pPlayer->m_hShield = pShield->GetHandle();
           }
 
           if (bMovementKeyHeld) {
@@ -360,17 +385,17 @@ void CGame::KeyboardHandler(){
           }
       }
       else {
-          if (m_pPlayer->m_bShieldActive) {
-              m_pPlayer->m_bShieldActive = false;
+          if (pPlayer->m_bShieldActive) {
+              pPlayer->m_bShieldActive = false;
 
-              if (m_pPlayer->m_pShieldObject) {
-                  m_pPlayer->m_pShieldObject->SetDead();
-                  m_pPlayer->m_pShieldObject = nullptr;
-              }
+              if (CObject* pShield = m_pObjectManager->Get(pPlayer->m_hShield))
+                  pShield->SetDead();
+
+              pPlayer->m_hShield.Reset();
           }
       }
 
-      m_pPlayer->SetSpeed(fTargetSpeed);
+      pPlayer->SetSpeed(fTargetSpeed);
 
 
 
@@ -386,34 +411,91 @@ void CGame::ControllerHandler(){
 
   m_pController->GetState(); //get state of controller's controls 
   
-  if(m_pPlayer){ //safety
-    m_pPlayer->SetSpeed(100*m_pController->GetRTrigger());
-    m_pPlayer->SetRotSpeed(-2.0f*m_pController->GetRThumb().x);
+  CPlayer* pPlayer = m_pObjectManager->GetPlayer();
+
+  if(pPlayer){ //safety
+    pPlayer->SetSpeed(100*m_pController->GetRTrigger());
+    pPlayer->SetRotSpeed(-2.0f*m_pController->GetRThumb().x);
 
     //if(m_pController->GetButtonRSToggle()) //fire gun
-     //   m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet, vDir); // Pass vDir
+     //   m_pObjectManager->FireGun(pPlayer, eSprite::Bullet, vDir); // Pass vDir
 
     if(m_pController->GetDPadRight()) //strafe right
-      m_pPlayer->StrafeRight();
+      pPlayer->StrafeRight();
   
     if(m_pController->GetDPadLeft()) //strafe left
-      m_pPlayer->StrafeLeft();
+      pPlayer->StrafeLeft();
 
     if(m_pController->GetDPadDown()) //strafe back
-      m_pPlayer->StrafeBack();
+      pPlayer->StrafeBack();
   } //if
 } //ControllerHandler
 
-/// Draw the current frame rate to a hard-coded position in the window.
-/// The frame rate will be drawn in a hard-coded position using the font
+/// Draw the current frame rate to a hard-coded position in the window,
+/// and under the object counts, the CPU utilization while playing and
+/// while paused over the last second spent in each, and the frame rate cap.
+/// The text will be drawn in a hard-coded position using the font
 /// specified in `gamesettings.xml`.
 
 void CGame::DrawFrameRateText(){
   const std::string s = std::to_string(m_pTimer->GetFPS()) + " fps"; //frame rate
   const Vector2 pos(m_nWinWidth - 128.0f, 30.0f); //hard-coded position
   m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
+
+  const std::string s2 = std::to_string(m_nAllocsPerSecond) + " allocs/s"; //allocation rate
+  const Vector2 pos2(m_nWinWidth - 160.0f, 60.0f); //hard-coded position
+  m_pRenderer->DrawScreenText(s2.c_str(), pos2); //draw to screen
+
+  const float cap = m_cFramePacer.GetRate(ePaceMode::Active); //frame rate cap
+  const std::string s3 = "cpu " +
+    std::to_string((int)round(100*m_cFramePacer.GetUtilization(ePaceMode::Active))) + "% playing, " +
+    std::to_string((int)round(100*m_cFramePacer.GetUtilization(ePaceMode::Idle))) + "% paused, " +
+    (cap > 0.0f? "capped at " + std::to_string((int)cap) + " fps": std::string("uncapped"));
+  const Vector2 pos3(m_nWinWidth - 760.0f, 150.0f); //hard-coded position
+  m_pRenderer->DrawScreenText(s3.c_str(), pos3); //draw to screen
 } //DrawFrameRateText
 
+/// Draw the live object counts kept by the object manager to a hard-coded
+/// position in the window below the frame rate, and under them the number
+/// of sprites drawn and texture switches in the last frame.
+
+void CGame::DrawObjectCountText(){
+  const std::string s = 
+    std::to_string(m_pObjectManager->GetNumZombies()) + " zombies, " +
+    std::to_string(m_pObjectManager->GetNumTurrets()) + " turrets, " +
+    std::to_string(m_pObjectManager->GetNumBullets()) + " bullets, " +
+    std::to_string(m_pObjectManager->GetNumAsleep()) + " asleep, " +
+    std::to_string(m_pObjectManager->GetNumDormant()) + " dormant, solver " +
+    std::to_string(m_pObjectManager->GetSolverLastIterations()) + "/" +
+    std::to_string(m_pObjectManager->GetSolverIterations());
+  const Vector2 pos(m_nWinWidth - 760.0f, 90.0f); //hard-coded position
+  m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
+
+  const CRenderQueue& q = m_pObjectManager->GetRenderQueue(); //last frame drawn
+  const std::string s2 = 
+    std::to_string(q.size()) + " draws, " +
+    std::to_string(q.GetNumTextureSwitches()) + " texture switches";
+  const Vector2 pos2(m_nWinWidth - 760.0f, 120.0f); //hard-coded position
+  m_pRenderer->DrawScreenText(s2.c_str(), pos2); //draw to screen
+} //DrawObjectCountText
+
+/// Once a second, sample the number of game objects that the object manager
+/// has allocated and work out how many were allocated per second since the
+/// previous sample. With the projectile pools warm this should stay at zero
+/// even under heavy stationary turret fire.
+
+void CGame::UpdateAllocationRate(){
+  const float t = m_pTimer->GetTime(); //current time
+  const float dt = t - m_fAllocSampleTime; //time since last sample
+
+  if(dt >= 1.0f){
+    const size_t n = m_pObjectManager->GetNumAllocations();
+    m_nAllocsPerSecond = (size_t)((n - m_nAllocSampleCount)/dt);
+    m_nAllocSampleCount = n;
+    m_fAllocSampleTime = t;
+  } //if
+} //UpdateAllocationRate
+
 /// Draw the god mode text to a hard-coded position in the window using the
 /// font specified in `gamesettings.xml`.
 
@@ -427,7 +509,8 @@ void CGame::DrawGodModeText(){
   m_pRenderer->DrawScreenText("God Mode", pos); //draw to screen
 } //DrawGodModeText
 
-/// Ask the object manager to draw the game objects. The renderer is notified of
+/// Ask the object manager to draw the game objects, then draw the particles
+/// and the heads-up display over them. The renderer is notified of
 /// the start and end of the frame so that it can let Direct3D do its
 /// pipelining jiggery-pokery.
 
@@ -436,7 +519,9 @@ void CGame::RenderFrame(){
 
   m_pObjectManager->draw(); //draw objects
   m_pParticleEngine->Draw(); //draw particles
+  m_pHud->Draw(); //draw heads-up display
   if(m_bDrawFrameRate)DrawFrameRateText(); //draw frame rate, if required
+  if(m_bDrawFrameRate)DrawObjectCountText(); //draw object counts, if required
   if(m_bGodMode)DrawGodModeText(); //draw god mode text, if required
   if (m_eGameState == eGameState::Paused) //draw paused text
       DrawPausedText();
@@ -449,9 +534,10 @@ void CGame::RenderFrame(){
 /// center everything.
 
 void CGame::FollowCamera(){
-  if(m_pPlayer == nullptr)return; //safety
+  CPlayer* pPlayer = m_pObjectManager->GetPlayer();
+  if(pPlayer == nullptr)return; //safety
 
-  Vector3 vCameraPos(m_pPlayer->GetPos()); //player position
+  Vector3 vCameraPos(pPlayer->GetPos()); //player position
 
   if(m_vWorldSize.x > m_nWinWidth){ //world wider than screen
     vCameraPos.x = std::max(vCameraPos.x, m_nWinWidth/2.0f); //stay away from the left edge
@@ -472,14 +558,24 @@ void CGame::FollowCamera(){
 /// of animation, which involves the following. Handle keyboard input.
 /// Notify the audio player at the start of each frame so that it can prevent
 /// multiple copies of a sound from starting on the same frame.  
-/// Move the game objects. Render a frame of animation. 
+/// Move the game objects. Render a frame of animation. Sleep until the
+/// next frame is due, if the frame rate is capped.
+///
+/// While paused, nothing moves, so the frame is only rendered again when
+/// something on it has changed, or once a second if the frame rate text,
+/// which shows the CPU utilization, is on. The keyboard is polled at
+/// `IDLE_FRAME_RATE` in between. The last frame presented stays in the
+/// window meanwhile.
 
 void CGame::ProcessFrame(){
   KeyboardHandler(); //handle keyboard input
-  if (m_eGameState == eGameState::Paused) {
-      RenderFrame();
-      return;
-  }
+
+  if(m_eGameState == eGameState::Paused){
+    if(m_bDirty)RenderFrame(); //only if something changed
+    m_bDirty = m_cFramePacer.Wait(ePaceMode::Idle) && m_bDrawFrameRate;
+    return;
+  } //if
+
   ControllerHandler(); //handle controller input
   m_pAudio->BeginFrame(); //notify audio player that frame has begun
   
@@ -489,10 +585,32 @@ void CGame::ProcessFrame(){
     m_pParticleEngine->step(); //advance particle animation
   });
 
+  UpdateAllocationRate(); //sample object allocations
   RenderFrame(); //render a frame of animation
   ProcessGameState(); //check for end of game
+
+  m_cFramePacer.Wait(HasFocus()? ePaceMode::Active: ePaceMode::Background);
 } //ProcessFrame
 
+/// Turn the cap on the frame rate while playing in the foreground on or off.
+/// \param cap true to cap the frame rate at `FRAME_RATE_CAP`.
+
+void CGame::SetFrameRateCap(bool cap){
+  m_bFrameRateCap = cap;
+  m_cFramePacer.SetRate(ePaceMode::Active, cap? FRAME_RATE_CAP: 0.0f);
+  m_bDirty = true;
+} //SetFrameRateCap
+
+/// Check whether the game window is in the foreground, that is, whether the
+/// foreground window belongs to this process.
+/// \return true if the game window is in the foreground.
+
+const bool CGame::HasFocus() const{
+  DWORD id = 0; //process that owns the foreground window
+  GetWindowThreadProcessId(GetForegroundWindow(), &id);
+  return id == GetCurrentProcessId();
+} //HasFocus
+
 /// Take action appropriate to the current game state. If the game is currently
 /// playing, then if the player has been killed or all Zombies have been
 /// killed, then enter the wait state. If the game has been in the wait
@@ -503,7 +621,7 @@ void CGame::ProcessGameState(){
 
   switch(m_eGameState){
     case eGameState::Playing:
-      if(m_pPlayer == nullptr || m_pObjectManager->GetNumTurrets() == 0){
+      if(m_pObjectManager->GetPlayer() == nullptr || m_pObjectManager->GetNumTurrets() == 0){
         m_eGameState = eGameState::Waiting; //now waiting
         t = m_pTimer->GetTime(); //start wait timer
       } //if
@@ -6,6 +6,7 @@
 
 #include "Component.h"
 #include "Common.h"
+#include "FramePacer.h"
 #include "ObjectManager.h"
 #include "Settings.h"
 #include "Player.h"
@@ -27,8 +28,16 @@ class CGame:
 
   private:
     bool m_bDrawFrameRate = false; ///< Draw the frame rate.
+    bool m_bFrameRateCap = false; ///< Cap the frame rate while playing.
+    bool m_bDirty = true; ///< Whether the paused screen needs redrawing.
     eGameState m_eGameState = eGameState::Playing; ///< Game state.
     int m_nNextLevel = 0; ///< Current level number.
+
+    float m_fAllocSampleTime = 0.0f; ///< Time of last allocation count sample.
+    size_t m_nAllocSampleCount = 0; ///< Allocation count at last sample.
+    size_t m_nAllocsPerSecond = 0; ///< Object allocations per second.
+
+    CFramePacer m_cFramePacer; ///< Sleeps between frames and measures CPU use.
     
     void LoadImages(); ///< Load images.
     void LoadSounds(); ///< Load sounds.
@@ -37,11 +46,15 @@ class CGame:
     void ControllerHandler(); ///< The controller handler.
     void RenderFrame(); ///< Render an animation frame.
     void DrawFrameRateText(); ///< Draw frame rate text to screen.
+    void DrawObjectCountText(); ///< Draw live object counts to screen.
+    void UpdateAllocationRate(); ///< Sample object allocations per second.
     void DrawPausedText(); ///< Draw pause text when paused.
     void DrawGodModeText(); ///< Draw god mode text if in god mode.
     void CreateObjects(); ///< Create game objects.
     void FollowCamera(); ///< Make camera follow player character.
     void ProcessGameState(); ///< Process game state.
+    void SetFrameRateCap(bool); ///< Turn the frame rate cap on or off.
+    const bool HasFocus() const; ///< Whether the game window is in the foreground.
 
   public:
     ~CGame(); ///< Destructor.
@@ -14,7 +14,7 @@
 
 enum class eSprite: UINT{
 
-  Background, Bullet, bulletenemy, Turret, Smoke, Spark, Tile, Line, Furniture, Fireball, sword, greatsword, dagger, shield, HealthBar, stationaryturret,
+  Background, Bullet, bulletenemy, Turret, Smoke, Spark, Tile, Line, Furniture, Fireball, sword, greatsword, dagger, shield, HealthBar, stationaryturret, Pixel,
   
 //Player Walk 
 PlayerWalkLeft, PlayerWalkLeftSpriteSheet, PlayerWalkRight, 
@@ -35,6 +35,13 @@ ZombieWalkLeftSpriteSheet, ZombieWalkLeft,
 ZombieWalkRightSpriteSheet, ZombieWalkRight,
 ZombieWalkUpSpriteSheet, ZombieWalkUp,
 ZombieWalkDownSpriteSheet, ZombieWalkDown,
+//Skeleton Stand
+SkeletonStandDown, SkeletonStandLeft, SkeletonStandRight, SkeletonStandUp,
+//Skeleton Walk
+SkeletonWalkLeftSpriteSheet, SkeletonWalkLeft,
+SkeletonWalkRightSpriteSheet, SkeletonWalkRight,
+SkeletonWalkUpSpriteSheet, SkeletonWalkUp,
+SkeletonWalkDownSpriteSheet, SkeletonWalkDown,
 
 Size  //MUST BE LAST
 
@@ -51,6 +58,18 @@ enum class eSound: UINT{
   Size  //MUST BE LAST
 }; //eSound
 
+/// \brief Object kind enumerated type.
+///
+/// An enumerated type for the kinds of game object, which the object manager
+/// uses to keep each kind in its own list so that the per-frame loops over
+/// them can call member functions directly. `Size` must be last.
+
+enum class eObjectKind: BYTE{
+  Player, Bullet, EnemyBullet, Zombie, Turret, StationaryTurret, Furniture,
+  Shield, Enemy, Other,
+  Size  //MUST BE LAST
+}; //eObjectKind
+
 /// \brief Game state enumerated type.
 ///
 /// An enumerated type for the game state, which can be either playing or
@@ -61,6 +80,38 @@ enum class eGameState{
   Playing, Waiting, Paused
 }; //eGameState
 
+/// \brief Render layer enumerated type.
+///
+/// An enumerated type for the layers that sprites are drawn in, back to
+/// front. Everything in a layer is drawn before anything in the next one.
+/// `Size` must be last.
+
+enum class eRenderLayer: BYTE{
+  Floor, Furniture, Characters, Projectiles, Overlay,
+  Size  //MUST BE LAST
+}; //eRenderLayer
+
+/// \brief Log level enumerated type.
+///
+/// An enumerated type for the severity of a log message, least severe first.
+/// `Off` must be last.
+
+enum class eLogLevel: BYTE{
+  Trace, Debug, Info, Warn, Error,
+  Off  //MUST BE LAST
+}; //eLogLevel
+
+/// \brief Log category enumerated type.
+///
+/// An enumerated type for the part of the game that a log message comes from,
+/// which will be cast to an unsigned integer and used as a bit position in
+/// `LOG_CATEGORIES`. `Size` must be last.
+
+enum class eLogCategory: BYTE{
+  General, Objects, Collision, Render, Audio, Level,
+  Size  //MUST BE LAST
+}; //eLogCategory
+
 
 
 // FireBall
@@ -100,5 +151,71 @@ const float SHIELD_RADIUS_MODIFIER = 1.0f;
 const float PLAYER_NORMAL_SPEED = 300.0f;
 const float PLAYER_SHIELD_SPEED = 100.0f;
 
+// Continuous collision
+const float FAST_OBJECT_SPEED = 800.0f; ///< Projectiles this fast use swept collision.
+
+// Projectile pool
+const UINT PROJECTILE_POOL_SIZE = 256; ///< Projectiles preallocated per pool.
+
+// Spawning
+const float PATROL_DISTANCE = 100.0f; ///< Length of an enemy's patrol path.
+
+// Sleeping
+const float SLEEP_DELAY = 2.0f; ///< Seconds at rest before an enemy falls asleep.
+const float SLEEP_WAKE_RADIUS = 400.0f; ///< Player distance that wakes an enemy.
+const float WAKE_CHECK_INTERVAL = 0.25f; ///< Seconds between proximity checks.
+
+// Activity bubble
+const float ACTIVE_RADIUS = 800.0f; ///< Enemies this close to the player update every frame.
+const float DORMANT_RADIUS = 1600.0f; ///< Enemies this far from the player are dormant.
+const UINT MIDDLE_RING_PERIOD = 4; ///< Frames between updates in the middle ring.
+
+// Position solver
+const UINT SOLVER_ITERATIONS = 8; ///< Most solver iterations per frame.
+const float SOLVER_SLOP = 0.5f; ///< Overlap in pixels that the solver leaves alone.
+const float SOLVER_TOLERANCE = 1.0f; ///< Worst overlap in pixels at which the solver stops early.
+
+// Spatial index
+const float GRID_CELL_SIZE = 256.0f; ///< Width and height of a spatial grid cell.
+
+// Background
+const UINT TILE_CHUNK_SIZE = 8; ///< Width and height of a background chunk in tiles.
+
+// Lighting
+const UINT LIGHT_MAX = 15; ///< Brightest light level.
+const float LIGHT_AMBIENT = 0.6f; ///< Brightness of an unlit tile, as a fraction of full.
+const UINT LIGHT_PLAYER = 10; ///< Light level of the player's lantern.
+const UINT LIGHT_FIREBALL = 8; ///< Light level of a fireball.
+const UINT LIGHT_FLASH = 6; ///< Light level of a muzzle flash.
+const float LIGHT_FLASH_TIME = 0.08f; ///< Seconds that a muzzle flash lasts.
+
+// Animation
+const float ANIM_FRAME_TIME = 0.12f; ///< Default seconds per animation frame.
+
+// Heads-up display
+const float HUD_MARGIN = 16.0f; ///< Gap in pixels between the HUD and the window edge.
+
+// Minimap
+const float MINIMAP_SIZE = 192.0f; ///< Width and height of the minimap in pixels.
+const UINT MINIMAP_CELLS = 64; ///< Most cells across the minimap, which picks the pyramid level drawn.
+const float MINIMAP_MARKER_RANGE = 2048.0f; ///< Distance from the player in pixels within which enemies are marked.
+const float MINIMAP_MARKER_SIZE = 4.0f; ///< Smallest marker width in pixels.
+
+// Frame pacing
+const float FRAME_RATE_CAP = 60.0f; ///< Most frames per second while playing with the cap on.
+const float BACKGROUND_FRAME_RATE = 30.0f; ///< Most frames per second while playing in the background.
+const float IDLE_FRAME_RATE = 20.0f; ///< Input polls per second while paused.
+
+// Logging
+#ifdef _DEBUG
+  const eLogLevel LOG_LEVEL = eLogLevel::Debug; ///< Least severe level compiled in.
+#else
+  const eLogLevel LOG_LEVEL = eLogLevel::Info; ///< Least severe level compiled in.
+#endif //_DEBUG
+
+const UINT LOG_CATEGORIES = 0xFFFFFFFF; ///< Bit mask of categories compiled in.
+const UINT LOG_BUFFER_SIZE = 4096; ///< Log records in the ring buffer, a power of 2.
+const UINT LOG_MAX_FIELDS = 4; ///< Most key-value fields in a log record.
+
 
 #endif //__L4RC_GAME_GAMEDEFINES_H__
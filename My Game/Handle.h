@@ -0,0 +1,122 @@
+/// \file Handle.h
+/// \brief Interface and code for the handle CHandle and the handle table
+/// template CHandleTable.
+
+#ifndef __L4RC_GAME_HANDLE_H__
+#define __L4RC_GAME_HANDLE_H__
+
+#include <vector>
+
+#include "Defines.h"
+
+/// \brief Generation-checked handle.
+///
+/// A handle names a slot in a pool or handle table together with the
+/// generation that the slot had when the handle was issued. Releasing a slot
+/// bumps its generation, so any handle still held to the old occupant goes
+/// stale instead of silently referring to whatever reuses the slot.
+
+struct CHandle{
+  UINT m_nIndex = UINT_MAX; ///< Slot index.
+  UINT m_nGeneration = 0; ///< Slot generation when the handle was issued.
+
+  const bool IsNull() const{return m_nIndex == UINT_MAX;} ///< Is null handle.
+  void Reset(){m_nIndex = UINT_MAX; m_nGeneration = 0;} ///< Make null.
+}; //CHandle
+
+/// \brief The handle table.
+///
+/// A handle table maps handles to pointers to objects that it does not own.
+/// It lets one object refer to another that may die and be deleted or
+/// recycled at any time, without leaving a dangling pointer behind: once the
+/// object is erased from the table every handle to it resolves to `nullptr`.
+/// Free slots are kept on a stack, so inserting and erasing are constant time.
+
+template<class t> class CHandleTable{
+  private:
+    std::vector<t*> m_vecSlot; ///< Object in each slot, `nullptr` if free.
+    std::vector<UINT> m_vecGeneration; ///< Current generation of each slot.
+    std::vector<UINT> m_vecFreeList; ///< Stack of free slot indices.
+
+  public:
+    void reserve(size_t); ///< Reserve space for slots.
+    void clear(); ///< Erase all objects.
+
+    const CHandle Insert(t*); ///< Issue a handle to an object.
+    void Erase(const CHandle&); ///< Invalidate all handles to an object.
+    t* Get(const CHandle&) const; ///< Get object from handle, if still live.
+}; //CHandleTable
+
+/// Reserve space for a number of slots.
+/// \param n Number of slots.
+
+template<class t> void CHandleTable<t>::reserve(size_t n){
+  m_vecSlot.reserve(n);
+  m_vecGeneration.reserve(n);
+  m_vecFreeList.reserve(n);
+} //reserve
+
+/// Erase every object in the table, keeping the slots and their generations
+/// so that handles issued before the call stay stale afterwards.
+
+template<class t> void CHandleTable<t>::clear(){
+  m_vecFreeList.clear();
+
+  for(UINT i=0; i<(UINT)m_vecSlot.size(); i++){
+    if(m_vecSlot[i] != nullptr){
+      m_vecSlot[i] = nullptr;
+      m_vecGeneration[i]++;
+    } //if
+
+    m_vecFreeList.push_back(i);
+  } //for
+} //clear
+
+/// Put an object into a free slot, adding a slot if there are none.
+/// \param p Pointer to an object.
+/// \return Handle to the object.
+
+template<class t> const CHandle CHandleTable<t>::Insert(t* p){
+  CHandle h;
+
+  if(m_vecFreeList.empty()){
+    h.m_nIndex = (UINT)m_vecSlot.size();
+    m_vecSlot.push_back(p);
+    m_vecGeneration.push_back(0);
+  } //if
+
+  else{
+    h.m_nIndex = m_vecFreeList.back();
+    m_vecFreeList.pop_back();
+    m_vecSlot[h.m_nIndex] = p;
+  } //else
+
+  h.m_nGeneration = m_vecGeneration[h.m_nIndex];
+  return h;
+} //Insert
+
+/// Free an object's slot and bump its generation so that handles to it no
+/// longer resolve. Stale and null handles are ignored.
+/// \param h Handle to the object.
+
+template<class t> void CHandleTable<t>::Erase(const CHandle& h){
+  if(Get(h) == nullptr)return; //stale or null
+
+  m_vecSlot[h.m_nIndex] = nullptr;
+  m_vecGeneration[h.m_nIndex]++;
+  m_vecFreeList.push_back(h.m_nIndex);
+} //Erase
+
+/// Resolve a handle.
+/// \param h Handle to an object.
+/// \return Pointer to the object, or `nullptr` if the handle is stale or null.
+
+template<class t> t* CHandleTable<t>::Get(const CHandle& h) const{
+  if(h.m_nIndex >= m_vecSlot.size() ||
+    m_vecGeneration[h.m_nIndex] != h.m_nGeneration)
+    return nullptr;
+
+  return m_vecSlot[h.m_nIndex];
+} //Get
+
+#endif //__L4RC_GAME_HANDLE_H__
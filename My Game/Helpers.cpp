@@ -45,3 +45,38 @@ void NormalizeAngle(float& theta){
   while(theta < -XM_PI)theta += XM_2PI;
   while(theta >  XM_PI)theta -= XM_2PI;
 } //NormalizeAngle
+
+/// Sweep a point along a displacement vector against a circle and compute
+/// the time of impact. A moving circle of radius \f$r_0\f$ against a
+/// stationary circle of radius \f$r_1\f$ is the same as a moving point
+/// against a circle of radius \f$r_0 + r_1\f$, so callers pass the sum of
+/// the radii. Solving \f$|\vec{p} + t\vec{v} - \vec{c}|^2 = r^2\f$ for
+/// \f$t\f$ gives a quadratic whose smaller root is the time of impact. Only
+/// approaching contacts that start outside the circle are reported, since
+/// overlaps at the start of the sweep are left to the discrete tests.
+/// \param p Start position of the point.
+/// \param v Displacement of the point over the sweep.
+/// \param c Center of circle.
+/// \param r Radius of circle.
+/// \param t [out] Time of impact as a fraction of the sweep in \f$[0, 1]\f$.
+/// \return true If the point hits the circle during the sweep.
+
+const bool SweepCircle(const Vector2& p, const Vector2& v, const Vector2& c,
+  float r, float& t)
+{
+  const Vector2 m = p - c; //from circle center to start point
+  const float b = m.x*v.x + m.y*v.y; //half the linear coefficient
+  const float k = m.x*m.x + m.y*m.y - r*r; //constant coefficient
+
+  if(k <= 0.0f || b >= 0.0f) //starts inside or moving away
+    return false;
+
+  const float a = v.x*v.x + v.y*v.y; //quadratic coefficient
+  const float disc = b*b - a*k; //quarter of the discriminant
+
+  if(a <= 0.0f || disc < 0.0f) //not moving or misses the circle
+    return false;
+
+  t = (-b - sqrtf(disc))/a; //smaller root
+  return t <= 1.0f;
+} //SweepCircle
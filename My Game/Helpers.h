@@ -9,6 +9,8 @@
 const Vector2 AngleToVector(const float theta); ///< Convert angle to vector.
 const Vector2 VectorNormalCC(const Vector2& v); ///< Counterclockwise normal.
 void NormalizeAngle(float& theta); ///< Normalize angle to \f$\pm\pi\f$.
+const bool SweepCircle(const Vector2&, const Vector2&, const Vector2&,
+  float, float&); ///< Moving point against circle, time of impact.
 
 inline float Dot(const Vector2& v1, const Vector2& v2) {
 	return v1.x * v2.x + v1.y * v2.y;
@@ -0,0 +1,93 @@
+/// \file Hud.cpp
+/// \brief Code for the heads-up display CHud.
+
+#include <algorithm>
+
+#include "Hud.h"
+#include "ComponentIncludes.h"
+#include "GameDefines.h"
+#include "Animator.h"
+#include "TileManager.h"
+#include "ObjectManager.h"
+#include "Player.h"
+
+/// Anchor the health bar to the bottom left corner of the window, inside a
+/// margin of `HUD_MARGIN` pixels, and show it full. The health bar sprite
+/// must already have been loaded and the animation clips built.
+
+CHud::CHud(){
+  const UINT t = (UINT)eSprite::HealthBar; //shorthand
+  const float w = m_pRenderer->GetWidth(t);
+  const float h = m_pRenderer->GetHeight(t);
+
+  m_cHealthBar.m_nSpriteIndex = t;
+  m_nHealthBarFrames = CAnimator::GetClip(t).m_nFrames;
+
+  m_vHealthBarOffset.x = HUD_MARGIN + 0.5f*(w - m_nWinWidth);
+  m_vHealthBarOffset.y = HUD_MARGIN + 0.5f*(h - m_nWinHeight);
+
+  SetHealth(1, 1);
+} //constructor
+
+/// Set the health bar frame for the player's health. The frames show health
+/// in steps of 5%, from empty in frame 0 to full in frame 20, and health is
+/// rounded down to the step below. This is called by the player whenever its
+/// health changes, and never while drawing.
+/// \param health Health.
+/// \param maxHealth Maximum health.
+
+void CHud::SetHealth(UINT health, UINT maxHealth){
+  if(m_nHealthBarFrames == 0 || maxHealth == 0)return; //safety
+
+  const UINT frame = (100*std::min(health, maxHealth)/maxHealth)/5;
+  m_cHealthBar.m_nCurrentFrame = std::min(frame, m_nHealthBarFrames - 1);
+} //SetHealth
+
+/// Show the minimap if it is hidden, and hide it if it is showing.
+
+void CHud::ToggleMinimap(){
+  m_bDrawMinimap = !m_bDrawMinimap;
+} //ToggleMinimap
+
+/// Draw the heads-up display. Screen space is mapped to world space by
+/// moving it with the camera, so each sprite is placed at its offset from
+/// the camera position.
+
+void CHud::Draw(){
+  const Vector2 vCamera = m_pRenderer->GetCameraPos(); //center of window
+
+  m_cHealthBar.m_vPos = vCamera + m_vHealthBarOffset;
+  m_pRenderer->Draw(&m_cHealthBar);
+
+  if(m_bDrawMinimap)
+    DrawMinimap(vCamera);
+} //Draw
+
+/// Draw the minimap, with markers for the enemies near the player, which are
+/// looked up in the object manager's spatial grid so that enemies far away
+/// are never visited.
+/// \param vCamera Camera position.
+
+void CHud::DrawMinimap(const Vector2& vCamera){
+  const CPlayer* pPlayer = m_pObjectManager->GetPlayer();
+  const Vector2 vCenter = pPlayer? pPlayer->GetPos(): vCamera; //center of marker range
+  const Vector2 vRange(MINIMAP_MARKER_RANGE, MINIMAP_MARKER_RANGE);
+
+  m_vecEnemy.clear();
+
+  m_pObjectManager->GetGrid().Query(vCenter - vRange, vCenter + vRange, [&](CObject* pObj){
+    switch(pObj->GetKind()){
+      case eObjectKind::Zombie:
+      case eObjectKind::Turret:
+      case eObjectKind::StationaryTurret:
+      case eObjectKind::Enemy:
+        m_vecEnemy.push_back(pObj->GetPos());
+        break;
+
+      default: break;
+    } //switch
+  }); //Query
+
+  m_pTileManager->GetMinimap().Draw(m_pRenderer, vCamera,
+    pPlayer? &pPlayer->GetPos(): nullptr, m_vecEnemy);
+} //DrawMinimap
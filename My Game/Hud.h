@@ -0,0 +1,45 @@
+/// \file Hud.h
+/// \brief Interface for the heads-up display CHud.
+
+#ifndef __L4RC_GAME_HUD_H__
+#define __L4RC_GAME_HUD_H__
+
+#include <vector>
+
+#include "Common.h"
+#include "Settings.h"
+#include "SpriteDesc.h"
+
+/// \brief The heads-up display.
+///
+/// The heads-up display is drawn on top of everything else in screen space,
+/// that is, at a fixed place in the window however the camera moves. It is
+/// not a game object, so it takes no part in the update, collision, and
+/// culling passes of the object manager. Its sprites are worked out only
+/// when something that they show changes, which the objects concerned report
+/// to it, so drawing it costs no more than placing each sprite relative to
+/// the camera and submitting it. At present it shows the player's health and
+/// the minimap, which belongs to the tile manager.
+
+class CHud:
+  public LSettings,
+  public CCommon
+{
+  private:
+    LSpriteDesc2D m_cHealthBar; ///< Health bar sprite.
+    Vector2 m_vHealthBarOffset; ///< Health bar position relative to window center.
+    UINT m_nHealthBarFrames = 0; ///< Number of frames in the health bar sprite.
+    bool m_bDrawMinimap = true; ///< Whether to draw the minimap.
+    std::vector<Vector2> m_vecEnemy; ///< Positions of enemies to mark on the minimap.
+
+    void DrawMinimap(const Vector2&); ///< Draw the minimap.
+
+  public:
+    CHud(); ///< Constructor.
+
+    void SetHealth(UINT, UINT); ///< Respond to a change in player health.
+    void ToggleMinimap(); ///< Show or hide the minimap.
+    void Draw(); ///< Draw in screen space.
+}; //CHud
+
+#endif //__L4RC_GAME_HUD_H__
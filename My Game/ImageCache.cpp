@@ -0,0 +1,218 @@
+/// \file ImageCache.cpp
+/// \brief Code for the decoded image cache CImageCache.
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#ifdef _WIN32
+  #include <direct.h>
+#else
+  #include <sys/stat.h>
+#endif //_WIN32
+
+#include "ImageCache.h"
+#include "ImageDecoder.h"
+#include "MappedFile.h"
+
+static const uint32_t CACHE_MAGIC = 0x43493434; ///< "44IC", marks a cache file.
+static const uint32_t CACHE_VERSION = 1; ///< Bump when the layout changes.
+static const size_t CACHE_DATA_OFFSET = 64; ///< Pixels start here, aligned for upload.
+
+/// \brief Cache file header.
+///
+/// The start of a cache file. The pixels follow at `CACHE_DATA_OFFSET`.
+
+struct CCacheHeader{
+  uint32_t m_nMagic = CACHE_MAGIC; ///< Marks a cache file.
+  uint32_t m_nVersion = CACHE_VERSION; ///< Layout version.
+  uint64_t m_nHash = 0; ///< Hash of the source file.
+  uint64_t m_nSourceSize = 0; ///< Size of the source file.
+  int32_t m_nWidth = 0; ///< Width of the top level.
+  int32_t m_nHeight = 0; ///< Height of the top level.
+  int32_t m_nChannels = 0; ///< Channels per pixel.
+  int32_t m_nLevels = 0; ///< Number of mipmap levels.
+  uint32_t m_nFormat = 0; ///< Requested format, see `PackFormat()`.
+  uint32_t m_nPad = 0; ///< Padding.
+  uint64_t m_nDataSize = 0; ///< Size of the pixels.
+}; //CCacheHeader
+
+static_assert(sizeof(CCacheHeader) <= CACHE_DATA_OFFSET, "cache header too big");
+
+/// Pack an image format into 32 bits for the cache file header.
+/// \param f Image format.
+/// \return Requested channels in the low byte, then the flags.
+
+static uint32_t PackFormat(const CImageFormat& f){
+  return (uint32_t)f.m_nChannels | (f.m_bPremultiply? 0x100: 0) | (f.m_bMipmaps? 0x200: 0);
+} //PackFormat
+
+/// Create the cache folder if it isn't there.
+/// \param folder Folder name.
+
+CImageCache::CImageCache(const std::string& folder):
+  m_strFolder(folder), m_nHits(0), m_nMisses(0)
+{
+  #ifdef _WIN32
+    _mkdir(folder.c_str());
+  #else
+    mkdir(folder.c_str(), 0755);
+  #endif //_WIN32
+} //constructor
+
+/// Hash the contents of a source file, 8 bytes at a time, finishing with a
+/// mix that spreads every input bit over the whole result. It only needs to
+/// tell versions of a file apart, so it isn't cryptographic, and it costs
+/// next to nothing beside decoding.
+/// \param p Pointer to the file contents.
+/// \param n Size in bytes.
+/// \return Hash.
+
+const uint64_t CImageCache::Hash(const unsigned char* p, size_t n){
+  const uint64_t k = 0x9E3779B97F4A7C15ULL; //odd multiplier
+  uint64_t h = n*k;
+  size_t i = 0;
+
+  for(; i + 8 <= n; i+=8){
+    uint64_t w;
+    memcpy(&w, p + i, 8);
+    h = (h ^ w*k)*0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+  } //for
+
+  for(; i<n; i++)
+    h = (h ^ p[i])*0x100000001B3ULL;
+
+  h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+
+  return h;
+} //Hash
+
+/// Get the name of the cache file for a source file hash and a format.
+/// \param hash Hash of the source file.
+/// \param f Image format.
+/// \return File name.
+
+const std::string CImageCache::GetFileName(uint64_t hash, const CImageFormat& f) const{
+  char name[64];
+  snprintf(name, sizeof(name), "%016llx-%d%s%s.img", (unsigned long long)hash,
+    f.m_nChannels, f.m_bPremultiply? "p": "", f.m_bMipmaps? "m": "");
+
+  return m_strFolder + "/" + name;
+} //GetFileName
+
+/// Look up a decoded image. If it is there, map its cache file and point
+/// the image at the pixels in it.
+/// \param hash Hash of the source file.
+/// \param size Size of the source file.
+/// \param file Source file name, for the image.
+/// \param f Image format.
+/// \param img [out] Image, only changed if found.
+/// \return true if found.
+
+const bool CImageCache::Find(uint64_t hash, uint64_t size,
+  const std::string& file, const CImageFormat& f, CDecodedImage& img)
+{
+  auto pMapping = std::make_shared<CMappedFile>();
+  CCacheHeader h;
+
+  bool ok = pMapping->Open(GetFileName(hash, f)) &&
+    pMapping->GetSize() >= CACHE_DATA_OFFSET;
+
+  if(ok){
+    memcpy(&h, pMapping->GetData(), sizeof(h));
+
+    ok = h.m_nMagic == CACHE_MAGIC && h.m_nVersion == CACHE_VERSION &&
+      h.m_nHash == hash && h.m_nSourceSize == size &&
+      h.m_nFormat == PackFormat(f) && h.m_nLevels >= 1 &&
+      h.m_nDataSize == CDecodedImage::GetChainSize(h.m_nWidth, h.m_nHeight,
+        h.m_nChannels, h.m_nLevels) &&
+      pMapping->GetSize() >= CACHE_DATA_OFFSET + h.m_nDataSize;
+  } //if
+
+  if(!ok){
+    m_nMisses++;
+    return false;
+  } //if
+
+  img.m_strFile = file;
+  img.m_nWidth = h.m_nWidth;
+  img.m_nHeight = h.m_nHeight;
+  img.m_nChannels = h.m_nChannels;
+  img.m_nLevels = h.m_nLevels;
+  img.m_vecPixel.clear();
+  img.m_pMapping = pMapping;
+  img.m_nOffset = CACHE_DATA_OFFSET;
+  img.m_nSize = (size_t)h.m_nDataSize;
+
+  m_nHits++;
+  return true;
+} //Find
+
+/// Put a decoded image in the cache. It is written to a temporary file that
+/// is renamed when complete. Renaming onto an existing file fails on
+/// Windows, so if the rename fails, the existing file, which is either
+/// damaged or the same image written by another thread, is deleted and the
+/// rename tried once more. Failing to write is not an error; the image just
+/// isn't cached.
+/// \param hash Hash of the source file.
+/// \param size Size of the source file.
+/// \param f Image format.
+/// \param img Decoded image.
+
+void CImageCache::Store(uint64_t hash, uint64_t size, const CImageFormat& f,
+  const CDecodedImage& img)
+{
+  CCacheHeader h;
+  h.m_nHash = hash;
+  h.m_nSourceSize = size;
+  h.m_nWidth = img.m_nWidth;
+  h.m_nHeight = img.m_nHeight;
+  h.m_nChannels = img.m_nChannels;
+  h.m_nLevels = img.m_nLevels;
+  h.m_nFormat = PackFormat(f);
+  h.m_nDataSize = img.GetSize();
+
+  const std::string name = GetFileName(hash, f);
+  const std::string temp = name + "." +
+    std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+  FILE* fp = fopen(temp.c_str(), "wb");
+  if(fp == nullptr)return;
+
+  unsigned char header[CACHE_DATA_OFFSET] = {0};
+  memcpy(header, &h, sizeof(h));
+
+  const bool ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header) &&
+    fwrite(img.GetData(), 1, img.GetSize(), fp) == img.GetSize();
+
+  if(fclose(fp) != 0 || !ok){
+    remove(temp.c_str());
+    return;
+  } //if
+
+  if(rename(temp.c_str(), name.c_str()) != 0){
+    remove(name.c_str());
+
+    if(rename(temp.c_str(), name.c_str()) != 0)
+      remove(temp.c_str());
+  } //if
+} //Store
+
+/// Reader function for the number of images found in the cache.
+/// \return Number of hits.
+
+const size_t CImageCache::GetNumHits() const{
+  return m_nHits;
+} //GetNumHits
+
+/// Reader function for the number of images not found in the cache.
+/// \return Number of misses.
+
+const size_t CImageCache::GetNumMisses() const{
+  return m_nMisses;
+} //GetNumMisses
@@ -0,0 +1,50 @@
+/// \file ImageCache.h
+/// \brief Interface for the decoded image cache CImageCache.
+
+#ifndef __L4RC_GAME_IMAGECACHE_H__
+#define __L4RC_GAME_IMAGECACHE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CImageFormat;
+struct CDecodedImage;
+
+/// \brief The image cache.
+///
+/// The image cache keeps decoded images on disk, ready to upload, in files
+/// named after the hash of the source file's contents and the format that it
+/// was decoded to. A cached image is memory-mapped rather than read, so
+/// loading one costs hashing the source file and touching the pages of
+/// pixels. Changing a source file changes its hash, so a stale entry is
+/// never found again; it is just left behind. Each cache file starts with a
+/// header that repeats the hash, the source size, and the format, which is
+/// checked before the pixels are used, so a damaged or truncated file, or a
+/// hash collision between files of different sizes, counts as a miss. Files
+/// are written under a temporary name and then renamed, so another process
+/// never maps a half-written one.
+
+class CImageCache{
+  private:
+    std::string m_strFolder; ///< Folder that the cache files go in.
+
+    std::atomic<size_t> m_nHits; ///< Number of images found.
+    std::atomic<size_t> m_nMisses; ///< Number of images not found.
+
+    const std::string GetFileName(uint64_t, const CImageFormat&) const; ///< Cache file name.
+
+  public:
+    CImageCache(const std::string&); ///< Constructor.
+
+    const bool Find(uint64_t, uint64_t, const std::string&, const CImageFormat&, CDecodedImage&); ///< Look up an image.
+    void Store(uint64_t, uint64_t, const CImageFormat&, const CDecodedImage&); ///< Put an image in.
+
+    const size_t GetNumHits() const; ///< Number of images found.
+    const size_t GetNumMisses() const; ///< Number of images not found.
+
+    static const uint64_t Hash(const unsigned char*, size_t); ///< Hash file contents.
+}; //CImageCache
+
+#endif //__L4RC_GAME_IMAGECACHE_H__
@@ -0,0 +1,338 @@
+/// \file ImageDecoder.cpp
+/// \brief Code for the image decoder CImageDecoder.
+
+#define STBI_ASSERT(x)
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <cstdio>
+
+#include "stb_image.h"
+#include "ImageDecoder.h"
+#include "ImageCache.h"
+#include "MappedFile.h"
+
+/// Read a whole file into memory.
+/// \param file File name.
+/// \param v [out] Contents.
+/// \return true if it was read.
+
+static const bool ReadFile(const std::string& file, std::vector<unsigned char>& v){
+  FILE* fp = fopen(file.c_str(), "rb");
+  if(fp == nullptr)return false;
+
+  fseek(fp, 0, SEEK_END);
+  const long n = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+
+  v.resize(n > 0? (size_t)n: 0);
+  const bool ok = n > 0 && fread(v.data(), 1, v.size(), fp) == v.size();
+
+  fclose(fp);
+  return ok;
+} //ReadFile
+
+/// Reader function for whether the image has pixels.
+/// \return true if it has pixels.
+
+const bool CDecodedImage::IsValid() const{
+  return GetSize() > 0;
+} //IsValid
+
+/// Reader function for whether the pixels came from the image cache.
+/// \return true if they are in a view of a cache file.
+
+const bool CDecodedImage::IsCached() const{
+  return m_pMapping != nullptr;
+} //IsCached
+
+/// Reader function for the pixels.
+/// \return Pointer to the first byte of the top mipmap level.
+
+const unsigned char* CDecodedImage::GetData() const{
+  return m_pMapping? m_pMapping->GetData() + m_nOffset: m_vecPixel.data();
+} //GetData
+
+/// Reader function for the size of the pixels, all mipmap levels included.
+/// \return Size in bytes.
+
+const size_t CDecodedImage::GetSize() const{
+  return m_pMapping? m_nSize: m_vecPixel.size();
+} //GetSize
+
+/// Get the offset of a mipmap level from the start of the pixels.
+/// \param level Mipmap level, 0 for the top one.
+/// \return Offset in bytes.
+
+const size_t CDecodedImage::GetLevelOffset(int level) const{
+  return GetChainSize(m_nWidth, m_nHeight, m_nChannels, level);
+} //GetLevelOffset
+
+/// Get the size of the first few levels of a mipmap chain. Each level is
+/// half the width and height of the one before, rounded down, but never
+/// less than 1.
+/// \param w Width of the top level.
+/// \param h Height of the top level.
+/// \param channels Channels per pixel.
+/// \param levels Number of levels.
+/// \return Size in bytes.
+
+const size_t CDecodedImage::GetChainSize(int w, int h, int channels, int levels){
+  size_t n = 0;
+
+  for(int i=0; i<levels; i++){
+    n += (size_t)w*h*channels;
+    w = std::max(w/2, 1);
+    h = std::max(h/2, 1);
+  } //for
+
+  return n;
+} //GetChainSize
+
+/// Start the worker threads.
+/// \param n Number of worker threads, or 0 for the thread pool's default.
+
+CImageDecoder::CImageDecoder(size_t n):
+  m_cPool(n){
+} //constructor
+
+/// The destructor is here, where `CImageCache` is a complete type, so that
+/// the image cache can be deleted.
+
+CImageDecoder::~CImageDecoder(){
+} //destructor
+
+/// Use an image cache in a folder, which is created if it doesn't exist.
+/// Call this before requesting or decoding anything.
+/// \param folder Folder name, or the empty string for no cache.
+
+void CImageDecoder::SetCache(const std::string& folder){
+  m_pCache.reset(folder.empty()? nullptr: new CImageCache(folder));
+} //SetCache
+
+/// Reader function for the image cache.
+/// \return Pointer to the image cache, or `nullptr` if there isn't one.
+
+const CImageCache* CImageDecoder::GetCache() const{
+  return m_pCache.get();
+} //GetCache
+
+/// Decode an image file that has been read into memory, then premultiply
+/// and make mipmaps if asked to.
+/// \param p Pointer to the file contents.
+/// \param n Size of the file contents in bytes.
+/// \param img [out] Decoded image. Its file name is left alone.
+/// \param f Format wanted.
+/// \return true if it decoded.
+
+const bool CImageDecoder::DecodeMemory(const unsigned char* p, size_t n,
+  CDecodedImage& img, const CImageFormat& f)
+{
+  img.m_vecPixel.clear();
+  img.m_pMapping.reset();
+  img.m_nOffset = img.m_nSize = 0;
+  img.m_nLevels = 0;
+
+  int w = 0, h = 0, channels = 0;
+  unsigned char* pPixel = stbi_load_from_memory(p, (int)n, &w, &h, &channels, f.m_nChannels);
+  if(pPixel == nullptr)return false;
+
+  img.m_nWidth = w;
+  img.m_nHeight = h;
+  img.m_nChannels = f.m_nChannels == 0? channels: f.m_nChannels;
+  img.m_nLevels = 1;
+  img.m_vecPixel.assign(pPixel, pPixel + (size_t)w*h*img.m_nChannels);
+  stbi_image_free(pPixel);
+
+  if(f.m_bPremultiply && img.m_nChannels == 4)Premultiply(img);
+  if(f.m_bMipmaps)MakeMipmaps(img);
+
+  return true;
+} //DecodeMemory
+
+/// Decode an image file on the calling thread, without the image cache.
+/// \param file File name.
+/// \param img [out] Decoded image.
+/// \param f Format wanted.
+/// \return true if it decoded.
+
+const bool CImageDecoder::DecodeFile(const std::string& file,
+  CDecodedImage& img, const CImageFormat& f)
+{
+  std::vector<unsigned char> v; //file contents
+  img.m_strFile = file;
+
+  if(!ReadFile(file, v)){
+    DecodeMemory(nullptr, 0, img, f); //clears it
+    return false;
+  } //if
+
+  return DecodeMemory(v.data(), v.size(), img, f);
+} //DecodeFile
+
+/// Load an image file on the calling thread. With an image cache, the file
+/// is read and hashed, and the decoded image is taken from the cache if it
+/// is there and otherwise decoded from the file contents already read and
+/// put in the cache. Without one, the file is just decoded.
+/// \param file File name.
+/// \param img [out] Decoded image.
+/// \param f Format wanted.
+/// \return true if it loaded.
+
+const bool CImageDecoder::Load(const std::string& file, CDecodedImage& img,
+  const CImageFormat& f)
+{
+  if(m_pCache == nullptr)
+    return DecodeFile(file, img, f);
+
+  std::vector<unsigned char> v; //file contents
+  img.m_strFile = file;
+
+  if(!ReadFile(file, v)){
+    DecodeMemory(nullptr, 0, img, f); //clears it
+    return false;
+  } //if
+
+  const uint64_t hash = CImageCache::Hash(v.data(), v.size());
+
+  if(m_pCache->Find(hash, v.size(), file, f, img))
+    return true;
+
+  if(!DecodeMemory(v.data(), v.size(), img, f))
+    return false;
+
+  m_pCache->Store(hash, v.size(), f, img);
+  return true;
+} //Load
+
+/// Multiply the color channels of each pixel by its alpha, rounding to the
+/// nearest, so that the image can be blended with premultiplied alpha.
+/// \param img Image with 4 channels and no mipmaps yet.
+
+void CImageDecoder::Premultiply(CDecodedImage& img){
+  for(size_t i=0; i<img.m_vecPixel.size(); i+=4){
+    unsigned char* p = &img.m_vecPixel[i]; //shorthand
+    const unsigned a = p[3];
+
+    for(int j=0; j<3; j++)
+      p[j] = (unsigned char)((p[j]*a + 127)/255);
+  } //for
+} //Premultiply
+
+/// Append the rest of the mipmap chain, down to 1 by 1, each level made from
+/// the one before by averaging 2 by 2 blocks of pixels. An odd last column
+/// or row is left out, and once a level is down to a single column or row,
+/// that column or row stands in for its missing neighbor.
+/// \param img Image with a single level.
+
+void CImageDecoder::MakeMipmaps(CDecodedImage& img){
+  const int c = img.m_nChannels; //shorthand
+  int w = img.m_nWidth, h = img.m_nHeight; //size of level before
+  size_t src = 0; //offset of level before
+
+  img.m_nLevels = 1;
+  while((w >> (img.m_nLevels - 1)) > 1 || (h >> (img.m_nLevels - 1)) > 1)
+    img.m_nLevels++;
+
+  img.m_vecPixel.resize(CDecodedImage::GetChainSize(w, h, c, img.m_nLevels));
+
+  for(int level=1; level<img.m_nLevels; level++){
+    const int w2 = std::max(w/2, 1), h2 = std::max(h/2, 1);
+    const size_t dest = src + (size_t)w*h*c;
+    unsigned char* p = img.m_vecPixel.data(); //shorthand
+
+    for(int y=0; y<h2; y++){
+      const int y0 = std::min(2*y, h - 1), y1 = std::min(2*y + 1, h - 1);
+
+      for(int x=0; x<w2; x++){
+        const int x0 = std::min(2*x, w - 1), x1 = std::min(2*x + 1, w - 1);
+
+        for(int k=0; k<c; k++){
+          const unsigned sum = p[src + ((size_t)y0*w + x0)*c + k] +
+            p[src + ((size_t)y0*w + x1)*c + k] +
+            p[src + ((size_t)y1*w + x0)*c + k] +
+            p[src + ((size_t)y1*w + x1)*c + k];
+
+          p[dest + ((size_t)y*w2 + x)*c + k] = (unsigned char)((sum + 2)/4);
+        } //for
+      } //for
+    } //for
+
+    src = dest;
+    w = w2;
+    h = h2;
+  } //for
+} //MakeMipmaps
+
+/// Start loading an image file in the background, unless it has already
+/// been requested.
+/// \param file File name.
+/// \param f Format wanted.
+
+void CImageDecoder::Request(const std::string& file, const CImageFormat& f){
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_mapRequest.count(file) > 0)return;
+    m_mapRequest[file];
+  }
+
+  m_cPool.Push([this, file, f](){
+    CDecodedImage img;
+    Load(file, img, f);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CRequest& r = m_mapRequest[file]; //shorthand
+    r.m_cImage = std::move(img);
+    r.m_bDone = true;
+    m_cvDone.notify_all();
+  });
+} //Request
+
+/// Collect a loaded image file, waiting for it if it was requested and
+/// isn't ready yet, or loading it on the calling thread if it was never
+/// requested. The request is forgotten afterwards, so a second `Get()`
+/// loads the file again.
+/// \param file File name.
+/// \param img [out] Decoded image.
+/// \param f Format wanted if it wasn't requested.
+/// \return true if it loaded.
+
+const bool CImageDecoder::Get(const std::string& file, CDecodedImage& img,
+  const CImageFormat& f)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto it = m_mapRequest.find(file);
+
+  if(it == m_mapRequest.end()){ //not requested
+    lock.unlock();
+    return Load(file, img, f);
+  } //if
+
+  m_cvDone.wait(lock, [&]{return it->second.m_bDone;});
+  img = std::move(it->second.m_cImage);
+  m_mapRequest.erase(it);
+
+  return img.IsValid();
+} //Get
+
+/// Load a batch of image files in parallel, one task per file, and wait for
+/// them all to finish.
+/// \param vecImage Images with their file names filled in. The rest is
+/// filled in by loading.
+/// \param f Format wanted.
+
+void CImageDecoder::Decode(std::vector<CDecodedImage>& vecImage,
+  const CImageFormat& f)
+{
+  for(CDecodedImage& img: vecImage)
+    m_cPool.Push([this, &img, f](){Load(img.m_strFile, img, f);});
+
+  m_cPool.Wait();
+} //Decode
+
+/// Reader function for the number of worker threads.
+/// \return Number of worker threads.
+
+const size_t CImageDecoder::GetNumThreads() const{
+  return m_cPool.GetNumThreads();
+} //GetNumThreads
@@ -0,0 +1,115 @@
+/// \file ImageDecoder.h
+/// \brief Interface for the image decoder CImageDecoder.
+
+#ifndef __L4RC_GAME_IMAGEDECODER_H__
+#define __L4RC_GAME_IMAGEDECODER_H__
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+
+class CMappedFile;
+class CImageCache;
+
+/// \brief Image format.
+///
+/// What a decoded image should look like.
+
+struct CImageFormat{
+  int m_nChannels = 0; ///< Channels per pixel, or 0 for however many the file has.
+  bool m_bPremultiply = false; ///< Multiply color by alpha, for 4 channels.
+  bool m_bMipmaps = false; ///< Follow the image with its mipmaps.
+}; //CImageFormat
+
+/// \brief Decoded image.
+///
+/// The pixels of an image file, 8 bits per channel, row by row from the top,
+/// each mipmap level following the one before. The pixels are either in a
+/// vector of their own or, if they came from the image cache, in a view of
+/// the cache file, so use `GetData()` to get at them.
+
+struct CDecodedImage{
+  std::string m_strFile; ///< File name.
+  int m_nWidth = 0; ///< Width of the top level in pixels.
+  int m_nHeight = 0; ///< Height of the top level in pixels.
+  int m_nChannels = 0; ///< Channels per pixel.
+  int m_nLevels = 0; ///< Number of mipmap levels, including the top one.
+
+  std::vector<unsigned char> m_vecPixel; ///< Pixels, if decoded.
+  std::shared_ptr<CMappedFile> m_pMapping; ///< Cache file, if cached.
+  size_t m_nOffset = 0; ///< Offset of the pixels in the cache file.
+  size_t m_nSize = 0; ///< Size of the pixels in the cache file.
+
+  const bool IsValid() const; ///< Whether it has pixels.
+  const bool IsCached() const; ///< Whether it came from the cache.
+  const unsigned char* GetData() const; ///< Pointer to the pixels.
+  const size_t GetSize() const; ///< Size of the pixels in bytes.
+  const size_t GetLevelOffset(int) const; ///< Offset of a mipmap level.
+
+  static const size_t GetChainSize(int, int, int, int); ///< Size of a mipmap chain.
+}; //CDecodedImage
+
+/// \brief The image decoder.
+///
+/// The image decoder decodes image files with `stb_image` on a thread pool.
+/// There are two ways to use it. `Request()` starts decoding a file in the
+/// background and `Get()` collects the result, decoding it on the spot if it
+/// was never requested, so an image can be decoded while the main thread
+/// gets on with something else. `Decode()` decodes a batch of files in
+/// parallel and waits for them all. Decoding a file is independent of every
+/// other, so the only contention is for the queue and the table of requests.
+/// `stb_image` keeps its failure reason in a global, so the reason given for
+/// a failed decode may belong to another file.
+///
+/// If it is given an image cache, the decoder looks each file up in the
+/// cache by the hash of its contents before decoding it, and puts what it
+/// decodes into the cache, so a file is only decoded once for as long as it
+/// stays the same.
+
+class CImageDecoder{
+  private:
+    /// \brief Request.
+    ///
+    /// An image that has been asked for and whether it is ready yet.
+
+    struct CRequest{
+      bool m_bDone = false; ///< Whether it has been decoded.
+      CDecodedImage m_cImage; ///< The image.
+    }; //CRequest
+
+    std::map<std::string, CRequest> m_mapRequest; ///< Requests by file name.
+    std::mutex m_mutex; ///< Guards the requests.
+    std::condition_variable m_cvDone; ///< Signals a finished request.
+
+    std::unique_ptr<CImageCache> m_pCache; ///< Image cache, if any.
+
+    CThreadPool m_cPool; ///< Worker threads, last so they stop first.
+
+    const bool Load(const std::string&, CDecodedImage&, const CImageFormat&); ///< Load from cache or decode.
+
+    static void Premultiply(CDecodedImage&); ///< Multiply color by alpha.
+    static void MakeMipmaps(CDecodedImage&); ///< Append mipmaps.
+
+  public:
+    CImageDecoder(size_t=0); ///< Constructor.
+    ~CImageDecoder(); ///< Destructor.
+
+    void SetCache(const std::string&); ///< Use an image cache.
+    const CImageCache* GetCache() const; ///< Get the image cache.
+
+    void Request(const std::string&, const CImageFormat& = CImageFormat()); ///< Start decoding a file.
+    const bool Get(const std::string&, CDecodedImage&, const CImageFormat& = CImageFormat()); ///< Collect a decoded file.
+    void Decode(std::vector<CDecodedImage>&, const CImageFormat& = CImageFormat()); ///< Decode a batch in parallel.
+
+    const size_t GetNumThreads() const; ///< Number of worker threads.
+
+    static const bool DecodeFile(const std::string&, CDecodedImage&, const CImageFormat& = CImageFormat()); ///< Decode a file now.
+    static const bool DecodeMemory(const unsigned char*, size_t, CDecodedImage&, const CImageFormat&); ///< Decode a file in memory.
+}; //CImageDecoder
+
+#endif //__L4RC_GAME_IMAGEDECODER_H__
@@ -0,0 +1,337 @@
+/// \file LightGrid.cpp
+/// \brief Code for the tile light grid CLightGrid.
+
+#include "LightGrid.h"
+
+static const BYTE OPAQUE_FLAG = 1; ///< Tile blocks light.
+static const BYTE CHANGED_FLAG = 2; ///< Tile is in the changed list.
+static const BYTE TOUCHED_FLAG = 4; ///< Tile is in the touched list.
+
+/// Fit the grid to a map, with walls blocking light, and remove every light
+/// source, leaving the map dark. Every tile counts as changed.
+/// \param map The map, row by row from the top.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+/// \param t Tile width and height.
+
+void CLightGrid::Resize(char** map, size_t w, size_t h, float t){
+  m_nWidth = (UINT)w;
+  m_nHeight = (UINT)h;
+  m_fTileSize = t;
+
+  const size_t n = w*h; //number of tiles
+
+  m_vecLevel.assign(n, 0);
+  m_vecEmit.assign(n, 0);
+  m_vecEmitScratch.assign(n, 0);
+  m_vecFlags.assign(n, CHANGED_FLAG);
+  m_vecChanged.resize(n);
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++){
+      const size_t k = i*w + j; //tile index
+      m_vecChanged[k] = (UINT)k;
+      if(map[i][j] == 'W')m_vecFlags[k] |= OPAQUE_FLAG;
+    } //for
+
+  m_vecTouched.clear();
+  m_vecSource.clear();
+  m_vecFree.clear();
+  m_nVisited = 0;
+} //Resize
+
+/// Get the tile under a point.
+/// \param p Point in world space.
+/// \return Tile index, or `UINT_MAX` if the point is off the map.
+
+const UINT CLightGrid::GetTile(const Vector2& p) const{
+  const float x = floorf(p.x/m_fTileSize); //column
+  const float y = floorf(p.y/m_fTileSize); //row from the bottom
+
+  if(x < 0.0f || y < 0.0f || x >= m_nWidth || y >= m_nHeight)
+    return UINT_MAX;
+
+  return (m_nHeight - 1 - (UINT)y)*m_nWidth + (UINT)x;
+} //GetTile
+
+/// Visit the tiles next to a tile, up, down, left, and right, that aren't
+/// walls.
+/// \param k Tile index.
+/// \param f Function to call with the index of each neighbor.
+
+template<class t> void CLightGrid::ForEachNeighbor(UINT k, t f) const{
+  const UINT j = k%m_nWidth; //column
+
+  auto visit = [&](UINT n){
+    if(!(m_vecFlags[n] & OPAQUE_FLAG))f(n);
+  }; //visit
+
+  if(j > 0)visit(k - 1);
+  if(j + 1 < m_nWidth)visit(k + 1);
+  if(k >= m_nWidth)visit(k - m_nWidth);
+  if(k + m_nWidth < m_vecLevel.size())visit(k + m_nWidth);
+} //ForEachNeighbor
+
+/// Note that the sources in a tile have changed, so that its emission is
+/// worked out again on the next update.
+/// \param k Tile index, or `UINT_MAX` for none.
+
+void CLightGrid::Touch(UINT k){
+  if(k == UINT_MAX || (m_vecFlags[k] & TOUCHED_FLAG))return;
+  m_vecFlags[k] |= TOUCHED_FLAG;
+  m_vecTouched.push_back(k);
+} //Touch
+
+/// Note that the level shown for a tile may have changed. That goes for the
+/// walls next to it too, since they are shown by their brightest neighbor.
+/// \param k Tile index.
+
+void CLightGrid::MarkChanged(UINT k){
+  auto mark = [&](UINT n){
+    if(m_vecFlags[n] & CHANGED_FLAG)return;
+    m_vecFlags[n] |= CHANGED_FLAG;
+    m_vecChanged.push_back(n);
+  }; //mark
+
+  mark(k);
+
+  const UINT j = k%m_nWidth; //column
+
+  auto markWall = [&](UINT n){
+    if(m_vecFlags[n] & OPAQUE_FLAG)mark(n);
+  }; //markWall
+
+  if(j > 0)markWall(k - 1);
+  if(j + 1 < m_nWidth)markWall(k + 1);
+  if(k >= m_nWidth)markWall(k - m_nWidth);
+  if(k + m_nWidth < m_vecLevel.size())markWall(k + m_nWidth);
+} //MarkChanged
+
+/// Add a light source. Sources in a wall give no light.
+/// \param p Position in world space.
+/// \param level Light level, clamped to `LIGHT_MAX`.
+/// \param life Seconds until it removes itself, or 0 to last until removed.
+/// Don't keep the index of a source that removes itself.
+/// \return Source index.
+
+const UINT CLightGrid::Add(const Vector2& p, UINT level, float life){
+  UINT i = (UINT)m_vecSource.size(); //source index
+
+  if(m_vecFree.empty())
+    m_vecSource.push_back(CSource());
+
+  else{
+    i = m_vecFree.back();
+    m_vecFree.pop_back();
+  } //else
+
+  CSource& s = m_vecSource[i]; //shorthand
+  s.m_nTile = GetTile(p);
+  s.m_nLevel = (BYTE)std::max(1U, std::min(level, LIGHT_MAX));
+  s.m_fLifeTime = life;
+
+  Touch(s.m_nTile);
+  return i;
+} //Add
+
+/// Move a light source. It only costs anything if it moves to another tile.
+/// \param i Source index.
+/// \param p New position in world space.
+
+void CLightGrid::Move(UINT i, const Vector2& p){
+  CSource& s = m_vecSource[i]; //shorthand
+  const UINT k = GetTile(p);
+  if(k == s.m_nTile)return;
+
+  Touch(s.m_nTile);
+  Touch(k);
+  s.m_nTile = k;
+} //Move
+
+/// Remove a light source.
+/// \param i Source index.
+
+void CLightGrid::Remove(UINT i){
+  CSource& s = m_vecSource[i]; //shorthand
+  if(s.m_nLevel == 0)return; //already free
+
+  Touch(s.m_nTile);
+  s = CSource();
+  m_vecFree.push_back(i);
+} //Remove
+
+/// Give a tile whose sources have changed its new emission, and queue the
+/// tile for the addition pass if it got brighter than it was lit, or for the
+/// removal pass if it got dimmer and its light was its own.
+/// \param k Tile index.
+/// \param e New emission, the level of the brightest source in the tile.
+
+void CLightGrid::UpdateEmission(UINT k, BYTE e){
+  m_vecFlags[k] &= ~TOUCHED_FLAG;
+  if(m_vecFlags[k] & OPAQUE_FLAG)e = 0; //walls give no light
+
+  const BYTE old = m_vecEmit[k]; //old emission
+  if(e == old)return;
+  m_vecEmit[k] = e;
+
+  BYTE& level = m_vecLevel[k]; //shorthand
+
+  if(e > level){ //brighter
+    level = e;
+    MarkChanged(k);
+    m_vecAddQueue.push_back(k);
+  } //if
+
+  else if(e < old && level == old){ //dimmer, and the light here was its own
+    CRemoval r;
+    r.m_nTile = k;
+    r.m_nLevel = level;
+    m_vecRemoveQueue.push_back(r);
+
+    level = e; //0, or its own light if it still has a source
+    MarkChanged(k);
+    if(e > 0)m_vecAddQueue.push_back(k);
+  } //else if
+} //UpdateEmission
+
+/// Darken the tiles reached from the removal queue, breadth-first. A
+/// neighbor dimmer than the tile that it was reached from could have been
+/// lit from there, so it is darkened and queued in turn, unless it has a
+/// source of its own, in which case it gets that source's level back and is
+/// queued for the addition pass. A neighbor at least as bright was lit from
+/// elsewhere, so it is queued for the addition pass to spread its light
+/// back into the darkened tiles.
+
+void CLightGrid::PropagateRemoval(){
+  for(size_t head=0; head<m_vecRemoveQueue.size(); head++){
+    const CRemoval r = m_vecRemoveQueue[head];
+    m_nVisited++;
+
+    ForEachNeighbor(r.m_nTile, [&](UINT n){
+      BYTE& level = m_vecLevel[n]; //shorthand
+      if(level == 0)return;
+
+      if(level < r.m_nLevel){
+        CRemoval next;
+        next.m_nTile = n;
+        next.m_nLevel = level;
+        m_vecRemoveQueue.push_back(next);
+
+        level = m_vecEmit[n];
+        MarkChanged(n);
+        if(level > 0)m_vecAddQueue.push_back(n);
+      } //if
+
+      else m_vecAddQueue.push_back(n);
+    }); //ForEachNeighbor
+  } //for
+
+  m_vecRemoveQueue.clear();
+} //PropagateRemoval
+
+/// Spread light from the tiles in the addition queue, breadth-first, to
+/// every neighbor that it makes brighter.
+
+void CLightGrid::PropagateAddition(){
+  for(size_t head=0; head<m_vecAddQueue.size(); head++){
+    const UINT k = m_vecAddQueue[head];
+    const BYTE level = m_vecLevel[k];
+    m_nVisited++;
+
+    if(level <= 1)continue; //too dim to spread
+
+    ForEachNeighbor(k, [&](UINT n){
+      if(m_vecLevel[n] + 1 >= level)return;
+      m_vecLevel[n] = level - 1;
+      MarkChanged(n);
+      m_vecAddQueue.push_back(n);
+    }); //ForEachNeighbor
+  } //for
+
+  m_vecAddQueue.clear();
+} //PropagateAddition
+
+/// Remove the sources whose time is up, then bring the light levels up to
+/// date with every change to the sources since the last update, removal
+/// first so that the addition pass refills what it darkened. The new
+/// emission of every touched tile is found in a single pass over the
+/// sources, so moving many sources at once costs no more than the sources
+/// and the touched tiles.
+/// \param dt Frame time in seconds.
+
+void CLightGrid::Update(float dt){
+  m_nVisited = 0;
+
+  for(UINT i=0; i<(UINT)m_vecSource.size(); i++){
+    CSource& s = m_vecSource[i]; //shorthand
+    if(s.m_nLevel == 0 || s.m_fLifeTime <= 0.0f)continue;
+
+    s.m_fLifeTime -= dt;
+    if(s.m_fLifeTime <= 0.0f)Remove(i);
+  } //for
+
+  for(UINT k: m_vecTouched)
+    m_vecEmitScratch[k] = 0;
+
+  for(const CSource& s: m_vecSource)
+    if(s.m_nTile != UINT_MAX && (m_vecFlags[s.m_nTile] & TOUCHED_FLAG))
+      m_vecEmitScratch[s.m_nTile] = std::max(m_vecEmitScratch[s.m_nTile], s.m_nLevel);
+
+  for(UINT k: m_vecTouched)
+    UpdateEmission(k, m_vecEmitScratch[k]);
+
+  m_vecTouched.clear();
+
+  PropagateRemoval();
+  PropagateAddition();
+} //Update
+
+/// Reader function for the light level that a tile is shown at. For a
+/// floor tile, that is its light level. For a wall, it is the level of the
+/// brightest floor tile next to it, less one.
+/// \param k Tile index, row by row from the top.
+/// \return Light level.
+
+const UINT CLightGrid::GetLevel(UINT k) const{
+  if(!(m_vecFlags[k] & OPAQUE_FLAG))
+    return m_vecLevel[k];
+
+  UINT level = 0;
+
+  ForEachNeighbor(k, [&](UINT n){
+    level = std::max(level, (UINT)m_vecLevel[n]);});
+
+  return level > 0? level - 1: 0;
+} //GetLevel
+
+/// Reader function for the tiles whose shown level may have changed since
+/// the list was last cleared. Each is listed once.
+/// \return Tile indices.
+
+const std::vector<UINT>& CLightGrid::GetChanged() const{
+  return m_vecChanged;
+} //GetChanged
+
+/// Forget the changed tiles, once they have been dealt with.
+
+void CLightGrid::ClearChanged(){
+  for(UINT k: m_vecChanged)
+    m_vecFlags[k] &= ~CHANGED_FLAG;
+
+  m_vecChanged.clear();
+} //ClearChanged
+
+/// Reader function for the number of light sources.
+/// \return Number of light sources.
+
+const size_t CLightGrid::GetNumSources() const{
+  return m_vecSource.size() - m_vecFree.size();
+} //GetNumSources
+
+/// Reader function for the number of tiles visited by the last update,
+/// which is what it cost.
+/// \return Number of tile visits.
+
+const size_t CLightGrid::GetNumVisited() const{
+  return m_nVisited;
+} //GetNumVisited
@@ -0,0 +1,101 @@
+/// \file LightGrid.h
+/// \brief Interface for the tile light grid CLightGrid.
+
+#ifndef __L4RC_GAME_LIGHTGRID_H__
+#define __L4RC_GAME_LIGHTGRID_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+
+/// \brief The light grid.
+///
+/// The light grid holds a light level from 0 to `LIGHT_MAX` for each tile of
+/// the map. A light source gives its own tile its level, and light spreads
+/// from tile to tile across floors, one level dimmer per step, with walls
+/// blocking it, so a level-8 fireball lights the floor up to 7 steps
+/// away, around corners too. A tile's level is the brightest
+/// that reaches it from any source.
+///
+/// Sources are added, moved, and removed at will, but nothing is lit until
+/// `Update()`, which handles all of the changes since the last one in two
+/// breadth-first passes, as voxel engines do. The removal pass starts at
+/// each tile whose source got dimmer and darkens the tiles that could only
+/// have been lit from there, collecting the brighter tiles at the edge of
+/// the darkened region. The addition pass then spreads light from those edge
+/// tiles and from each tile whose source got brighter. Only the tiles whose
+/// level could change are visited, and a source is only changed when it
+/// moves to another tile, so a fireball costs a few hundred tile visits per
+/// tile that it crosses, however big the map is. Each tile whose level
+/// changes is recorded once so that the tile manager can retint just those
+/// tiles.
+///
+/// Walls are never lit themselves, but a wall is shown as bright as the
+/// brightest floor next to it, less a level, so that walls facing a light
+/// are lit.
+
+class CLightGrid{
+  private:
+    /// \brief Light source.
+    ///
+    /// A light source, or a free slot if it has no level.
+
+    struct CSource{
+      UINT m_nTile = UINT_MAX; ///< Tile index, `UINT_MAX` if off the map.
+      BYTE m_nLevel = 0; ///< Light level, 0 if the slot is free.
+      float m_fLifeTime = 0.0f; ///< Seconds left, 0 to last until removed.
+    }; //CSource
+
+    /// \brief Removal.
+    ///
+    /// A tile in the removal queue and the level that it had.
+
+    struct CRemoval{
+      UINT m_nTile = 0; ///< Tile index.
+      BYTE m_nLevel = 0; ///< Level before it was darkened.
+    }; //CRemoval
+
+    UINT m_nWidth = 0; ///< Number of tiles wide.
+    UINT m_nHeight = 0; ///< Number of tiles high.
+    float m_fTileSize = 1.0f; ///< Tile width and height.
+
+    std::vector<BYTE> m_vecLevel; ///< Light level of each tile.
+    std::vector<BYTE> m_vecEmit; ///< Brightest source level in each tile.
+    std::vector<BYTE> m_vecEmitScratch; ///< New emission of touched tiles.
+    std::vector<BYTE> m_vecFlags; ///< Bits for opaque, changed, and source moved.
+    std::vector<UINT> m_vecChanged; ///< Tiles whose shown level may have changed.
+    std::vector<UINT> m_vecTouched; ///< Tiles whose sources changed.
+
+    std::vector<CSource> m_vecSource; ///< Light sources.
+    std::vector<UINT> m_vecFree; ///< Free source slots.
+
+    std::vector<CRemoval> m_vecRemoveQueue; ///< Removal pass queue.
+    std::vector<UINT> m_vecAddQueue; ///< Addition pass queue.
+    size_t m_nVisited = 0; ///< Tiles visited by the last update.
+
+    const UINT GetTile(const Vector2&) const; ///< Tile under a point.
+    void Touch(UINT); ///< Note that a tile's sources changed.
+    void MarkChanged(UINT); ///< Note that a tile's shown level changed.
+    void UpdateEmission(UINT, BYTE); ///< Apply a tile's source change.
+    void PropagateRemoval(); ///< Darken from the removal queue.
+    void PropagateAddition(); ///< Spread light from the addition queue.
+    template<class t> void ForEachNeighbor(UINT, t) const; ///< Visit the floor tiles next to a tile.
+
+  public:
+    void Resize(char**, size_t, size_t, float); ///< Fit to a map and darken it.
+
+    const UINT Add(const Vector2&, UINT, float=0.0f); ///< Add a light source.
+    void Move(UINT, const Vector2&); ///< Move a light source.
+    void Remove(UINT); ///< Remove a light source.
+
+    void Update(float); ///< Expire sources and spread light.
+
+    const UINT GetLevel(UINT) const; ///< Shown light level of a tile.
+    const std::vector<UINT>& GetChanged() const; ///< Tiles changed since cleared.
+    void ClearChanged(); ///< Forget the changed tiles.
+
+    const size_t GetNumSources() const; ///< Number of light sources.
+    const size_t GetNumVisited() const; ///< Tiles visited by the last update.
+}; //CLightGrid
+
+#endif //__L4RC_GAME_LIGHTGRID_H__
@@ -0,0 +1,237 @@
+/// \file Log.cpp
+/// \brief Code for the logger CLog.
+
+#include <chrono>
+#include <cstdio>
+
+#include "Log.h"
+
+static_assert((LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) == 0,
+  "LOG_BUFFER_SIZE must be a power of 2");
+
+std::unique_ptr<CLog::CSlot[]> CLog::m_pSlot;
+std::atomic<size_t> CLog::m_nHead(0);
+size_t CLog::m_nTail = 0;
+std::atomic<size_t> CLog::m_nDropped(0);
+std::atomic<bool> CLog::m_bRunning(false);
+std::thread CLog::m_cThread;
+long long CLog::m_nStartTime = 0;
+
+/// Read the clock used for time stamps.
+/// \return Clock ticks.
+
+static long long GetTicks(){
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+} //GetTicks
+
+/// Allocate the ring buffer and start the logging thread. Each slot starts
+/// out with its own index as its sequence number, which marks it as free for
+/// the writer whose turn it is. Does nothing if already started.
+
+void CLog::Start(){
+  if(m_bRunning)return;
+
+  m_pSlot.reset(new CSlot[LOG_BUFFER_SIZE]);
+
+  for(size_t i=0; i<LOG_BUFFER_SIZE; i++)
+    m_pSlot[i].m_nSeq.store(i, std::memory_order_relaxed);
+
+  m_nHead.store(0, std::memory_order_relaxed);
+  m_nTail = 0;
+  m_nDropped.store(0, std::memory_order_relaxed);
+  m_nStartTime = GetTicks();
+
+  m_bRunning = true;
+  m_cThread = std::thread(Run);
+} //Start
+
+/// Stop the logging thread, write out whatever it left behind, and free the
+/// ring buffer. No other thread may be logging by this time.
+
+void CLog::Stop(){
+  if(!m_bRunning)return;
+
+  m_bRunning = false;
+  m_cThread.join();
+  Drain();
+
+  const size_t n = m_nDropped.load(std::memory_order_relaxed);
+  if(n > 0)printf("Log: %zu records dropped\n", n);
+  fflush(stdout);
+
+  m_pSlot.reset();
+} //Stop
+
+/// Claim the next slot in the ring buffer and fill in the record header. A
+/// slot is free for the writer whose turn it is when its sequence number
+/// equals the write position. If the slot's sequence number is behind, the
+/// logging thread hasn't read it yet and the buffer is full, so the record
+/// is dropped. If it is ahead, another writer got there first, so try again
+/// at the new write position.
+/// \param level Log level.
+/// \param category Log category.
+/// \param msg Message.
+/// \return Pointer to the slot, or `nullptr` if the record is to be dropped.
+
+CLog::CSlot* CLog::Claim(eLogLevel level, eLogCategory category, const char* msg){
+  if(m_pSlot == nullptr)return nullptr; //not started
+
+  size_t pos = m_nHead.load(std::memory_order_relaxed);
+  CSlot* pSlot = nullptr;
+
+  for(;;){
+    pSlot = &m_pSlot[pos & (LOG_BUFFER_SIZE - 1)];
+    const size_t seq = pSlot->m_nSeq.load(std::memory_order_acquire);
+    const ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+
+    if(diff == 0){ //our turn
+      if(m_nHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } //if
+
+    else if(diff < 0){ //full
+      m_nDropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } //else if
+
+    else pos = m_nHead.load(std::memory_order_relaxed); //lost the race
+  } //for
+
+  CLogRecord& r = pSlot->m_cRecord; //shorthand
+  r.m_nTime = GetTicks();
+  r.m_eLevel = level;
+  r.m_eCategory = category;
+  r.m_nFields = 0;
+  r.m_pMessage = msg;
+
+  return pSlot;
+} //Claim
+
+/// Hand a filled slot over to the logging thread by setting its sequence
+/// number to one past the position that it was claimed at.
+/// \param pSlot Pointer to a slot returned by `Claim()`.
+
+void CLog::Publish(CSlot* pSlot){
+  const size_t pos = pSlot->m_nSeq.load(std::memory_order_relaxed);
+  pSlot->m_nSeq.store(pos + 1, std::memory_order_release);
+} //Publish
+
+/// Write out every published record in order, stopping at the first slot
+/// that hasn't been published yet. Each slot is freed for the writer that
+/// will come around to it on the next lap of the ring.
+/// \return Number of records written out.
+
+const size_t CLog::Drain(){
+  size_t n = 0; //number of records written out
+
+  for(;;){
+    CSlot& slot = m_pSlot[m_nTail & (LOG_BUFFER_SIZE - 1)];
+    if(slot.m_nSeq.load(std::memory_order_acquire) != m_nTail + 1)break;
+
+    Print(slot.m_cRecord);
+    slot.m_nSeq.store(m_nTail + LOG_BUFFER_SIZE, std::memory_order_release);
+    m_nTail++; n++;
+  } //for
+
+  if(n > 0)fflush(stdout);
+  return n;
+} //Drain
+
+/// Logging thread function. Drain the ring buffer for as long as the logger
+/// is running, napping for a millisecond whenever there is nothing to do.
+
+void CLog::Run(){
+  while(m_bRunning)
+    if(Drain() == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+} //Run
+
+/// Write out one record as a single line to standard output, so use the
+/// debug console to see it. The line has the time in seconds since
+/// `Start()`, the level, the category, the message, and then each field as
+/// `key=value`.
+/// \param r Log record.
+
+void CLog::Print(const CLogRecord& r){
+  static const char* level[] = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR"};
+  static const char* category[] = {"general", "objects", "collision",
+    "render", "audio", "level"};
+
+  static_assert(sizeof(level)/sizeof(level[0]) == (UINT)eLogLevel::Off,
+    "level names out of step with eLogLevel");
+  static_assert(sizeof(category)/sizeof(category[0]) == (UINT)eLogCategory::Size,
+    "category names out of step with eLogCategory");
+
+  const double t = std::chrono::duration<double>(
+    std::chrono::steady_clock::duration(r.m_nTime - m_nStartTime)).count();
+
+  char buffer[512]; //line being built
+  int n = snprintf(buffer, sizeof(buffer), "%10.6f %s %-9s %s", t,
+    level[(UINT)r.m_eLevel], category[(UINT)r.m_eCategory], r.m_pMessage);
+
+  for(UINT i=0; i<r.m_nFields && n < (int)sizeof(buffer); i++){
+    const CLogField& f = r.m_cField[i]; //shorthand
+    char* p = buffer + n; //end of line so far
+    const size_t m = sizeof(buffer) - n; //space left
+
+    switch(f.m_eType){
+      case CLogField::eType::Int:   n += snprintf(p, m, " %s=%lld", f.m_pKey, f.m_nInt); break;
+      case CLogField::eType::Uint:  n += snprintf(p, m, " %s=%llu", f.m_pKey, f.m_nUint); break;
+      case CLogField::eType::Float: n += snprintf(p, m, " %s=%g", f.m_pKey, f.m_fFloat); break;
+      case CLogField::eType::Bool:  n += snprintf(p, m, " %s=%s", f.m_pKey, f.m_bBool? "true": "false"); break;
+      case CLogField::eType::Ptr:   n += snprintf(p, m, " %s=%p", f.m_pKey, f.m_pPtr); break;
+      case CLogField::eType::Str:   n += snprintf(p, m, " %s=\"%s\"", f.m_pKey, f.m_pStr); break;
+    } //switch
+  } //for
+
+  puts(buffer);
+} //Print
+
+/// Stop the recursion that fills in the fields of a record.
+
+void CLog::SetFields(CLogRecord&){
+} //SetFields
+
+/// Set a Boolean value.
+/// \param f Log field.
+/// \param b Value.
+
+void CLog::SetValue(CLogField& f, bool b){
+  f.m_eType = CLogField::eType::Bool;
+  f.m_bBool = b;
+} //SetValue
+
+/// Set a floating point value.
+/// \param f Log field.
+/// \param x Value.
+
+void CLog::SetValue(CLogField& f, double x){
+  f.m_eType = CLogField::eType::Float;
+  f.m_fFloat = x;
+} //SetValue
+
+/// Set a string literal value.
+/// \param f Log field.
+/// \param s Value.
+
+void CLog::SetValue(CLogField& f, const char* s){
+  f.m_eType = CLogField::eType::Str;
+  f.m_pStr = s;
+} //SetValue
+
+/// Set a pointer value.
+/// \param f Log field.
+/// \param p Value.
+
+void CLog::SetValue(CLogField& f, const void* p){
+  f.m_eType = CLogField::eType::Ptr;
+  f.m_pPtr = p;
+} //SetValue
+
+/// Reader function for the number of records dropped because the ring
+/// buffer was full.
+/// \return Number of records dropped.
+
+const size_t CLog::GetNumDropped(){
+  return m_nDropped.load(std::memory_order_relaxed);
+} //GetNumDropped
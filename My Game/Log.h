@@ -0,0 +1,185 @@
+/// \file Log.h
+/// \brief Interface for the logger CLog and the `LOG` macro.
+
+#ifndef __L4RC_GAME_LOG_H__
+#define __L4RC_GAME_LOG_H__
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "GameDefines.h"
+
+/// Determine whether log messages of a given level and category are compiled
+/// in. This is evaluated at compile time, so the compiler throws away any log
+/// call that fails it along with the evaluation of its arguments.
+/// \param level Log level.
+/// \param category Log category.
+/// \return true if messages of this level and category are logged.
+
+constexpr bool LogEnabled(eLogLevel level, eLogCategory category){
+  return level >= LOG_LEVEL && level != eLogLevel::Off &&
+    ((LOG_CATEGORIES >> (UINT)category) & 1) != 0;
+} //LogEnabled
+
+/// Log a message with up to `LOG_MAX_FIELDS` key-value fields, for example
+/// `LOG(Debug, Objects, "spawn", "kind", n, "x", v.x)`. The level and
+/// category are given without their enumerated type names. The message and
+/// the keys must be string literals, since only pointers to them are kept
+/// until the record is written out. Values may be integers, floating point
+/// numbers, Booleans, pointers, or string literals.
+
+#define LOG(level, category, ...) \
+  do{ \
+    if(LogEnabled(eLogLevel::level, eLogCategory::category)) \
+      CLog::Write(eLogLevel::level, eLogCategory::category, __VA_ARGS__); \
+  }while(0)
+
+/// \brief Log field.
+///
+/// A key-value pair in a log record. The value is kept in its binary form,
+/// which is only turned into text by the logging thread.
+
+struct CLogField{
+  /// \brief Type of the value.
+  enum class eType: BYTE{Int, Uint, Float, Bool, Ptr, Str};
+
+  const char* m_pKey; ///< Key, a string literal.
+  eType m_eType; ///< Type of the value.
+
+  union{
+    long long m_nInt; ///< Signed integer value.
+    unsigned long long m_nUint; ///< Unsigned integer value.
+    double m_fFloat; ///< Floating point value.
+    bool m_bBool; ///< Boolean value.
+    const void* m_pPtr; ///< Pointer value.
+    const char* m_pStr; ///< String literal value.
+  }; //union
+}; //CLogField
+
+/// \brief Log record.
+///
+/// Everything needed to write out a log message later on another thread.
+
+struct CLogRecord{
+  long long m_nTime; ///< Time stamp in clock ticks.
+  eLogLevel m_eLevel; ///< Level.
+  eLogCategory m_eCategory; ///< Category.
+  BYTE m_nFields; ///< Number of fields used.
+  const char* m_pMessage; ///< Message, a string literal.
+  CLogField m_cField[LOG_MAX_FIELDS]; ///< Key-value fields.
+}; //CLogRecord
+
+/// \brief The logger.
+///
+/// The logger keeps log records in a fixed-size ring buffer that any thread
+/// can write into without taking a lock. A background thread drains it and
+/// does the formatting and the output, so a log call on the game thread only
+/// costs a clock read, a compare-and-swap, and a copy of a few dozen bytes.
+/// If the buffer fills up, new records are dropped and counted rather than
+/// making the game thread wait. Nothing is logged until `Start()` is called.
+
+class CLog{
+  private:
+    /// \brief Ring buffer slot.
+    struct CSlot{
+      std::atomic<size_t> m_nSeq; ///< Sequence number, says who may use the slot.
+      CLogRecord m_cRecord; ///< The record.
+    }; //CSlot
+
+    static std::unique_ptr<CSlot[]> m_pSlot; ///< Ring buffer.
+    static std::atomic<size_t> m_nHead; ///< Next slot to write.
+    static size_t m_nTail; ///< Next slot to read, used only by the logging thread.
+    static std::atomic<size_t> m_nDropped; ///< Records dropped because the buffer was full.
+    static std::atomic<bool> m_bRunning; ///< Whether the logging thread should keep going.
+    static std::thread m_cThread; ///< Logging thread.
+    static long long m_nStartTime; ///< Clock ticks at `Start()`.
+
+    static CSlot* Claim(eLogLevel, eLogCategory, const char*); ///< Claim a slot.
+    static void Publish(CSlot*); ///< Hand a slot to the logging thread.
+    static const size_t Drain(); ///< Write out waiting records.
+    static void Run(); ///< Logging thread function.
+    static void Print(const CLogRecord&); ///< Write out one record.
+
+    static void SetFields(CLogRecord&); ///< Stop recursion.
+    template<class t, class... rest> static void SetFields(CLogRecord&,
+      const char*, t, rest...); ///< Fill in fields.
+
+    static void SetValue(CLogField&, bool); ///< Set Boolean value.
+    static void SetValue(CLogField&, double); ///< Set floating point value.
+    static void SetValue(CLogField&, const char*); ///< Set string literal value.
+    static void SetValue(CLogField&, const void*); ///< Set pointer value.
+    template<class t> static typename std::enable_if<std::is_integral<t>::value &&
+      std::is_signed<t>::value>::type SetValue(CLogField&, t); ///< Set signed value.
+    template<class t> static typename std::enable_if<std::is_integral<t>::value &&
+      std::is_unsigned<t>::value>::type SetValue(CLogField&, t); ///< Set unsigned value.
+
+  public:
+    static void Start(); ///< Start the logging thread.
+    static void Stop(); ///< Write out everything and stop the logging thread.
+
+    template<class... args> static void Write(eLogLevel, eLogCategory,
+      const char*, args...); ///< Log a message.
+
+    static const size_t GetNumDropped(); ///< Number of records dropped.
+}; //CLog
+
+/// Log a message. Use the `LOG` macro instead of calling this directly, so
+/// that calls for levels and categories that aren't compiled in disappear.
+/// \param level Log level.
+/// \param category Log category.
+/// \param msg Message, a string literal.
+/// \param a Alternating keys and values.
+
+template<class... args> void CLog::Write(eLogLevel level,
+  eLogCategory category, const char* msg, args... a)
+{
+  static_assert(sizeof...(args)%2 == 0, "log fields must be key-value pairs");
+  static_assert(sizeof...(args) <= 2*LOG_MAX_FIELDS, "too many log fields");
+
+  CSlot* pSlot = Claim(level, category, msg);
+  if(pSlot == nullptr)return; //not started or buffer full
+
+  SetFields(pSlot->m_cRecord, a...);
+  Publish(pSlot);
+} //Write
+
+/// Fill in the next field of a record and recurse on the rest.
+/// \param r Log record.
+/// \param key Key, a string literal.
+/// \param value Value.
+/// \param more The remaining keys and values.
+
+template<class t, class... rest> void CLog::SetFields(CLogRecord& r,
+  const char* key, t value, rest... more)
+{
+  CLogField& f = r.m_cField[r.m_nFields++];
+  f.m_pKey = key;
+  SetValue(f, value);
+  SetFields(r, more...);
+} //SetFields
+
+/// Set a signed integer value.
+/// \param f Log field.
+/// \param n Value.
+
+template<class t> typename std::enable_if<std::is_integral<t>::value &&
+  std::is_signed<t>::value>::type CLog::SetValue(CLogField& f, t n)
+{
+  f.m_eType = CLogField::eType::Int;
+  f.m_nInt = (long long)n;
+} //SetValue
+
+/// Set an unsigned integer value.
+/// \param f Log field.
+/// \param n Value.
+
+template<class t> typename std::enable_if<std::is_integral<t>::value &&
+  std::is_unsigned<t>::value>::type CLog::SetValue(CLogField& f, t n)
+{
+  f.m_eType = CLogField::eType::Uint;
+  f.m_nUint = (unsigned long long)n;
+} //SetValue
+
+#endif //__L4RC_GAME_LOG_H__
@@ -0,0 +1,114 @@
+/// \file MappedFile.cpp
+/// \brief Code for the memory-mapped file CMappedFile.
+
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif //WIN32_LEAN_AND_MEAN
+
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif //_WIN32
+
+#include "MappedFile.h"
+
+/// Unmap the file.
+
+CMappedFile::~CMappedFile(){
+  Close();
+} //destructor
+
+/// Map a whole file into memory for reading, unmapping any file mapped
+/// before. An empty file can't be mapped.
+/// \param name File name.
+/// \return true if it was mapped.
+
+const bool CMappedFile::Open(const std::string& name){
+  Close();
+
+  #ifdef _WIN32
+    m_hFile = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if(m_hFile == INVALID_HANDLE_VALUE){
+      m_hFile = nullptr;
+      return false;
+    } //if
+
+    LARGE_INTEGER size;
+
+    if(!GetFileSizeEx(m_hFile, &size) || size.QuadPart == 0){
+      Close();
+      return false;
+    } //if
+
+    m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if(m_hMapping != nullptr)
+      m_pData = (const unsigned char*)MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+
+    if(m_pData == nullptr){
+      Close();
+      return false;
+    } //if
+
+    m_nSize = (size_t)size.QuadPart;
+  #else
+    const int fd = open(name.c_str(), O_RDONLY);
+    if(fd < 0)return false;
+
+    struct stat st;
+
+    if(fstat(fd, &st) == 0 && st.st_size > 0){
+      void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if(p != MAP_FAILED){
+        m_pData = (const unsigned char*)p;
+        m_nSize = (size_t)st.st_size;
+      } //if
+    } //if
+
+    close(fd); //the mapping keeps the file open
+
+    if(m_pData == nullptr)
+      return false;
+  #endif //_WIN32
+
+  return true;
+} //Open
+
+/// Unmap the file and close it. Does nothing if no file is mapped.
+
+void CMappedFile::Close(){
+  #ifdef _WIN32
+    if(m_pData != nullptr)UnmapViewOfFile(m_pData);
+    if(m_hMapping != nullptr)CloseHandle(m_hMapping);
+    if(m_hFile != nullptr)CloseHandle(m_hFile);
+
+    m_hMapping = m_hFile = nullptr;
+  #else
+    if(m_pData != nullptr)
+      munmap((void*)m_pData, m_nSize);
+  #endif //_WIN32
+
+  m_pData = nullptr;
+  m_nSize = 0;
+} //Close
+
+/// Reader function for the start of the view.
+/// \return Pointer to the first byte of the file, or `nullptr` if none.
+
+const unsigned char* CMappedFile::GetData() const{
+  return m_pData;
+} //GetData
+
+/// Reader function for the size of the file.
+/// \return Size in bytes.
+
+const size_t CMappedFile::GetSize() const{
+  return m_nSize;
+} //GetSize
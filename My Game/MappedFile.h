@@ -0,0 +1,40 @@
+/// \file MappedFile.h
+/// \brief Interface for the memory-mapped file CMappedFile.
+
+#ifndef __L4RC_GAME_MAPPEDFILE_H__
+#define __L4RC_GAME_MAPPEDFILE_H__
+
+#include <string>
+
+/// \brief Memory-mapped file.
+///
+/// A read-only view of a whole file in memory. The operating system pages
+/// the file in as it is read, straight from its file cache, so there is no
+/// copy and nothing is read that isn't touched. The view lasts as long as
+/// the object does.
+
+class CMappedFile{
+  private:
+    const unsigned char* m_pData = nullptr; ///< Start of the view.
+    size_t m_nSize = 0; ///< Size of the file in bytes.
+
+    #ifdef _WIN32
+      void* m_hFile = nullptr; ///< File handle.
+      void* m_hMapping = nullptr; ///< File mapping handle.
+    #endif //_WIN32
+
+    void Close(); ///< Unmap and close the file.
+
+  public:
+    CMappedFile() = default; ///< Default constructor.
+    CMappedFile(const CMappedFile&) = delete; ///< No copying.
+    CMappedFile& operator=(const CMappedFile&) = delete; ///< No copying.
+    ~CMappedFile(); ///< Destructor.
+
+    const bool Open(const std::string&); ///< Map a file.
+
+    const unsigned char* GetData() const; ///< Start of the view.
+    const size_t GetSize() const; ///< Size of the file.
+}; //CMappedFile
+
+#endif //__L4RC_GAME_MAPPEDFILE_H__
@@ -0,0 +1,305 @@
+/// \file Minimap.cpp
+/// \brief Code for the minimap CMinimap.
+
+#include <algorithm>
+#include <cmath>
+
+#include "Minimap.h"
+
+/// Anchor the minimap panel to the bottom right corner of the window, inside
+/// a margin of `HUD_MARGIN` pixels.
+/// \param vPixelSize Width and height of the pixel sprite.
+/// \param w Window width.
+/// \param h Window height.
+
+CMinimap::CMinimap(const Vector2& vPixelSize, int w, int h):
+  m_vPixelSize(vPixelSize)
+{
+  m_cPanel.m_nSpriteIndex = (UINT)eSprite::Pixel;
+  m_cPanel.m_vPos.x = 0.5f*(w - MINIMAP_SIZE) - HUD_MARGIN;
+  m_cPanel.m_vPos.y = 0.5f*(MINIMAP_SIZE - h) + HUD_MARGIN;
+  m_cPanel.m_fXScale = MINIMAP_SIZE/m_vPixelSize.x;
+  m_cPanel.m_fYScale = MINIMAP_SIZE/m_vPixelSize.y;
+  m_cPanel.m_f4Tint = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+  m_cPanel.m_fAlpha = 0.5f;
+} //constructor
+
+/// Build the pyramid for a map, counting each level from the one below, and
+/// choose the level to draw. Level \f$\ell\f$ is half the width and height
+/// of the level below, rounded up, and the top level is a single cell.
+/// \param map The map, row by row from the top, which must outlive the pyramid.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+/// \param t Tile width and height.
+
+void CMinimap::Build(char** map, size_t w, size_t h, float t){
+  m_chMap = map;
+  m_fTileSize = t;
+  m_vecLevel.clear();
+  m_nRecounted = 0;
+
+  CLevel level0;
+  level0.m_nWidth = w;
+  level0.m_nHeight = h;
+  m_vecLevel.push_back(level0);
+
+  while(m_vecLevel.back().m_nWidth > 1 || m_vecLevel.back().m_nHeight > 1){
+    CLevel next;
+    next.m_nWidth = (m_vecLevel.back().m_nWidth + 1)/2;
+    next.m_nHeight = (m_vecLevel.back().m_nHeight + 1)/2;
+    next.m_vecCount.resize(next.m_nWidth*next.m_nHeight);
+    m_vecLevel.push_back(std::move(next));
+
+    const size_t l = m_vecLevel.size() - 1; //level just added
+
+    for(size_t i=0; i<m_vecLevel[l].m_nHeight; i++)
+      for(size_t j=0; j<m_vecLevel[l].m_nWidth; j++)
+        Recount(l, i, j);
+  } //while
+
+  m_nDrawLevel = 0;
+  while(m_nDrawLevel + 1 < m_vecLevel.size() &&
+    std::max(m_vecLevel[m_nDrawLevel].m_nWidth, m_vecLevel[m_nDrawLevel].m_nHeight) > MINIMAP_CELLS)
+      m_nDrawLevel++;
+
+  const CLevel& drawn = m_vecLevel[m_nDrawLevel]; //shorthand
+  m_fCellSize = MINIMAP_SIZE/std::max<size_t>(std::max(drawn.m_nWidth, drawn.m_nHeight), 1);
+  m_vCorner = m_cPanel.m_vPos + 0.5f*m_fCellSize*Vector2(-(float)drawn.m_nWidth, (float)drawn.m_nHeight);
+
+  m_vecMarked.assign(drawn.m_nWidth*drawn.m_nHeight, 0);
+  m_bWallsDirty = true;
+} //Build
+
+/// Reader function for the count of a cell. Level 0 is read from the map,
+/// where `W` is a wall and `F` and `D` are floor.
+/// \param l Pyramid level.
+/// \param i Row, from the top.
+/// \param j Column.
+/// \return The count, which is empty if the cell is off the edge of the level.
+
+const CMinimap::CCount CMinimap::GetCount(size_t l, size_t i, size_t j) const{
+  CCount count;
+  if(l >= m_vecLevel.size())return count;
+
+  const CLevel& level = m_vecLevel[l]; //shorthand
+  if(i >= level.m_nHeight || j >= level.m_nWidth)return count;
+
+  if(l > 0)
+    return level.m_vecCount[i*level.m_nWidth + j];
+
+  switch(m_chMap[i][j]){
+    case 'W': count.m_nWalls = 1; break;
+    case 'F': case 'D': count.m_nFloors = 1; break;
+  } //switch
+
+  return count;
+} //GetCount
+
+/// Recount a cell by adding up the counts of the 2 by 2 cells below it,
+/// some of which may be off the edge of the level below.
+/// \param l Pyramid level, at least 1.
+/// \param i Row, from the top.
+/// \param j Column.
+
+void CMinimap::Recount(size_t l, size_t i, size_t j){
+  CCount& count = m_vecLevel[l].m_vecCount[i*m_vecLevel[l].m_nWidth + j];
+  count = CCount();
+
+  for(size_t di=0; di<2; di++)
+    for(size_t dj=0; dj<2; dj++){
+      const CCount child = GetCount(l - 1, 2*i + di, 2*j + dj);
+      count.m_nWalls += child.m_nWalls;
+      count.m_nFloors += child.m_nFloors;
+    } //for
+
+  m_nRecounted++;
+} //Recount
+
+/// Respond to a change in a tile of the map by recounting the cell above it
+/// in each level of the pyramid, and nothing else.
+/// \param i Row, from the top.
+/// \param j Column.
+
+void CMinimap::Update(size_t i, size_t j){
+  Update(i, j, i, j);
+} //Update
+
+/// Respond to a change in a rectangle of tiles by recounting the cells above
+/// it in each level of the pyramid, and nothing else. The rectangle shrinks
+/// by half at each level, so this visits about a third more cells than there
+/// are tiles in the rectangle, plus a few cells per level along its edges.
+/// \param top Top row.
+/// \param left Left column.
+/// \param bottom Bottom row, inclusive.
+/// \param right Right column, inclusive.
+
+void CMinimap::Update(size_t top, size_t left, size_t bottom, size_t right){
+  m_nRecounted = 0;
+  if(m_vecLevel.empty())return;
+
+  bottom = std::min(bottom, m_vecLevel[0].m_nHeight - 1);
+  right = std::min(right, m_vecLevel[0].m_nWidth - 1);
+  if(top > bottom || left > right)return; //off the map
+
+  for(size_t l=1; l<m_vecLevel.size(); l++){
+    top /= 2; left /= 2; bottom /= 2; right /= 2;
+
+    for(size_t i=top; i<=bottom; i++)
+      for(size_t j=left; j<=right; j++)
+        Recount(l, i, j);
+  } //for
+
+  m_bWallsDirty = true;
+} //Update
+
+/// Work out a sprite for each run of consecutive wall cells in each row of
+/// the level drawn, stretching the pixel sprite across the run.
+
+void CMinimap::MakeWalls(){
+  const CLevel& level = m_vecLevel[m_nDrawLevel]; //shorthand
+
+  LSpriteDesc2D desc;
+  desc.m_nSpriteIndex = (UINT)eSprite::Pixel;
+  desc.m_f4Tint = XMFLOAT4(0.8f, 0.8f, 0.8f, 1.0f);
+  desc.m_fYScale = m_fCellSize/m_vPixelSize.y;
+
+  m_vecWall.clear();
+
+  for(size_t i=0; i<level.m_nHeight; i++){
+    size_t j = 0;
+
+    while(j < level.m_nWidth){
+      const size_t first = j; //first cell in the run
+
+      while(j < level.m_nWidth){
+        const CCount count = GetCount(m_nDrawLevel, i, j);
+        if(count.m_nWalls <= count.m_nFloors)break;
+        j++;
+      } //while
+
+      if(j > first){ //run of walls
+        desc.m_vPos = m_vCorner + m_fCellSize*Vector2(0.5f*(first + j), -(i + 0.5f));
+        desc.m_fXScale = (j - first)*m_fCellSize/m_vPixelSize.x;
+        m_vecWall.push_back(desc);
+      } //if
+
+      else j++; //not a wall
+    } //while
+  } //for
+
+  m_bWallsDirty = false;
+} //MakeWalls
+
+/// Add a marker to the sprites for the frame, in the cell of the level drawn
+/// that a point is in, at least `MINIMAP_MARKER_SIZE` pixels across. An
+/// enemy marker is only added if no other has been added in the cell this
+/// frame.
+/// \param vCamera Camera position.
+/// \param vPos Position in the world.
+/// \param color Marker color.
+/// \param bEnemy Whether it marks an enemy.
+/// \return true if a marker was added.
+
+const bool CMinimap::Mark(const Vector2& vCamera, const Vector2& vPos,
+  const XMFLOAT4& color, bool bEnemy)
+{
+  const CLevel& level0 = m_vecLevel[0]; //shorthand
+  if(vPos.x < 0.0f || vPos.y < 0.0f)return false; //off the map
+
+  const size_t row = level0.m_nHeight - 1 - std::min((size_t)(vPos.y/m_fTileSize), level0.m_nHeight - 1);
+  const size_t col = std::min((size_t)(vPos.x/m_fTileSize), level0.m_nWidth - 1);
+  const size_t i = row >> m_nDrawLevel;
+  const size_t j = col >> m_nDrawLevel;
+
+  if(bEnemy){
+    BYTE& marked = m_vecMarked[i*m_vecLevel[m_nDrawLevel].m_nWidth + j];
+    if(marked)return false;
+    marked = 1;
+  } //if
+
+  const float size = std::max(m_fCellSize, MINIMAP_MARKER_SIZE);
+
+  LSpriteDesc2D desc;
+  desc.m_nSpriteIndex = (UINT)eSprite::Pixel;
+  desc.m_vPos = vCamera + m_vCorner + m_fCellSize*Vector2(j + 0.5f, -(i + 0.5f));
+  desc.m_fXScale = size/m_vPixelSize.x;
+  desc.m_fYScale = size/m_vPixelSize.y;
+  desc.m_f4Tint = color;
+  m_vecSprite.push_back(desc);
+
+  return true;
+} //Mark
+
+/// Work out the sprites for a frame: the panel, the wall runs, worked out
+/// again first if the pyramid has changed, a marker for each cell with an
+/// enemy in it near the player, and a marker for the player on top. Screen
+/// space is mapped to world space by moving it with the camera, as in
+/// `CHud::Draw()`.
+/// \param vCamera Camera position.
+/// \param pPlayer Pointer to the player position, or nullptr if there is no player.
+/// \param vecEnemy Positions of enemies, of which those within
+/// `MINIMAP_MARKER_RANGE` of the player, or of the camera if there is no
+/// player, are marked.
+
+void CMinimap::Prepare(const Vector2& vCamera, const Vector2* pPlayer,
+  const std::vector<Vector2>& vecEnemy)
+{
+  m_vecSprite.clear();
+
+  if(m_vecLevel.empty() || m_vecLevel[0].m_nWidth == 0 || m_vecLevel[0].m_nHeight == 0)
+    return; //no map
+
+  if(m_bWallsDirty)MakeWalls();
+
+  m_vecSprite.push_back(m_cPanel);
+  m_vecSprite.back().m_vPos += vCamera;
+
+  for(const LSpriteDesc2D& wall: m_vecWall){
+    m_vecSprite.push_back(wall);
+    m_vecSprite.back().m_vPos += vCamera;
+  } //for
+
+  const Vector2 vCenter = pPlayer? *pPlayer: vCamera; //center of marker range
+  const XMFLOAT4 red(1.0f, 0.2f, 0.2f, 1.0f);
+
+  std::fill(m_vecMarked.begin(), m_vecMarked.end(), 0);
+
+  for(const Vector2& vPos: vecEnemy){
+    const Vector2 d = vPos - vCenter;
+
+    if(fabsf(d.x) <= MINIMAP_MARKER_RANGE && fabsf(d.y) <= MINIMAP_MARKER_RANGE)
+      Mark(vCamera, vPos, red, true);
+  } //for
+
+  if(pPlayer)
+    Mark(vCamera, *pPlayer, XMFLOAT4(0.2f, 1.0f, 0.2f, 1.0f), false);
+} //Prepare
+
+/// Reader function for the number of pyramid levels, including the map.
+/// \return Number of levels.
+
+const size_t CMinimap::GetNumLevels() const{
+  return m_vecLevel.size();
+} //GetNumLevels
+
+/// Reader function for the pyramid level drawn.
+/// \return Level drawn, 0 for the map itself.
+
+const size_t CMinimap::GetDrawLevel() const{
+  return m_nDrawLevel;
+} //GetDrawLevel
+
+/// Reader function for the number of cells recounted by the last update,
+/// or by building the pyramid if there has been no update since.
+/// \return Number of cells recounted.
+
+const size_t CMinimap::GetNumRecounted() const{
+  return m_nRecounted;
+} //GetNumRecounted
+
+/// Reader function for the number of wall run sprites drawn.
+/// \return Number of wall runs.
+
+const size_t CMinimap::GetNumWallRuns() const{
+  return m_vecWall.size();
+} //GetNumWallRuns
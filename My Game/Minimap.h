@@ -0,0 +1,115 @@
+/// \file Minimap.h
+/// \brief Interface for the minimap CMinimap.
+
+#ifndef __L4RC_GAME_MINIMAP_H__
+#define __L4RC_GAME_MINIMAP_H__
+
+#include <vector>
+
+#include "SpriteDesc.h"
+#include "GameDefines.h"
+
+/// \brief The minimap.
+///
+/// The minimap shows the whole map in a square in the bottom right corner of
+/// the window, with markers for the player and for the enemies near the
+/// player. It is drawn from a pyramid of occupancy counts over the tile
+/// grid, like the mipmaps of an image. Level 0 is the map itself, and each
+/// cell of each level above it holds the number of wall tiles and floor
+/// tiles in the 2 by 2 cells below it, so a cell of level \f$\ell\f$ counts
+/// the tiles in a square \f$2^\ell\f$ tiles across. The level drawn is the
+/// lowest one that is at most `MINIMAP_CELLS` cells across, and a cell is
+/// drawn as wall if it has more wall tiles than floor tiles. Consecutive wall
+/// cells in a row are drawn as a single stretched sprite, and those sprites
+/// are only worked out again when a count changes, so drawing the minimap
+/// costs much the same on a huge map as on a tiny one.
+///
+/// When tiles change, `Update()` recounts only the cells above them, a
+/// single cell per level for a single tile. Markers are for the player and
+/// for the enemies that the caller finds within `MINIMAP_MARKER_RANGE` of
+/// the player, which the heads-up display looks up in the object manager's
+/// spatial grid, and at most one enemy marker is drawn per cell, so they
+/// don't depend on the size of the map either.
+///
+/// The minimap uses nothing from the engine but the sprite descriptor, and
+/// draws with anything that has the sprite renderer's `Draw()`, so tools
+/// can draw it just as the game does.
+
+class CMinimap{
+  public:
+    /// \brief Occupancy count.
+    ///
+    /// The number of wall tiles and floor tiles in a pyramid cell. Tiles that
+    /// are neither, such as error tiles and the space off the edge of the
+    /// map, are in neither count.
+
+    struct CCount{
+      UINT m_nWalls = 0; ///< Number of wall tiles.
+      UINT m_nFloors = 0; ///< Number of floor tiles.
+    }; //CCount
+
+  private:
+    /// \brief Pyramid level.
+    ///
+    /// The size of a level of the pyramid and its counts.
+
+    struct CLevel{
+      size_t m_nWidth = 0; ///< Number of cells wide.
+      size_t m_nHeight = 0; ///< Number of cells high.
+      std::vector<CCount> m_vecCount; ///< Counts row by row from the top, none for level 0.
+    }; //CLevel
+
+    char** m_chMap = nullptr; ///< The map, which belongs to the tile manager.
+    float m_fTileSize = 0.0f; ///< Tile width and height.
+    std::vector<CLevel> m_vecLevel; ///< Pyramid levels, the map first.
+    size_t m_nRecounted = 0; ///< Cells recounted by the last update.
+
+    size_t m_nDrawLevel = 0; ///< Pyramid level drawn.
+    float m_fCellSize = 0.0f; ///< Width and height of a drawn cell in pixels.
+    Vector2 m_vCorner; ///< Top left corner of the drawn cells relative to window center.
+    Vector2 m_vPixelSize; ///< Size of the pixel sprite.
+
+    LSpriteDesc2D m_cPanel; ///< Background, relative to window center.
+    std::vector<LSpriteDesc2D> m_vecWall; ///< Wall runs, relative to window center.
+    bool m_bWallsDirty = true; ///< Whether the wall runs need working out again.
+    std::vector<BYTE> m_vecMarked; ///< Whether each drawn cell has an enemy marker.
+    std::vector<LSpriteDesc2D> m_vecSprite; ///< Sprites for the frame, in drawing order.
+
+    void Recount(size_t, size_t, size_t); ///< Recount a cell from the level below.
+    void MakeWalls(); ///< Work out the wall runs.
+    const bool Mark(const Vector2&, const Vector2&, const XMFLOAT4&, bool); ///< Add a marker.
+    void Prepare(const Vector2&, const Vector2*, const std::vector<Vector2>&); ///< Work out the sprites for a frame.
+
+  public:
+    CMinimap(const Vector2&, int, int); ///< Constructor.
+
+    void Build(char**, size_t, size_t, float); ///< Build the pyramid for a map.
+    void Update(size_t, size_t); ///< Respond to a change in a tile.
+    void Update(size_t, size_t, size_t, size_t); ///< Respond to a change in a region.
+    template<class t> void Draw(t*, const Vector2&, const Vector2*,
+      const std::vector<Vector2>&); ///< Draw in screen space.
+
+    const CCount GetCount(size_t, size_t, size_t) const; ///< Count for a cell.
+    const size_t GetNumLevels() const; ///< Number of pyramid levels.
+    const size_t GetDrawLevel() const; ///< Pyramid level drawn.
+    const size_t GetNumRecounted() const; ///< Cells recounted by the last update.
+    const size_t GetNumWallRuns() const; ///< Number of wall sprites drawn.
+}; //CMinimap
+
+/// Draw the minimap in screen space, which is mapped to world space by
+/// moving it with the camera.
+/// \param pRenderer Pointer to anything with a `Draw(const LSpriteDesc2D*)` function.
+/// \param vCamera Camera position.
+/// \param pPlayer Pointer to the player position, or nullptr if there is no player.
+/// \param vecEnemy Positions of enemies near the player.
+
+template<class t> void CMinimap::Draw(t* pRenderer, const Vector2& vCamera,
+  const Vector2* pPlayer, const std::vector<Vector2>& vecEnemy)
+{
+  Prepare(vCamera, pPlayer, vecEnemy);
+
+  for(const LSpriteDesc2D& desc: m_vecSprite)
+    pRenderer->Draw(&desc);
+} //Draw
+
+#endif //__L4RC_GAME_MINIMAP_H__
@@ -0,0 +1,228 @@
+/// \file MotionStore.cpp
+/// \brief Code for the motion store CMotionStore.
+
+#include "MotionStore.h"
+#include "Object.h"
+#include "TileManager.h"
+
+/// Reserve space for a number of entries in each of the arrays.
+/// \param n Number of entries.
+
+void CMotionStore::reserve(size_t n){
+  m_vecPosX.reserve(n);
+  m_vecPosY.reserve(n);
+  m_vecVelX.reserve(n);
+  m_vecVelY.reserve(n);
+  m_vecRadius.reserve(n);
+  m_vecLife.reserve(n);
+  m_vecFlags.reserve(n);
+  m_vecOwner.reserve(n);
+} //reserve
+
+/// Unregister every object and empty the arrays, keeping their capacity.
+
+void CMotionStore::clear(){
+  for(CObject* pObj: m_vecOwner)
+    pObj->m_nMotion = UINT_MAX;
+
+  m_vecPosX.clear();
+  m_vecPosY.clear();
+  m_vecVelX.clear();
+  m_vecVelY.clear();
+  m_vecRadius.clear();
+  m_vecLife.clear();
+  m_vecFlags.clear();
+  m_vecOwner.clear();
+} //clear
+
+/// Reader function for the size of an entry, which is the sum of the sizes
+/// of its fields in the parallel arrays.
+/// \return Number of bytes per entry.
+
+const size_t CMotionStore::GetEntrySize(){
+  return
+    sizeof(decltype(m_vecPosX)::value_type) + sizeof(decltype(m_vecPosY)::value_type) +
+    sizeof(decltype(m_vecVelX)::value_type) + sizeof(decltype(m_vecVelY)::value_type) +
+    sizeof(decltype(m_vecRadius)::value_type) + sizeof(decltype(m_vecLife)::value_type) +
+    sizeof(decltype(m_vecFlags)::value_type) + sizeof(decltype(m_vecOwner)::value_type);
+} //GetEntrySize
+
+/// Register an object by appending an entry initialized from the object's
+/// current position, velocity, radius, and flags. From now on the entry is
+/// the authoritative copy of those fields.
+/// \param pObj Pointer to the object.
+
+void CMotionStore::Add(CObject* pObj){
+  pObj->m_nMotion = (UINT)m_vecOwner.size();
+
+  BYTE flags = 0;
+  if(pObj->m_bDead)flags |= DEAD;
+  if(pObj->m_bStatic)flags |= STATIC;
+  if(pObj->m_bFast)flags |= FAST;
+
+  m_vecPosX.push_back(pObj->m_vPos.x);
+  m_vecPosY.push_back(pObj->m_vPos.y);
+  m_vecVelX.push_back(pObj->m_vVelocity.x);
+  m_vecVelY.push_back(pObj->m_vVelocity.y);
+  m_vecRadius.push_back(pObj->m_fRadius);
+  m_vecLife.push_back(0.0f); //unlimited until SetLifeSpan()
+  m_vecFlags.push_back(flags);
+  m_vecOwner.push_back(pObj);
+} //Add
+
+/// Unregister an object by moving the last entry into its place.
+/// \param pObj Pointer to the object.
+
+void CMotionStore::Remove(CObject* pObj){
+  const UINT i = pObj->m_nMotion;
+  if(i >= m_vecOwner.size())return; //not registered
+
+  const UINT last = (UINT)m_vecOwner.size() - 1;
+
+  if(i != last){
+    m_vecPosX[i] = m_vecPosX[last];
+    m_vecPosY[i] = m_vecPosY[last];
+    m_vecVelX[i] = m_vecVelX[last];
+    m_vecVelY[i] = m_vecVelY[last];
+    m_vecRadius[i] = m_vecRadius[last];
+    m_vecLife[i] = m_vecLife[last];
+    m_vecFlags[i] = m_vecFlags[last];
+    m_vecOwner[i] = m_vecOwner[last];
+    m_vecOwner[i]->m_nMotion = i;
+  } //if
+
+  m_vecPosX.pop_back();
+  m_vecPosY.pop_back();
+  m_vecVelX.pop_back();
+  m_vecVelY.pop_back();
+  m_vecRadius.pop_back();
+  m_vecLife.pop_back();
+  m_vecFlags.pop_back();
+  m_vecOwner.pop_back();
+
+  pObj->m_nMotion = UINT_MAX;
+} //Remove
+
+/// Mark an entry as dead and tell its owner. This is the only time that the
+/// integration pass touches an owner, other than for fast entries.
+/// \param i Entry index.
+
+void CMotionStore::Kill(UINT i){
+  m_vecFlags[i] |= DEAD;
+  m_vecOwner[i]->SetDead();
+} //Kill
+
+/// Move every live, non-static entry along its velocity and count down its
+/// life span. Fast entries are swept against the walls as in
+/// `CObject::SweptMove()`, which needs the owner, but there are few of them.
+/// \param dt Frame time in seconds.
+
+void CMotionStore::Integrate(float dt){
+  const size_t n = m_vecOwner.size();
+
+  for(size_t i=0; i<n; i++){
+    const BYTE flags = m_vecFlags[i];
+    if(flags & (DEAD | STATIC))continue;
+
+    const float dx = m_vecVelX[i]*dt; //displacement x
+    const float dy = m_vecVelY[i]*dt; //displacement y
+
+    if(flags & FAST){
+      CObject* pObj = m_vecOwner[i];
+      pObj->m_vPos = pObj->m_vOldPos = Vector2(m_vecPosX[i], m_vecPosY[i]);
+      pObj->m_fTimeOfImpact = 1.0f;
+      pObj->SweptMove(Vector2(dx, dy));
+      m_vecPosX[i] = pObj->m_vPos.x;
+      m_vecPosY[i] = pObj->m_vPos.y;
+      if(pObj->m_bDead)m_vecFlags[i] |= DEAD;
+    } //if
+
+    else{
+      m_vecPosX[i] += dx;
+      m_vecPosY[i] += dy;
+    } //else
+
+    if(m_vecLife[i] > 0.0f){ //limited life span
+      m_vecLife[i] -= dt;
+      if(m_vecLife[i] <= 0.0f)Kill((UINT)i);
+    } //if
+  } //for
+} //Integrate
+
+/// Test every live entry against the walls, twice so that an entry wedged
+/// in a corner is pushed out of both walls. The owner's collision response
+/// is called for each hit, so its position is copied to the owner first and
+/// copied back afterwards in case the response moved it.
+
+void CMotionStore::CollideWithWalls(){
+  const size_t n = m_vecOwner.size();
+
+  for(size_t i=0; i<n; i++)
+    for(int k=0; k<2 && !(m_vecFlags[i] & DEAD); k++){
+      Vector2 norm; float d = 0;
+      const BoundingSphere s(Vector3(m_vecPosX[i], m_vecPosY[i], 0), m_vecRadius[i]);
+
+      if(m_pTileManager->CollideWithWall(s, norm, d)){
+        CObject* pObj = m_vecOwner[i];
+        pObj->m_vPos = Vector2(m_vecPosX[i], m_vecPosY[i]);
+        pObj->CollisionResponse(norm, d);
+        m_vecPosX[i] = pObj->m_vPos.x;
+        m_vecPosY[i] = pObj->m_vPos.y;
+        if(pObj->m_bDead)m_vecFlags[i] |= DEAD;
+      } //if
+    } //for
+} //CollideWithWalls
+
+/// Copy every entry's position into its owner's sprite descriptor, which is
+/// where the renderer and the object-object collision code look for it.
+
+void CMotionStore::WriteBack(){
+  const size_t n = m_vecOwner.size();
+
+  for(size_t i=0; i<n; i++)
+    m_vecOwner[i]->m_vPos = Vector2(m_vecPosX[i], m_vecPosY[i]);
+} //WriteBack
+
+/// Reader function for the position of an entry.
+/// \param i Entry index.
+/// \return Position.
+
+const Vector2 CMotionStore::GetPos(UINT i) const{
+  return Vector2(m_vecPosX[i], m_vecPosY[i]);
+} //GetPos
+
+/// Set the position of an entry and its owner.
+/// \param i Entry index.
+/// \param v Position.
+
+void CMotionStore::SetPos(UINT i, const Vector2& v){
+  m_vecPosX[i] = v.x;
+  m_vecPosY[i] = v.y;
+  m_vecOwner[i]->m_vPos = v;
+} //SetPos
+
+/// Set the velocity of an entry.
+/// \param i Entry index.
+/// \param v Velocity.
+
+void CMotionStore::SetVelocity(UINT i, const Vector2& v){
+  m_vecVelX[i] = v.x;
+  m_vecVelY[i] = v.y;
+} //SetVelocity
+
+/// Set the remaining life span of an entry.
+/// \param i Entry index.
+/// \param t Life span in seconds, or zero for unlimited.
+
+void CMotionStore::SetLifeSpan(UINT i, float t){
+  m_vecLife[i] = t;
+} //SetLifeSpan
+
+/// Set or clear the fast flag of an entry.
+/// \param i Entry index.
+/// \param b true for fast.
+
+void CMotionStore::SetFast(UINT i, bool b){
+  if(b)m_vecFlags[i] |= FAST;
+  else m_vecFlags[i] &= ~FAST;
+} //SetFast
@@ -0,0 +1,64 @@
+/// \file MotionStore.h
+/// \brief Interface for the motion store CMotionStore.
+
+#ifndef __L4RC_GAME_MOTIONSTORE_H__
+#define __L4RC_GAME_MOTIONSTORE_H__
+
+#include <vector>
+
+#include "Common.h"
+#include "GameDefines.h"
+
+class CObject;
+
+/// \brief The motion store.
+///
+/// The motion store keeps the fields that the per-frame movement and wall
+/// collision passes touch in parallel arrays, one entry per registered
+/// object, so that those passes stream through contiguous memory instead of
+/// chasing a pointer to each object. An object registered here is a thin view
+/// onto its entry: the store owns its position, velocity, radius, remaining
+/// life span and flags, and its sprite descriptor position is only a copy
+/// made for the renderer and the object-object collision code. Entries are
+/// removed by swapping the last entry into the hole, so indices change and
+/// each object's `m_nMotion` is kept up to date.
+
+class CMotionStore: public CCommon{
+  public:
+    static const BYTE DEAD   = 1; ///< Flag for a dead entry.
+    static const BYTE STATIC = 2; ///< Flag for an entry that does not move.
+    static const BYTE FAST   = 4; ///< Flag for an entry that uses swept motion.
+
+  private:
+    std::vector<float> m_vecPosX; ///< Position x coordinates.
+    std::vector<float> m_vecPosY; ///< Position y coordinates.
+    std::vector<float> m_vecVelX; ///< Velocity x components.
+    std::vector<float> m_vecVelY; ///< Velocity y components.
+    std::vector<float> m_vecRadius; ///< Bounding circle radii.
+    std::vector<float> m_vecLife; ///< Remaining life spans, 0 for unlimited.
+    std::vector<BYTE> m_vecFlags; ///< Flags.
+    std::vector<CObject*> m_vecOwner; ///< Object that each entry belongs to.
+
+    void Kill(UINT); ///< Mark entry and its owner dead.
+
+  public:
+    void reserve(size_t); ///< Reserve space for entries.
+    void clear(); ///< Remove all entries.
+    const size_t size() const{return m_vecOwner.size();} ///< Number of entries.
+    static const size_t GetEntrySize(); ///< Bytes per entry.
+
+    void Add(CObject*); ///< Register an object.
+    void Remove(CObject*); ///< Unregister an object.
+
+    void Integrate(float); ///< Move all entries.
+    void CollideWithWalls(); ///< Wall collision detection and response.
+    void WriteBack(); ///< Copy positions to the owners.
+
+    const Vector2 GetPos(UINT i) const; ///< Get position.
+    void SetPos(UINT, const Vector2&); ///< Set position.
+    void SetVelocity(UINT, const Vector2&); ///< Set velocity.
+    void SetLifeSpan(UINT, float); ///< Set remaining life span.
+    void SetFast(UINT, bool); ///< Set or clear the fast flag.
+}; //CMotionStore
+
+#endif //__L4RC_GAME_MOTIONSTORE_H__
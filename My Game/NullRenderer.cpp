@@ -0,0 +1,436 @@
+/// \file NullRenderer.cpp
+/// \brief Code for the null renderer CNullRenderer.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "NullRenderer.h"
+
+static const int TEXT_TEXTURE = -2; ///< Texture index for text.
+
+/// \brief XML tag.
+///
+/// The name and attributes of a tag from a settings file, which only uses
+/// attributes, never text.
+
+struct CXmlTag{
+  std::string m_strName; ///< Tag name, with a leading '/' for a closing tag.
+  std::map<std::string, std::string> m_mapAttr; ///< Attributes.
+
+  /// Get an attribute value.
+  /// \param name Attribute name.
+  /// \return Its value, or the empty string if there isn't one.
+
+  const std::string Get(const char* name) const{
+    const auto it = m_mapAttr.find(name);
+    return it == m_mapAttr.end()? std::string(): it->second;
+  } //Get
+}; //CXmlTag
+
+/// Turn a path from a settings file, which uses backslashes, into one that
+/// `fopen` takes on any platform.
+/// \param s Path.
+/// \return Path with forward slashes.
+
+static std::string FixPath(std::string s){
+  std::replace(s.begin(), s.end(), '\\', '/');
+  return s;
+} //FixPath
+
+/// Scan the text of a settings file into a list of tags, skipping comments,
+/// the declaration, and anything else that starts with "<!" or "<?".
+/// \param s Text of the settings file.
+/// \return Tags in order.
+
+static std::vector<CXmlTag> Scan(const std::string& s){
+  std::vector<CXmlTag> vecTag;
+  size_t i = 0;
+
+  auto readName = [&](){
+    const size_t j = i;
+    while(i < s.size() && !isspace((unsigned char)s[i]) && !strchr("=/>", s[i]))i++;
+    return s.substr(j, i - j);
+  }; //readName
+
+  auto skipSpace = [&](){
+    while(i < s.size() && isspace((unsigned char)s[i]))i++;
+  }; //skipSpace
+
+  while((i = s.find('<', i)) != std::string::npos){
+    if(s.compare(i, 4, "<!--") == 0){
+      i = s.find("-->", i);
+      if(i == std::string::npos)break;
+      continue;
+    } //if
+
+    if(i + 1 < s.size() && (s[i + 1] == '?' || s[i + 1] == '!')){
+      i = s.find('>', i);
+      if(i == std::string::npos)break;
+      continue;
+    } //if
+
+    CXmlTag tag;
+    i++;
+
+    if(i < s.size() && s[i] == '/')
+      tag.m_strName = "/" + (i++, readName());
+    else tag.m_strName = readName();
+
+    for(;;){
+      skipSpace();
+      if(i >= s.size() || s[i] == '>' || s[i] == '/')break;
+
+      const std::string key = readName();
+      skipSpace();
+      if(i >= s.size() || s[i] != '=')continue;
+      i++; skipSpace();
+
+      const char q = s[i]; //quote character
+      const size_t j = s.find(q, i + 1);
+      if(j == std::string::npos)break;
+
+      tag.m_mapAttr[key] = s.substr(i + 1, j - i - 1);
+      i = j + 1;
+    } //for
+
+    vecTag.push_back(tag);
+  } //while
+
+  return vecTag;
+} //Scan
+
+/// Read the width and height of a PNG file from its header.
+/// \param name File name.
+/// \param w [out] Width.
+/// \param h [out] Height.
+/// \return true if it is a PNG file.
+
+static const bool ReadPNGSize(const std::string& name, float& w, float& h){
+  unsigned char b[24]; //signature, IHDR length and type, width, height
+  FILE* fp = fopen(name.c_str(), "rb");
+  if(fp == nullptr)return false;
+
+  const bool ok = fread(b, 1, sizeof(b), fp) == sizeof(b) &&
+    memcmp(b, "\x89PNG", 4) == 0 && memcmp(b + 12, "IHDR", 4) == 0;
+  fclose(fp);
+
+  if(ok){
+    w = (float)(b[16] << 24 | b[17] << 16 | b[18] << 8 | b[19]);
+    h = (float)(b[20] << 24 | b[21] << 16 | b[22] << 8 | b[23]);
+  } //if
+
+  return ok;
+} //ReadPNGSize
+
+/// Add another set of statistics to this one.
+/// \param s Statistics.
+
+void CRenderStats::Add(const CRenderStats& s){
+  m_nDraws += s.m_nDraws;
+  m_nTextureSwitches += s.m_nTextureSwitches;
+  m_nBoxes += s.m_nBoxes;
+  m_nTexts += s.m_nTexts;
+  m_fPixels += s.m_fPixels;
+} //Add
+
+/// Get the texture for an image file, giving it the next texture index and
+/// reading its size the first time that it is asked for.
+/// \param file File name.
+/// \param w [out] Width of the image.
+/// \param h [out] Height of the image.
+/// \return Texture index, or -1 if the file isn't a readable PNG file.
+
+const int CNullRenderer::GetTexture(const std::string& file, float& w, float& h){
+  if(!ReadPNGSize(file, w, h)){
+    fprintf(stderr, "Cannot read image %s\n", file.c_str());
+    return -1;
+  } //if
+
+  const auto it = m_mapTexture.find(file);
+  if(it != m_mapTexture.end())return it->second;
+
+  const int n = (int)m_mapTexture.size();
+  m_mapTexture[file] = n;
+  return n;
+} //GetTexture
+
+/// Read the window size and the sprites from a settings file. A sprite is
+/// either a single image, one image per frame (`file`, `ext`, and `frames`),
+/// or frames cut from another sprite's image (`sheet` and `frames`, with a
+/// `frame` tag for each). The sprites aren't usable until they are loaded
+/// with `Load()`, as with the sprite renderer.
+/// \param name File name.
+/// \return true if the file was read and every image found.
+
+const bool CNullRenderer::LoadSettings(const std::string& name){
+  FILE* fp = fopen(FixPath(name).c_str(), "rb");
+
+  if(fp == nullptr){
+    fprintf(stderr, "Cannot open %s\n", name.c_str());
+    return false;
+  } //if
+
+  std::string s;
+  char buffer[4096];
+
+  for(size_t n; (n = fread(buffer, 1, sizeof(buffer), fp)) > 0;)
+    s.append(buffer, n);
+
+  fclose(fp);
+
+  const std::vector<CXmlTag> vecTag = Scan(s);
+  std::string path; //folder that the images are in
+  bool ok = true;
+
+  for(size_t i=0; i<vecTag.size(); i++){
+    const CXmlTag& tag = vecTag[i]; //shorthand
+
+    if(tag.m_strName == "renderer"){
+      m_nWinWidth = atoi(tag.Get("width").c_str());
+      m_nWinHeight = atoi(tag.Get("height").c_str());
+    } //if
+
+    else if(tag.m_strName == "sprites")
+      path = FixPath(tag.Get("path")) + "/";
+
+    else if(tag.m_strName == "sprite"){
+      const std::string file = tag.Get("file");
+      const std::string sheet = tag.Get("sheet");
+      const int frames = std::max(1, atoi(tag.Get("frames").c_str()));
+      CSprite sprite;
+
+      if(!sheet.empty()){ //frames cut from a sheet
+        const auto it = m_mapSettings.find(sheet);
+        const int texture = it == m_mapSettings.end() || it->second.empty()?
+          -1: it->second[0].m_nTexture;
+
+        sprite.resize(frames);
+
+        while(i + 1 < vecTag.size() && vecTag[i + 1].m_strName == "frame"){
+          const CXmlTag& f = vecTag[++i]; //shorthand
+          const int n = atoi(f.Get("index").c_str());
+          if(n < 0 || n >= frames)continue;
+
+          sprite[n].m_nTexture = texture;
+          sprite[n].m_fWidth = (float)(atoi(f.Get("right").c_str()) - atoi(f.Get("left").c_str()));
+          sprite[n].m_fHeight = (float)(atoi(f.Get("bottom").c_str()) - atoi(f.Get("top").c_str()));
+        } //while
+      } //if
+
+      else if(!tag.Get("ext").empty()){ //one image per frame
+        sprite.resize(frames);
+
+        for(int n=0; n<frames; n++){
+          CFrame& f = sprite[n]; //shorthand
+          f.m_nTexture = GetTexture(path + file + std::to_string(n) + "." +
+            tag.Get("ext"), f.m_fWidth, f.m_fHeight);
+        } //for
+      } //else if
+
+      else{ //single image
+        sprite.resize(1);
+        CFrame& f = sprite[0]; //shorthand
+        f.m_nTexture = GetTexture(path + file, f.m_fWidth, f.m_fHeight);
+      } //else
+
+      for(const CFrame& f: sprite)
+        ok = ok && f.m_nTexture >= 0;
+
+      m_mapSettings[tag.Get("name")] = sprite;
+    } //else if
+  } //for
+
+  return ok;
+} //LoadSettings
+
+/// Load a sprite from the settings file, as the sprite renderer does.
+/// \param n Sprite index.
+/// \param name Sprite name in the settings file.
+/// \return true if there is a sprite by that name.
+
+const bool CNullRenderer::Load(unsigned n, const char* name){
+  const auto it = m_mapSettings.find(name);
+
+  if(it == m_mapSettings.end()){
+    fprintf(stderr, "No sprite named %s\n", name);
+    return false;
+  } //if
+
+  if(n >= m_vecSprite.size())
+    m_vecSprite.resize(n + 1);
+
+  m_vecSprite[n] = it->second;
+  return true;
+} //Load
+
+/// Start counting a new frame. Nothing is bound at the start of a frame, so
+/// the first draw isn't a texture switch.
+
+void CNullRenderer::BeginFrame(){
+  m_cFrame = CRenderStats();
+  m_nTexture = -1;
+} //BeginFrame
+
+/// Finish counting a frame and add it to the totals.
+
+void CNullRenderer::EndFrame(){
+  m_cLastFrame = m_cFrame;
+  m_cTotal.Add(m_cFrame);
+  m_nFrames++;
+} //EndFrame
+
+/// Make a texture current, counting a texture switch if it isn't already.
+/// \param n Texture index.
+
+void CNullRenderer::Bind(int n){
+  if(n == m_nTexture)return;
+  if(m_nTexture != -1)m_cFrame.m_nTextureSwitches++;
+  m_nTexture = n;
+} //Bind
+
+/// Get a frame of a loaded sprite.
+/// \param n Sprite index.
+/// \param frame Frame number, clamped to the last frame.
+/// \return Pointer to the frame, or `nullptr` if the sprite isn't loaded.
+
+const CNullRenderer::CFrame* CNullRenderer::GetFrame(unsigned n, unsigned frame) const{
+  if(n >= m_vecSprite.size() || m_vecSprite[n].empty())return nullptr;
+  const CSprite& sprite = m_vecSprite[n]; //shorthand
+  return &sprite[std::min((size_t)frame, sprite.size() - 1)];
+} //GetFrame
+
+/// Count a sprite: a draw, a texture switch if it needs one, and the window
+/// pixels under its rectangle. A sprite that isn't loaded counts as a draw
+/// and nothing else.
+/// \param n Sprite index.
+/// \param frame Frame number.
+/// \param x Horizontal position of the center.
+/// \param y Vertical position of the center.
+/// \param xscale Horizontal scale.
+/// \param yscale Vertical scale.
+
+void CNullRenderer::DrawSprite(unsigned n, unsigned frame, float x, float y,
+  float xscale, float yscale)
+{
+  m_cFrame.m_nDraws++;
+
+  const CFrame* f = GetFrame(n, frame);
+  if(f == nullptr)return;
+
+  Bind(f->m_nTexture);
+
+  const float w = 0.5f*f->m_fWidth*fabsf(xscale); //half width
+  const float h = 0.5f*f->m_fHeight*fabsf(yscale); //half height
+  const float x0 = std::max(x - w, m_fCameraX - 0.5f*m_nWinWidth);
+  const float x1 = std::min(x + w, m_fCameraX + 0.5f*m_nWinWidth);
+  const float y0 = std::max(y - h, m_fCameraY - 0.5f*m_nWinHeight);
+  const float y1 = std::min(y + h, m_fCameraY + 0.5f*m_nWinHeight);
+
+  if(x1 > x0 && y1 > y0)
+    m_cFrame.m_fPixels += (double)(x1 - x0)*(y1 - y0);
+} //DrawSprite
+
+/// Count a bounding box as four draws of a line sprite. Lines are too thin
+/// to matter for overdraw.
+/// \param n Sprite index of the line sprite.
+
+void CNullRenderer::DrawBox(unsigned n){
+  m_cFrame.m_nBoxes++;
+  m_cFrame.m_nDraws += 4;
+
+  if(const CFrame* f = GetFrame(n, 0))
+    Bind(f->m_nTexture);
+} //DrawBox
+
+/// Count a text string, which is drawn from the font's texture.
+
+void CNullRenderer::DrawString(){
+  m_cFrame.m_nTexts++;
+  Bind(TEXT_TEXTURE);
+} //DrawString
+
+/// Reader function for the width of a sprite, which is the width of its
+/// first frame.
+/// \param n Sprite index.
+/// \return Width in pixels, or 0 if the sprite isn't loaded.
+
+const float CNullRenderer::Width(unsigned n) const{
+  const CFrame* f = GetFrame(n, 0);
+  return f? f->m_fWidth: 0.0f;
+} //Width
+
+/// Reader function for the height of a sprite, which is the height of its
+/// first frame.
+/// \param n Sprite index.
+/// \return Height in pixels, or 0 if the sprite isn't loaded.
+
+const float CNullRenderer::Height(unsigned n) const{
+  const CFrame* f = GetFrame(n, 0);
+  return f? f->m_fHeight: 0.0f;
+} //Height
+
+/// Reader function for the number of frames in a sprite.
+/// \param n Sprite index.
+/// \return Number of frames, or 0 if the sprite isn't loaded.
+
+const size_t CNullRenderer::NumFrames(unsigned n) const{
+  return n < m_vecSprite.size()? m_vecSprite[n].size(): 0;
+} //NumFrames
+
+/// Reader function for the window width.
+/// \return Width in pixels.
+
+const int CNullRenderer::GetWinWidth() const{
+  return m_nWinWidth;
+} //GetWinWidth
+
+/// Reader function for the window height.
+/// \return Height in pixels.
+
+const int CNullRenderer::GetWinHeight() const{
+  return m_nWinHeight;
+} //GetWinHeight
+
+/// Reader function for the number of textures, which is the number of
+/// different image files in the settings file.
+/// \return Number of textures.
+
+const size_t CNullRenderer::GetNumTextures() const{
+  return m_mapTexture.size();
+} //GetNumTextures
+
+/// Reader function for the number of frames counted so far.
+/// \return Number of frames.
+
+const size_t CNullRenderer::GetFrameCount() const{
+  return m_nFrames;
+} //GetFrameCount
+
+/// Reader function for the statistics of the last complete frame.
+/// \return Statistics.
+
+const CRenderStats& CNullRenderer::GetFrameStats() const{
+  return m_cLastFrame;
+} //GetFrameStats
+
+/// Reader function for the statistics of all complete frames.
+/// \return Statistics.
+
+const CRenderStats& CNullRenderer::GetTotalStats() const{
+  return m_cTotal;
+} //GetTotalStats
+
+/// Get the overdraw, the number of times that the average window pixel is
+/// drawn, from some statistics.
+/// \param s Statistics.
+/// \param frames Number of frames that the statistics cover.
+/// \return Covered pixels per window pixel per frame.
+
+const double CNullRenderer::GetOverdraw(const CRenderStats& s, size_t frames) const{
+  const double area = (double)m_nWinWidth*m_nWinHeight*std::max(frames, (size_t)1);
+  return area > 0.0? s.m_fPixels/area: 0.0;
+} //GetOverdraw
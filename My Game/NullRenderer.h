@@ -0,0 +1,146 @@
+/// \file NullRenderer.h
+/// \brief Interface for the null renderer CNullRenderer.
+
+#ifndef __L4RC_GAME_NULLRENDERER_H__
+#define __L4RC_GAME_NULLRENDERER_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// \brief Render statistics.
+///
+/// What a null renderer counted over a frame or a run.
+
+struct CRenderStats{
+  size_t m_nDraws = 0; ///< Sprites drawn, including bounding box lines.
+  size_t m_nTextureSwitches = 0; ///< Draws that change texture.
+  size_t m_nBoxes = 0; ///< Bounding boxes drawn.
+  size_t m_nTexts = 0; ///< Text strings drawn.
+  double m_fPixels = 0.0; ///< Window pixels covered by sprites, counted once per sprite.
+
+  void Add(const CRenderStats&); ///< Add another set of statistics.
+}; //CRenderStats
+
+/// \brief The null renderer.
+///
+/// The null renderer has the parts of the `LSpriteRenderer` interface that
+/// the game draws with, but instead of drawing anything it counts draw calls,
+/// texture switches, and the window pixels that the sprites cover, so that
+/// drawing can be measured without a GPU, for example on a Linux build
+/// machine. Sprite sizes and textures come from a settings file in the form
+/// of `gamesettings.xml`, with image sizes read from the PNG headers, so no
+/// image is decoded.
+///
+/// Each image file is taken to be a texture, so the frames of a sheet sprite
+/// share a texture and the frames of a sprite with one image per frame
+/// don't, and text is taken to be drawn from a texture of its own. A texture
+/// switch is a draw that uses a different texture from the draw before it in
+/// the same frame. Overdraw is estimated from each sprite's unrotated
+/// rectangle, clipped to the window around the camera, so it is exact for
+/// tiles and a slight overestimate for rotated sprites.
+///
+/// The functions that take engine types are templates, so that
+/// `LSpriteDesc2D`, `Vector2`, and `eSprite` work as they do with the
+/// sprite renderer, but so does anything with the same member names, which
+/// keeps this class free of the engine. `CRenderQueue::Submit()` takes one
+/// as it takes the sprite renderer.
+
+class CNullRenderer{
+  private:
+    /// \brief Frame.
+    ///
+    /// One frame of a sprite.
+
+    struct CFrame{
+      int m_nTexture = -1; ///< Texture index, or -1 if none.
+      float m_fWidth = 0.0f; ///< Width in pixels.
+      float m_fHeight = 0.0f; ///< Height in pixels.
+    }; //CFrame
+
+    typedef std::vector<CFrame> CSprite; ///< Frames of a sprite.
+
+    std::map<std::string, CSprite> m_mapSettings; ///< Sprites in the settings file by name.
+    std::map<std::string, int> m_mapTexture; ///< Texture index of each image file.
+    std::vector<CSprite> m_vecSprite; ///< Loaded sprites by sprite index.
+
+    int m_nWinWidth = 0; ///< Window width.
+    int m_nWinHeight = 0; ///< Window height.
+    float m_fCameraX = 0.0f; ///< Camera x coordinate, at the center of the window.
+    float m_fCameraY = 0.0f; ///< Camera y coordinate, at the center of the window.
+
+    int m_nTexture = -1; ///< Texture of the last draw this frame, or -1 if none.
+    CRenderStats m_cFrame; ///< Statistics for the frame being drawn.
+    CRenderStats m_cLastFrame; ///< Statistics for the last complete frame.
+    CRenderStats m_cTotal; ///< Statistics for all complete frames.
+    size_t m_nFrames = 0; ///< Number of complete frames.
+
+    const int GetTexture(const std::string&, float&, float&); ///< Texture for an image file.
+    void Bind(int); ///< Make a texture current.
+    const CFrame* GetFrame(unsigned, unsigned) const; ///< Frame of a loaded sprite.
+    void DrawSprite(unsigned, unsigned, float, float, float, float); ///< Count a sprite.
+    void DrawBox(unsigned); ///< Count a bounding box.
+    void DrawString(); ///< Count a text string.
+    const float Width(unsigned) const; ///< Width of a sprite.
+    const float Height(unsigned) const; ///< Height of a sprite.
+    const size_t NumFrames(unsigned) const; ///< Number of frames in a sprite.
+
+  public:
+    const bool LoadSettings(const std::string&); ///< Read a settings file.
+    const bool Load(unsigned, const char*); ///< Load a sprite.
+
+    void BeginFrame(); ///< Start counting a frame.
+    void EndFrame(); ///< Finish counting a frame.
+
+    template<class t> void Draw(const t*); ///< Draw a sprite.
+    template<class e, class b> void DrawBoundingBox(e, const b&); ///< Draw a bounding box.
+    template<class v> void DrawScreenText(const char*, const v&); ///< Draw text.
+    template<class v> void SetCameraPos(const v&); ///< Set the camera position.
+
+    template<class e> const float GetWidth(e n) const{return Width((unsigned)n);} ///< Width of a sprite.
+    template<class e> const float GetHeight(e n) const{return Height((unsigned)n);} ///< Height of a sprite.
+    template<class e> const size_t GetNumFrames(e n) const{return NumFrames((unsigned)n);} ///< Number of frames in a sprite.
+
+    const int GetWinWidth() const; ///< Window width.
+    const int GetWinHeight() const; ///< Window height.
+    const size_t GetNumTextures() const; ///< Number of textures.
+    const size_t GetFrameCount() const; ///< Number of complete frames.
+    const CRenderStats& GetFrameStats() const; ///< Statistics for the last frame.
+    const CRenderStats& GetTotalStats() const; ///< Statistics for all frames.
+    const double GetOverdraw(const CRenderStats&, size_t=1) const; ///< Covered pixels per window pixel.
+}; //CNullRenderer
+
+/// Count a sprite as the sprite renderer would draw it.
+/// \param pDesc Pointer to anything with the members of `LSpriteDesc2D`.
+
+template<class t> void CNullRenderer::Draw(const t* pDesc){
+  DrawSprite(pDesc->m_nSpriteIndex, pDesc->m_nCurrentFrame, pDesc->m_vPos.x,
+    pDesc->m_vPos.y, pDesc->m_fXScale, pDesc->m_fYScale);
+} //Draw
+
+/// Count a bounding box, which the sprite renderer draws as four lines.
+/// \param n Sprite index of the line sprite.
+/// \param box Bounding box, which is ignored.
+
+template<class e, class b> void CNullRenderer::DrawBoundingBox(e n, const b&){
+  DrawBox((unsigned)n);
+} //DrawBoundingBox
+
+/// Count a text string.
+/// \param s Text, which is ignored.
+/// \param pos Position in the window, which is ignored.
+
+template<class v> void CNullRenderer::DrawScreenText(const char*, const v&){
+  DrawString();
+} //DrawScreenText
+
+/// Set the camera position, which is the center of the window in world
+/// space.
+/// \param pos Anything with `x` and `y` members, such as a `Vector3`.
+
+template<class v> void CNullRenderer::SetCameraPos(const v& pos){
+  m_fCameraX = pos.x;
+  m_fCameraY = pos.y;
+} //SetCameraPos
+
+#endif //__L4RC_GAME_NULLRENDERER_H__
@@ -7,12 +7,17 @@
 #include "Particle.h"
 #include "ParticleEngine.h"
 #include "Helpers.h"
+#include "TileManager.h"
+#include "ObjectManager.h"
 
 /// ---------------------------------------------------------------------------
 /// Constructor
 /// ---------------------------------------------------------------------------
 CObject::CObject(eSprite t, const Vector2& p)
-    : LBaseObject(t, p)
+    : LBaseObject(t, p),
+      m_bStatic(true), m_bIsTarget(true), m_bIsBullet(false), m_bFast(false),
+      m_bAsleep(false), m_bMiddleRing(false), m_bDormant(false),
+      isFurniture(false)
 {
     m_fRoll = XM_PIDIV2;
     m_bIsTarget = false;
@@ -30,11 +35,8 @@ CObject::CObject(eSprite t, const Vector2& p)
     }
 
     // Compute collision radius
-    float w = m_pRenderer->GetWidth(t);
-    float h = m_pRenderer->GetHeight(t);
-    m_fRadius = std::max(w, h) / 2.0f;
-
-    m_pGunFireEvent = new LEventTimer(1.0f);
+    const Vector2& vSize = GetSpriteSize((UINT)t);
+    m_fRadius = std::max(vSize.x, vSize.y) / 2.0f;
 }
 
 /// ---------------------------------------------------------------------------
@@ -42,9 +44,48 @@ CObject::CObject(eSprite t, const Vector2& p)
 /// ---------------------------------------------------------------------------
 CObject::~CObject()
 {
-    delete m_pGunFireEvent;
 }
 
+/// Sprite sizes, filled in on first use so that objects created after the
+/// first of their kind do not have to query the renderer.
+
+Vector2 CObject::m_vSpriteSize[(UINT)eSprite::Size];
+
+/// Reader function for the width and height of a sprite, which are cached
+/// the first time that they are read from the renderer.
+/// \param t Sprite index.
+/// \return Width and height of the sprite.
+
+const Vector2& CObject::GetSpriteSize(UINT t){
+  Vector2& v = m_vSpriteSize[t];
+
+  if(v.x == 0.0f && v.y == 0.0f)
+    v = Vector2(m_pRenderer->GetWidth(t), m_pRenderer->GetHeight(t));
+
+  return v;
+} //GetSpriteSize
+
+/// Reinitialize an object taken from the projectile pool as though it had
+/// just been constructed with a given sprite and position. Nothing here
+/// allocates memory or asks the renderer for anything.
+/// \param t Sprite type.
+/// \param p Initial position.
+
+void CObject::Respawn(eSprite t, const Vector2& p){
+  m_nSpriteIndex = (UINT)t;
+  m_nCurrentFrame = 0;
+  m_vPos = m_vOldPos = p;
+  m_vVelocity = Vector2::Zero;
+  m_fRoll = XM_PIDIV2;
+  m_bDead = false;
+
+  m_bFast = false;
+  m_fTimeOfImpact = 1.0f;
+
+  const Vector2& vSize = GetSpriteSize((UINT)t);
+  m_fRadius = std::max(vSize.x, vSize.y)/2.0f;
+} //Respawn
+
 /// ---------------------------------------------------------------------------
 /// Base movement
 /// ---------------------------------------------------------------------------
@@ -54,19 +95,67 @@ CObject::~CObject()
         m_vPos += m_vVelocity * m_pTimer->GetFrameTime();
 } I'm not sure what move() is the intended behavior so I just commented out the first one*/
 void CObject::move(){
-  if(!m_bDead && !m_bStatic)
-    m_vPos += m_vVelocity*m_pTimer->GetFrameTime();
+  if(m_nMotion != UINT_MAX)return; //moved by the motion store
 
-  if (m_bIsBullet && m_fMaxLifeSpan > 0.0f) {
-      m_fTimeAlive += m_pTimer->GetFrameTime();
+  m_vOldPos = m_vPos;
+  m_fTimeOfImpact = 1.0f;
 
-      if (m_fTimeAlive >= m_fMaxLifeSpan) {
-          SetDead();
-      }
-  }
+  if(!m_bDead && !m_bStatic){
+    const Vector2 vDelta = m_vVelocity*m_pTimer->GetFrameTime();
 
+    if(m_bFast)
+      SweptMove(vDelta);
+    else m_vPos += vDelta;
+  } //if
 } //move
 
+/// Get the time step for an object whose `move()` function may not be
+/// called every frame. This is the frame time plus the time banked by the
+/// object manager for the frames that the object sat out in the middle ring
+/// of the activity bubble. The banked time is used up.
+/// \return Time step in seconds.
+
+const float CObject::GetStepTime(){
+  const float t = m_pTimer->GetFrameTime() + m_fBankedTime;
+  m_fBankedTime = 0.0f;
+  return t;
+} //GetStepTime
+
+/// Change sprite and frame, and if the object is animated, tell the animator,
+/// which owns the animation state, to play the new clip from that frame.
+/// Animated objects must change sprite or frame this way, not by setting
+/// `m_nSpriteIndex` or `m_nCurrentFrame` themselves.
+/// \param t Sprite index.
+/// \param f Frame number.
+
+void CObject::SetAnimation(UINT t, UINT f){
+  m_nSpriteIndex = t;
+  m_nCurrentFrame = f;
+
+  if(m_nAnim != UINT_MAX)
+    m_pObjectManager->GetAnimator().Play(m_nAnim, t, f);
+} //SetAnimation
+
+/// Move a fast object along a displacement, stopping at the first wall that
+/// it would otherwise tunnel through in a single frame. The time of impact is
+/// recorded so that the object-object sweep in `CObjectManager::NarrowPhase()`
+/// only considers the part of the path that the object actually travelled.
+/// \param vDelta Displacement for this frame.
+
+void CObject::SweptMove(const Vector2& vDelta){
+  BoundingSphere s(Vector3(m_vPos), m_fRadius);
+  Vector2 norm;
+  float t = 1.0f;
+
+  if(m_pTileManager->SweepWithWall(s, vDelta, t, norm)){
+    m_vPos += t*vDelta;
+    m_fTimeOfImpact = t;
+    CollisionResponse(norm, 0.0f);
+  } //if
+
+  else m_vPos += vDelta;
+} //SweptMove
+
 /// Ask the renderer to draw the sprite described in the sprite descriptor.
 /// Note that `CObject` is derived from `LBaseObject` which is inherited from
 /// `LSpriteDesc2D`. Therefore `LSpriteRenderer::Draw(const LSpriteDesc2D*)`
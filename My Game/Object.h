@@ -9,48 +9,64 @@
 #include "Component.h"
 #include "SpriteDesc.h"
 #include "BaseObject.h"
-#include "EventTimer.h"
+#include "Handle.h"
 
 class CObject :
     public CCommon,
     public LBaseObject
 {
     friend class CObjectManager;
+    friend class CMotionStore;
+    friend class CAnimator;
+    friend class CCollisionTable;
+    friend class CPositionSolver;
+    friend class CSpatialGrid;
 
 protected:
-
-    float m_fRadius = 0.0f;
-    float m_fSpeed = 0.0f;
-    float m_fRotSpeed = 0.0f;
-
-    /*
-    Vector2 m_vVelocity = Vector2(0, 0);
-    */
-    bool m_bStatic = true;
-    bool m_bIsTarget = true;
-    bool m_bIsBullet = false;
-    
-    Vector2 m_vVelocity; 
-    
-	
-
-    float m_fMaxLifeSpan = 0.0f;
-    float m_fTimeAlive = 0.0f;
-
-    LEventTimer* m_pGunFireEvent = nullptr;
+    //hot fields, touched every frame by the movement and collision passes
+
+    Vector2 m_vVelocity; ///< Velocity.
+    Vector2 m_vOldPos; ///< Position at the start of the frame.
+    float m_fRadius = 0.0f; ///< Bounding circle radius.
+    float m_fSpeed = 0.0f; ///< Speed.
+    float m_fTimeOfImpact = 1.0f; ///< Fraction of the last frame before first impact.
+    UINT m_nMotion = UINT_MAX; ///< Index into motion store, if registered.
+    UINT m_nAnim = UINT_MAX; ///< Index into animator, if registered.
+    UINT m_nLight = UINT_MAX; ///< Light source in the light grid, if it carries one.
+    eObjectKind m_eKind = eObjectKind::Other; ///< Kind of object.
+
+    bool m_bStatic: 1; ///< Doesn't get pushed around.
+    bool m_bIsTarget: 1; ///< Can be targeted.
+    bool m_bIsBullet: 1; ///< Is a projectile.
+    bool m_bFast: 1; ///< Use swept collision tests.
+    bool m_bAsleep: 1; ///< Skipped by the update and wall passes.
+    bool m_bMiddleRing: 1; ///< Updated at a reduced rate.
+    bool m_bDormant: 1; ///< Frozen until the player comes near.
+    bool isFurniture: 1; ///< Is furniture.
+
+    //cold fields, touched only by the object manager's bookkeeping
+
+    float m_fRestTime = 0.0f; ///< Seconds spent at rest while awake.
+    float m_fBankedTime = 0.0f; ///< Frame time skipped in the middle ring.
+    CHandle m_hPool; ///< Handle into projectile pool, null if not pooled.
+    CHandle m_hSelf; ///< Handle issued by the object manager.
+
+    static Vector2 m_vSpriteSize[(UINT)eSprite::Size]; ///< Cached sprite sizes.
+    static const Vector2& GetSpriteSize(UINT); ///< Get cached sprite size.
 
     virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr);
     virtual void DeathFX();
+    void SweptMove(const Vector2&); ///< Move with swept wall collision.
+    void SetAnimation(UINT, UINT=0); ///< Change sprite and frame.
+    const float GetStepTime(); ///< Time since last update.
     
 
   public:
-
-
-    bool isHealthBar = false;
-    bool isFurniture = false; ///< Is furniture
     CObject(eSprite, const Vector2&); ///< Constructor.
     virtual ~CObject(); ///< Destructor.
 
+    void Respawn(eSprite, const Vector2&); ///< Reinitialize a pooled object.
+
 
     virtual void Update(float dt) {}
 
@@ -71,6 +87,12 @@ protected:
 
     const Vector2& GetPos() const { return m_vPos; }
     void SetStatic(bool isStatic) { m_bStatic = isStatic; }
+    void SetFast(bool isFast) { m_bFast = isFast; }
+    const bool isFast() const { return m_bFast; }
+    const float GetTimeOfImpact() const { return m_fTimeOfImpact; }
+    const eObjectKind GetKind() const { return m_eKind; }
+    const bool IsAsleep() const { return m_bAsleep; }
+    const CHandle& GetHandle() const { return m_hSelf; }
 }; 
 
 #endif
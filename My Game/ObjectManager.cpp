@@ -1,6 +1,8 @@
 /// \file ObjectManager.cpp
 /// \brief Code for the the object manager class CObjectManager.
 
+#include <algorithm>
+
 #include "ObjectManager.h"
 #include "ComponentIncludes.h"
 
@@ -14,14 +16,55 @@
 #include "TileManager.h"
 #include "Furniture.h"
 #include "Enemy.h"
-#include "HealthBar.h"
 #include "BulletEnemy.h"
 #include "StationaryTurret.h"
+#include "CollisionTable.h"
+#include "Log.h"
+#include "RenderQueue.h"
+
+
+
+/// Factory function for the projectile pool.
+/// \return Pointer to a new player projectile.
+
+static CBullet* NewBullet(){
+  return new CBullet(eSprite::Bullet, Vector2::Zero);
+} //NewBullet
+
+/// Factory function for the enemy bullet pool.
+/// \return Pointer to a new enemy bullet.
+
+static CBulletEnemy* NewEnemyBullet(){
+  return new CBulletEnemy(eSprite::bulletenemy, Vector2::Zero);
+} //NewEnemyBullet
+
+/// Preallocate the projectile pools and enough room in the object array and
+/// handle table to hold them, so that firing does not allocate memory until
+/// the pools run dry. The renderer must have loaded the projectile sprites
+/// before this is called.
 
+CObjectManager::CObjectManager(){
+  m_cBulletPool.Reserve(PROJECTILE_POOL_SIZE, NewBullet);
+  m_cEnemyBulletPool.Reserve(PROJECTILE_POOL_SIZE, NewEnemyBullet);
+  m_vecObjects.reserve(4*PROJECTILE_POOL_SIZE);
+  m_cHandles.reserve(4*PROJECTILE_POOL_SIZE);
+  m_cMotion.reserve(2*PROJECTILE_POOL_SIZE);
+  m_cAnimator.reserve(PROJECTILE_POOL_SIZE);
+  m_cSolver.reserve(PROJECTILE_POOL_SIZE);
+  m_cRenderQueue.reserve(8*PROJECTILE_POOL_SIZE);
+  m_vecBullets.reserve(PROJECTILE_POOL_SIZE);
+  m_vecEnemyBullets.reserve(PROJECTILE_POOL_SIZE);
+} //constructor
 
+/// Return the pooled projectiles to their pools, since the pools own them
+/// and will delete them, and delete everything else.
 
-/// Create an object and put a pointer to it at the back of the object list
-/// `m_stdObjectList`, which it inherits from `LBaseObjectManager`.
+CObjectManager::~CObjectManager(){
+  clear();
+} //destructor
+
+/// Create an object and put a pointer to it at the back of the object array.
+/// Projectiles come from the projectile pools, everything else is allocated.
 /// \param t Sprite type.
 /// \param pos Initial position.
 /// \return Pointer to the object created.
@@ -37,149 +80,907 @@ CObject* CObjectManager::create(eSprite t, const Vector2& pos) {
         ) {
         
         pObj = new CPlayer(t, pos);
-        m_pPlayer = (CPlayer*)pObj;  
     }
     
     else { 
         switch (t) { 
         case eSprite::Turret:  pObj = new CTurret(pos); break;
         case eSprite::stationaryturret:pObj = new CStationaryTurret(pos); break;
-        case eSprite::bulletenemy: pObj = new CBulletEnemy(eSprite::bulletenemy, pos); break;
         case eSprite::ZombieStandDown: pObj = new CZombie(pos); break;
-        case eSprite::Bullet:  pObj = new CBullet(eSprite::Bullet, pos); break;
-        //case eSprite::Bullet2: pObj = new CBullet(eSprite::Bullet2, pos); break;
-        case eSprite::Fireball: pObj = new CBullet(eSprite::Fireball, pos); break;
-        case eSprite::sword: pObj = new CBullet(eSprite::sword, pos); break;
-        case eSprite::greatsword: pObj = new CBullet(eSprite::greatsword, pos); break;
-        case eSprite::dagger: pObj = new CBullet(eSprite::dagger, pos); break;
+        case eSprite::bulletenemy:
+        case eSprite::Bullet:
+        case eSprite::Fireball:
+        case eSprite::sword:
+        case eSprite::greatsword:
+        case eSprite::dagger: return CreateProjectile(t, pos);
         case eSprite::shield: pObj = new CObject(eSprite::shield, pos); break;
         default: pObj = new CObject(t, pos); break;
 
         } 
     }
 
-    m_stdObjectList.push_back(pObj); 
+    if (t == eSprite::shield)
+        pObj->m_eKind = eObjectKind::Shield;
+
+    m_nAllocations++;
+    Register(pObj);
     return pObj;
 } 
 
-CObject* CObjectManager::createFurniture(eSprite t, const Vector2& pos, char type) {
-    CObject* pObj = nullptr;
-    if (type == 'H')
-    {
-		pObj = new CHealthBar(pos);
-		pObj->SetSprite(eSprite::HealthBar);
-		m_stdObjectList.push_back(pObj); //push pointer onto object list
-		return pObj; //return pointer to created object
-    }
+/// Put a pointer to an object at the back of the object array, issue it a
+/// handle, put it into the spatial grid and the list for its kind, register
+/// it with the animator if it is a kind that animates, give it a light
+/// source if it carries one, and count it.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::Register(CObject* pObj){
+  m_vecObjects.push_back(pObj);
+  pObj->m_hSelf = m_cHandles.Insert(pObj);
+  m_cGrid.Insert(pObj);
+  m_nCount[(UINT)pObj->m_eKind]++;
+  AddToKindList(pObj);
 
+  switch(pObj->m_eKind){
+    case eObjectKind::Player:
+    case eObjectKind::Zombie:
+    case eObjectKind::Enemy: m_cAnimator.Add(pObj); break;
+    default: break;
+  } //switch
 
-    pObj = new CFurniture(pos);
+  CLightGrid& lights = m_pTileManager->GetLightGrid(); //shorthand
+
+  if(pObj->m_eKind == eObjectKind::Player) //lantern
+    pObj->m_nLight = lights.Add(pObj->m_vPos, LIGHT_PLAYER);
+
+  else if(pObj->m_nSpriteIndex == (UINT)eSprite::Fireball)
+    pObj->m_nLight = lights.Add(pObj->m_vPos, LIGHT_FIREBALL);
+} //Register
+
+/// Put a pointer to an object into the list for its kind, so that the
+/// per-frame loops can call its member functions without virtual dispatch.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::AddToKindList(CObject* pObj){
+  switch(pObj->m_eKind){
+    case eObjectKind::Player: m_hPlayer = pObj->m_hSelf; break;
+    case eObjectKind::Bullet: m_vecBullets.push_back((CBullet*)pObj); break;
+    case eObjectKind::EnemyBullet: m_vecEnemyBullets.push_back((CBulletEnemy*)pObj); break;
+    case eObjectKind::Zombie: m_vecZombies.push_back((CZombie*)pObj); break;
+    case eObjectKind::Turret: m_vecTurrets.push_back((CTurret*)pObj); break;
+    case eObjectKind::StationaryTurret: m_vecStationaryTurrets.push_back((CStationaryTurret*)pObj); break;
+    case eObjectKind::Enemy: m_vecEnemies.push_back((CEnemy*)pObj); break;
+
+    case eObjectKind::Furniture: m_vecFurniture.push_back(pObj); break;
+
+    default: m_vecOther.push_back(pObj); break;
+  } //switch
+} //AddToKindList
+
+/// Put to sleep the objects in a kind list that have been at rest for long
+/// enough while the player is out of range. An object is at rest if its
+/// `move()` function left it where it started the frame. Sleeping objects
+/// are moved from their kind list to the sleeping list, so they cost nothing
+/// in the update and wall passes until something wakes them.
+/// \param v List of objects of one kind.
+/// \param dt Frame time in seconds.
+
+template<class t> void CObjectManager::Sleep(std::vector<t*>& v, float dt){
+  const CPlayer* pPlayer = GetPlayer();
+  const float r2 = SLEEP_WAKE_RADIUS*SLEEP_WAKE_RADIUS;
+  size_t i = 0;
+
+  while(i < v.size()){
+    CObject* pObj = v[i];
+
+    if(pObj->m_vPos == pObj->m_vOldPos)
+      pObj->m_fRestTime += dt;
+    else pObj->m_fRestTime = 0.0f;
+
+    const bool bNear = pPlayer &&
+      Vector2::DistanceSquared(pObj->m_vPos, pPlayer->m_vPos) < r2;
+
+    if(pObj->m_fRestTime >= SLEEP_DELAY && !bNear && !pObj->m_bDead){
+      pObj->m_bAsleep = true;
+      m_vecAsleep.push_back(pObj);
+      v[i] = v.back();
+      v.pop_back();
+    } //if
+
+    else i++;
+  } //while
+} //Sleep
+
+/// Wake a sleeping or dormant object and put it back into the list for its
+/// kind.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::Wake(CObject* pObj){
+  if(pObj->m_bDormant){
+    for(size_t i=0; i<m_vecDormant.size(); i++)
+      if(m_vecDormant[i].m_hObject.m_nIndex == pObj->m_hSelf.m_nIndex){
+        Revive(i);
+        return;
+      } //if
+  } //if
+
+  if(!pObj->m_bAsleep)return;
+
+  auto i = std::find(m_vecAsleep.begin(), m_vecAsleep.end(), pObj);
+  *i = m_vecAsleep.back();
+  m_vecAsleep.pop_back();
+
+  pObj->m_bAsleep = false;
+  pObj->m_fRestTime = 0.0f;
+  AddToKindList(pObj);
+} //Wake
+
+/// Wake the sleeping objects that the player has come near. This is only
+/// done every `WAKE_CHECK_INTERVAL` seconds, which is short enough that the
+/// player can't get much closer than `SLEEP_WAKE_RADIUS` in between.
+
+void CObjectManager::WakeNearPlayer(){
+  const CPlayer* pPlayer = GetPlayer();
+  if(pPlayer == nullptr)return;
+
+  const float r2 = SLEEP_WAKE_RADIUS*SLEEP_WAKE_RADIUS;
+  size_t i = 0;
+
+  while(i < m_vecAsleep.size()){
+    CObject* pObj = m_vecAsleep[i];
+
+    if(Vector2::DistanceSquared(pObj->m_vPos, pPlayer->m_vPos) < r2)
+      Wake(pObj); //moves the last sleeper into slot i
+    else i++;
+  } //while
+} //WakeNearPlayer
+
+/// Update the activity bubble around the player. Dormant objects that are
+/// back within `DORMANT_RADIUS` of the player are revived, then every enemy
+/// in a kind list is either marked as being in the inner region or the
+/// middle ring, or made dormant if it is too far away. Dormant objects are
+/// taken out of their kind lists and kept in a compact list of positions and
+/// handles, so they cost nothing per frame except for this check, which is
+/// only done every `WAKE_CHECK_INTERVAL` seconds. Sleeping objects are left
+/// alone.
+
+void CObjectManager::UpdateBubble(){
+  const CPlayer* pPlayer = GetPlayer();
+  if(pPlayer == nullptr)return;
+
+  const Vector2& vCenter = pPlayer->m_vPos;
+  const float r2 = DORMANT_RADIUS*DORMANT_RADIUS;
+  size_t i = 0;
+
+  while(i < m_vecDormant.size())
+    if(Vector2::DistanceSquared(m_vecDormant[i].m_vPos, vCenter) < r2)
+      Revive(i); //moves the last dormant object into slot i
+    else i++;
+
+  Classify(m_vecZombies, vCenter);
+  Classify(m_vecTurrets, vCenter);
+  Classify(m_vecStationaryTurrets, vCenter);
+  Classify(m_vecEnemies, vCenter);
+} //UpdateBubble
+
+/// Find the activity bubble region of each object in a kind list, moving
+/// those outside it to the dormant list.
+/// \param v List of objects of one kind.
+/// \param vCenter Center of the activity bubble.
+
+template<class t> void CObjectManager::Classify(std::vector<t*>& v,
+  const Vector2& vCenter)
+{
+  const float r2Active = ACTIVE_RADIUS*ACTIVE_RADIUS;
+  const float r2Dormant = DORMANT_RADIUS*DORMANT_RADIUS;
+  size_t i = 0;
+
+  while(i < v.size()){
+    CObject* pObj = v[i];
+    const float d2 = Vector2::DistanceSquared(pObj->m_vPos, vCenter);
+
+    if(d2 >= r2Dormant && !pObj->m_bDead){
+      pObj->m_bDormant = true;
+      pObj->m_bMiddleRing = false;
+      pObj->m_fBankedTime = 0.0f;
+      m_vecDormant.push_back({pObj->m_vPos, pObj->m_hSelf});
+      v[i] = v.back();
+      v.pop_back();
+    } //if
+
+    else{
+      pObj->m_bMiddleRing = d2 >= r2Active;
+      i++;
+    } //else
+  } //while
+} //Classify
+
+/// Take an object off the dormant list and put it back into the list for its
+/// kind. Time does not pass for dormant objects, so nothing is banked.
+/// \param i Index into the dormant list.
+
+void CObjectManager::Revive(size_t i){
+  CObject* pObj = Get(m_vecDormant[i].m_hObject);
+
+  m_vecDormant[i] = m_vecDormant.back();
+  m_vecDormant.pop_back();
+
+  if(pObj != nullptr){
+    pObj->m_bDormant = false;
+    AddToKindList(pObj);
+  } //if
+} //Revive
+
+/// Decide whether an object's `move()` function is to be called this frame.
+/// Objects in the middle ring of the activity bubble are only moved every
+/// `MIDDLE_RING_PERIOD` frames, staggered by handle index so that they don't
+/// all come due on the same frame.
+/// \param pObj Pointer to an object.
+/// \return true if the object is to be moved this frame.
+
+const bool CObjectManager::DueThisFrame(const CObject* pObj) const{
+  return !pObj->m_bMiddleRing ||
+    (pObj->m_hSelf.m_nIndex + m_nFrame)%MIDDLE_RING_PERIOD == 0;
+} //DueThisFrame
+
+/// Remove the pointers to dead objects from the kind lists. This must be
+/// done before the dead objects are deleted or recycled. The order of the
+/// objects in a kind list doesn't matter, so each dead one is overwritten by
+/// the last one in the list.
+
+void CObjectManager::RemoveDeadFromKindLists(){
+  auto cull = [](auto& v){
+    size_t i = 0;
+
+    while(i < v.size())
+      if(v[i]->m_bDead){
+        v[i] = v.back();
+        v.pop_back();
+      } //if
+      else i++;
+  }; //cull
+
+  cull(m_vecBullets);
+  cull(m_vecEnemyBullets);
+  cull(m_vecZombies);
+  cull(m_vecTurrets);
+  cull(m_vecStationaryTurrets);
+  cull(m_vecFurniture);
+  cull(m_vecOther);
+  cull(m_vecEnemies);
+  cull(m_vecAsleep);
+
+  size_t i = 0;
+
+  while(i < m_vecDormant.size()){ //in case a dormant object was killed
+    const CObject* pObj = Get(m_vecDormant[i].m_hObject);
+
+    if(pObj == nullptr || pObj->m_bDead){
+      m_vecDormant[i] = m_vecDormant.back();
+      m_vecDormant.pop_back();
+    } //if
+    else i++;
+  } //while
+} //RemoveDeadFromKindLists
+
+/// Take a projectile from the appropriate pool, reinitialize it, and put it
+/// at the back of the object array.
+/// \param t Sprite type of projectile.
+/// \param pos Initial position.
+/// \return Pointer to the projectile.
+
+CObject* CObjectManager::CreateProjectile(eSprite t, const Vector2& pos){
+  CObject* pObj = nullptr;
+  CHandle h;
+
+  if(t == eSprite::bulletenemy){
+    h = m_cEnemyBulletPool.Acquire(NewEnemyBullet);
+    pObj = m_cEnemyBulletPool.Get(h);
+  } //if
+
+  else{
+    h = m_cBulletPool.Acquire(NewBullet);
+    pObj = m_cBulletPool.Get(h);
+  } //else
+
+  pObj->Respawn(t, pos);
+  pObj->m_hPool = h;
+  m_cMotion.Add(pObj);
+  Register(pObj);
+
+  return pObj;
+} //CreateProjectile
+
+/// Return a projectile to its pool and unregister it from the motion store.
+/// The caller is responsible for removing it from the object array.
+/// \param pObj Pointer to the projectile.
+
+void CObjectManager::ReleaseProjectile(CObject* pObj){
+  if(pObj->m_nSpriteIndex == (UINT)eSprite::bulletenemy)
+    m_cEnemyBulletPool.Release(pObj->m_hPool);
+  else m_cBulletPool.Release(pObj->m_hPool);
+
+  pObj->m_hPool.Reset();
+  m_cMotion.Remove(pObj);
+} //ReleaseProjectile
+
+CObject* CObjectManager::createFurniture(eSprite t, const Vector2& pos, char type) {
+    CObject* pObj = new CFurniture(pos);
     pObj->SetSprite(t);
 	pObj->SetFrame(t, type);
 
-    m_stdObjectList.push_back(pObj); //push pointer onto object list
+    m_nAllocations++;
+    Register(pObj); //push pointer onto object array
     return pObj; //return pointer to created object
 } //create furniture
 
 
 
-/// Draw the tiled background and the objects in the object list.
+/// Make room in the object array, the handle table, and the sprite size
+/// cache for a batch of new objects, so that creating them doesn't
+/// reallocate storage part way through.
+/// \param n Number of new objects.
+
+void CObjectManager::ReserveSpawn(size_t n){
+  m_vecObjects.reserve(m_vecObjects.size() + n);
+  m_cHandles.reserve(m_vecObjects.size() + n);
+} //ReserveSpawn
+
+/// Create a patrolling enemy at each position in a spawn table and register
+/// it, with a patrol path that runs `PATROL_DISTANCE` to the right of its
+/// spawn point and back. Storage is reserved once for the whole table and
+/// the enemy type's sprite size is cached by the first constructor call, so
+/// the loop does nothing but construct and register objects.
+/// \param v Kind list for this type of enemy.
+/// \param vecPos Spawn positions.
+
+template<class t> void CObjectManager::SpawnPatrols(std::vector<t*>& v,
+  const std::vector<Vector2>& vecPos)
+{
+  ReserveSpawn(vecPos.size());
+  v.reserve(v.size() + vecPos.size());
+
+  std::vector<Vector2> path(2); //reused for every enemy
+
+  for(const Vector2& pos: vecPos){
+    t* p = new t(pos);
+    path[0] = pos;
+    path[1] = pos + Vector2(PATROL_DISTANCE, 0.0f);
+    p->InitializePatrol(path);
+    Register(p);
+  } //for
+
+  m_nAllocations += vecPos.size();
+} //SpawnPatrols
+
+/// Create a zombie at each position in a spawn table.
+/// \param vecPos Spawn positions.
+
+void CObjectManager::SpawnZombies(const std::vector<Vector2>& vecPos){
+  SpawnPatrols(m_vecZombies, vecPos);
+} //SpawnZombies
+
+/// Create a moving turret at each position in a spawn table.
+/// \param vecPos Spawn positions.
+
+void CObjectManager::SpawnTurrets(const std::vector<Vector2>& vecPos){
+  SpawnPatrols(m_vecTurrets, vecPos);
+} //SpawnTurrets
+
+/// Create a stationary turret at each position in a spawn table.
+/// \param vecPos Spawn positions.
+
+void CObjectManager::SpawnStationaryTurrets(const std::vector<Vector2>& vecPos){
+  ReserveSpawn(vecPos.size());
+  m_vecStationaryTurrets.reserve(m_vecStationaryTurrets.size() + vecPos.size());
+
+  for(const Vector2& pos: vecPos)
+    Register(new CStationaryTurret(pos));
+
+  m_nAllocations += vecPos.size();
+} //SpawnStationaryTurrets
+
+/// Create a piece of furniture for each entry in a spawn table. The type of
+/// an entry selects the frame of the furniture sprite.
+/// \param v Furniture spawn table.
+
+void CObjectManager::SpawnFurniture(const std::vector<CTileManager::furniture>& v){
+  ReserveSpawn(v.size());
+  m_vecFurniture.reserve(m_vecFurniture.size() + v.size());
+
+  for(const CTileManager::furniture& f: v){
+    CObject* pObj = new CFurniture(f.location);
+    pObj->SetSprite(eSprite::Furniture);
+    pObj->SetFrame(eSprite::Furniture, f.type);
+    Register(pObj);
+  } //for
+
+  m_nAllocations += v.size();
+} //SpawnFurniture
+
+/// Get the layer that an object is drawn in.
+/// \param pObj Pointer to an object.
+/// \return Render layer.
+
+const eRenderLayer CObjectManager::GetLayer(const CObject* pObj){
+  switch(pObj->m_eKind){
+    case eObjectKind::Furniture:   return eRenderLayer::Furniture;
+    case eObjectKind::Bullet:
+    case eObjectKind::EnemyBullet: return eRenderLayer::Projectiles;
+    case eObjectKind::Shield:      return eRenderLayer::Overlay;
+    default:                       return eRenderLayer::Characters;
+  } //switch
+} //GetLayer
+
+/// Draw the tiled background and the live objects near the camera in one
+/// pass. The tiles and the objects that the spatial grid finds near the
+/// window go into the render queue, with each one tested against the window
+/// widened by its radius, and the queue sorts them by layer and texture and
+/// submits them to the renderer. Objects far from the camera are never
+/// visited. The wall bounding boxes, if required, are drawn on top.
 
 void CObjectManager::draw(){
-    for (CObject* pObj : m_stdObjectList) {
-        std::cout << "[Draw] Obj @" << pObj
-            << " | Sprite: " << pObj->m_nSpriteIndex
-            << " | Dead: " << pObj->m_bDead << std::endl;
+  m_cRenderQueue.clear();
+  m_pTileManager->Draw(eSprite::Tile, m_cRenderQueue); //tiled background
 
-        if (!pObj->m_bDead)
-            pObj->draw(); // normal draw call
-    }
+  const Vector2 vCamera = m_pRenderer->GetCameraPos(); //center of window
+  const Vector2 vHalf(0.5f*m_nWinWidth, 0.5f*m_nWinHeight); //half window size
+
+  m_cGrid.Query(vCamera - vHalf, vCamera + vHalf, [&](CObject* pObj){
+    LOG(Trace, Render, "draw", "obj", (const void*)pObj,
+      "sprite", pObj->m_nSpriteIndex, "dead", pObj->m_bDead);
+
+    if(pObj->m_bDead)return;
+
+    const Vector2 d = pObj->m_vPos - vCamera; //offset from center of window
+    const float r = pObj->m_fRadius;
 
+    if(fabsf(d.x) <= vHalf.x + r && fabsf(d.y) <= vHalf.y + r) //on screen
+      m_cRenderQueue.Add(*pObj, GetLayer(pObj));
+  }); //Query
 
-  m_pTileManager->Draw(eSprite::Tile); //draw tiled background
+  m_cRenderQueue.Submit(m_pRenderer);
 
   if(m_bDrawAABBs)
     m_pTileManager->DrawBoundingBoxes(eSprite::Line); //draw AABBs
-  for (CObject* pObj : m_stdObjectList)
-  {
-      if (pObj->isHealthBar && m_pPlayer) {
-          const UINT spriteIndex = pObj->m_nSpriteIndex;
-          const size_t numFrames = m_pRenderer->GetNumFrames(spriteIndex);
-          if (numFrames == 0) continue; // nothing loaded
-
-          // Replace these with getters on CPlayer (add if necessary)
-          const float health = (float)m_pPlayer->GetHealth();        // implement GetHealth()
-          const float maxHealth = (float)m_pPlayer->GetMaxHealth();  // implement GetMaxHealth()
-          const float ratio = health / maxHealth;
-
-          int frame = (int)floor(ratio * 100);
-          frame -= frame % 5;
-          frame /= 5;
-
-		  if (frame < 0) frame = 0;
-
-          pObj->m_nCurrentFrame = frame;
-
-          // position above player in sprite units (use tile/sprite extents, not 1.0f)
-          pObj->m_vPos = m_pPlayer->m_vPos - Vector2(0.0f, -m_pRenderer->GetHeight(m_pPlayer->m_nSpriteIndex) * 0.5f - 10.0f);
-      }
-  }
-  LBaseObjectManager::draw();
 } //draw
 
-/// Perform collision detection and response for each object with the world
-/// edges and for all objects with another object, making sure that each pair
-/// of objects is processed only once.
+/// Reader function for the render queue, which after `draw()` holds the
+/// commands for the last frame drawn.
+/// \return Reference to the render queue.
+
+const CRenderQueue& CObjectManager::GetRenderQueue() const{
+  return m_cRenderQueue;
+} //GetRenderQueue
+
+/// Reader function for the spatial grid, for finding the objects near a
+/// place without going through them all.
+/// \return Reference to the spatial grid.
+
+const CSpatialGrid& CObjectManager::GetGrid() const{
+  return m_cGrid;
+} //GetGrid
+
+/// Reader function for the animator, which animated objects tell when they
+/// change clip.
+/// \return Reference to the animator.
+
+CAnimator& CObjectManager::GetAnimator(){
+  return m_cAnimator;
+} //GetAnimator
+
+/// Move all objects, then do collision detection and response, and finally
+/// get rid of the objects that died this frame. Objects registered in the
+/// motion store are moved there in bulk before the others. The rest are
+/// moved one kind at a time with the kind's own `move()` function called
+/// directly, so there is no virtual dispatch and the branches in each loop
+/// are the same for every iteration. Furniture doesn't move, and sleeping
+/// and dormant enemies aren't in their kind lists, so they don't move
+/// either. Enemies in the middle ring of the activity bubble only move on
+/// some frames and bank the time in between. Enemies that come to rest are
+/// put to sleep after they move. Once collisions have been dealt with, the
+/// animator advances every animated object's frame in one pass. Finally,
+/// objects that may have moved are moved to their new cells in the spatial
+/// grid.
+
+void CObjectManager::move(){
+  const float dt = m_pTimer->GetFrameTime();
+  const float t = m_pTimer->GetTime();
+
+  if(t >= m_fNextWakeCheck){
+    m_fNextWakeCheck = t + WAKE_CHECK_INTERVAL;
+    WakeNearPlayer();
+    UpdateBubble();
+  } //if
+
+  m_nFrame++;
+
+  m_cMotion.Integrate(dt);
+  m_cMotion.WriteBack();
+
+  if(CPlayer* pPlayer = GetPlayer())
+    pPlayer->CPlayer::move();
+
+  for(CZombie* p: m_vecZombies)
+    if(DueThisFrame(p)){
+      p->m_vOldPos = p->m_vPos;
+      p->CZombie::move();
+    } //if
+    else p->m_fBankedTime += dt;
+
+  for(CTurret* p: m_vecTurrets)
+    if(DueThisFrame(p)){
+      p->m_vOldPos = p->m_vPos;
+      p->CTurret::move();
+    } //if
+    else p->m_fBankedTime += dt;
+
+  for(CStationaryTurret* p: m_vecStationaryTurrets)
+    if(DueThisFrame(p))
+      p->CStationaryTurret::move();
+
+  for(CObject* p: m_vecEnemies)
+    p->CObject::move();
+
+  for(CObject* p: m_vecOther)
+    p->CObject::move();
+
+  Sleep(m_vecZombies, dt);
+  Sleep(m_vecTurrets, dt);
+  Sleep(m_vecEnemies, dt);
+
+  BroadPhase();
+  m_cAnimator.Advance(dt);
+  CullDeadObjects();
+  UpdateGrid();
+  UpdateLights(dt);
+} //move
+
+/// Remove the dead objects from the object array in a single pass that
+/// moves the last object into each dead object's slot, so the array stays
+/// contiguous. The order of the array doesn't matter, since objects are
+/// found for drawing and collision through the spatial grid and drawn in
+/// the order that the render queue sorts them into. Each dead object's
+/// handle is invalidated, it is unregistered from the animator, and its
+/// light source, if any, is removed, then pooled projectiles go back to
+/// their pools and everything else is deleted.
+
+void CObjectManager::CullDeadObjects(){
+  RemoveDeadFromKindLists();
+
+  size_t i = 0;
+
+  while(i < m_vecObjects.size()){
+    CObject* pObj = m_vecObjects[i];
+
+    if(!pObj->m_bDead){
+      i++;
+      continue;
+    } //if
+
+    m_vecObjects[i] = m_vecObjects.back();
+    m_vecObjects.pop_back();
+
+    m_nCount[(UINT)pObj->m_eKind]--;
+    m_cGrid.Remove(pObj);
+    m_cHandles.Erase(pObj->m_hSelf);
+    pObj->m_hSelf.Reset();
+    m_cAnimator.Remove(pObj);
+
+    if(pObj->m_nLight != UINT_MAX){
+      m_pTileManager->GetLightGrid().Remove(pObj->m_nLight);
+      pObj->m_nLight = UINT_MAX;
+    } //if
+
+    if(!pObj->m_hPool.IsNull())
+      ReleaseProjectile(pObj);
+    else delete pObj;
+  } //while
+} //CullDeadObjects
+
+/// Move each object that may have moved this frame to the spatial grid cell
+/// for its new position. That is everything in the kind lists that moves,
+/// plus sleeping enemies, which the position solver may have pushed.
+/// Furniture, stationary turrets, and dormant enemies stay put, so they
+/// aren't visited.
+
+void CObjectManager::UpdateGrid(){
+  if(CPlayer* pPlayer = GetPlayer())
+    m_cGrid.Update(pPlayer);
+
+  auto update = [&](const auto& v){
+    for(CObject* p: v)
+      m_cGrid.Update(p);
+  }; //update
+
+  update(m_vecBullets);
+  update(m_vecEnemyBullets);
+  update(m_vecZombies);
+  update(m_vecTurrets);
+  update(m_vecEnemies);
+  update(m_vecOther);
+  update(m_vecAsleep);
+} //UpdateGrid
+
+/// Move the light sources carried by the player and by fireballs to where
+/// their objects are now, then have the light grid bring the light levels
+/// up to date. A source only costs anything when it moves to another tile.
+/// \param dt Frame time in seconds, for muzzle flashes to fade out.
+
+void CObjectManager::UpdateLights(float dt){
+  CLightGrid& lights = m_pTileManager->GetLightGrid(); //shorthand
+
+  if(CPlayer* pPlayer = GetPlayer())
+    lights.Move(pPlayer->m_nLight, pPlayer->m_vPos);
+
+  for(CBullet* p: m_vecBullets)
+    if(p->m_nLight != UINT_MAX)
+      lights.Move(p->m_nLight, p->m_vPos);
+
+  lights.Update(dt);
+} //UpdateLights
+
+/// Return the pooled projectiles to their pools, delete the rest of the
+/// objects, and invalidate every handle issued so far. The spatial grid is
+/// fitted to the world, so load the map first.
+
+void CObjectManager::clear(){
+  m_cAnimator.clear();
+
+  for(CObject* pObj: m_vecObjects){
+    pObj->m_hSelf.Reset();
+    pObj->m_nLight = UINT_MAX; //the light grid is reset with the map
+
+    if(!pObj->m_hPool.IsNull())
+      ReleaseProjectile(pObj);
+    else delete pObj;
+  } //for
+
+  m_vecObjects.clear();
+  m_cHandles.clear();
+  m_cGrid.Resize(m_vWorldSize);
+  m_hPlayer.Reset();
+
+  m_vecEnemies.clear();
+  m_vecBullets.clear();
+  m_vecEnemyBullets.clear();
+  m_vecZombies.clear();
+  m_vecTurrets.clear();
+  m_vecStationaryTurrets.clear();
+  m_vecFurniture.clear();
+  m_vecOther.clear();
+  m_vecAsleep.clear();
+  m_vecDormant.clear();
+
+  for(size_t& n: m_nCount)
+    n = 0;
+} //clear
+
+/// Resolve a handle issued by this object manager. Use this instead of
+/// keeping a pointer to an object that may die.
+/// \param h Handle to an object.
+/// \return Pointer to the object, or `nullptr` if it has been culled.
+
+CObject* CObjectManager::Get(const CHandle& h) const{
+  return m_cHandles.Get(h);
+} //Get
+
+/// Reader function for the player character. The player counts as gone as
+/// soon as it dies, not just once it has been culled, so that nothing chases
+/// or targets a corpse for the rest of the frame.
+/// \return Pointer to the player, or `nullptr` if there is no live player.
+
+CPlayer* CObjectManager::GetPlayer() const{
+  CObject* pObj = m_cHandles.Get(m_hPlayer);
+  return (pObj == nullptr || pObj->m_bDead)? nullptr: (CPlayer*)pObj;
+} //GetPlayer
+
+/// Reader function for the number of game objects allocated on the heap so
+/// far, including those allocated by the projectile pools.
+/// \return Number of object allocations.
+
+const size_t CObjectManager::GetNumAllocations() const{
+  return m_nAllocations + m_cBulletPool.GetNumAllocations() +
+    m_cEnemyBulletPool.GetNumAllocations();
+} //GetNumAllocations
+
+/// Reader function for whether an object looks for collisions of its own in
+/// the broad phase, which depends on its kind and whether it is moving.
+/// Sleeping and dormant objects, stationary turrets, and furniture don't, so
+/// a pair of them is never tested, but a moving object can still collide
+/// with them.
+/// \param pObj Pointer to an object.
+/// \return true if it looks for collisions.
+
+const bool CObjectManager::IsActive(const CObject* pObj){
+  if(pObj->m_bDead || pObj->m_bAsleep || pObj->m_bDormant)
+    return false;
+
+  return pObj->m_eKind != eObjectKind::StationaryTurret &&
+    pObj->m_eKind != eObjectKind::Furniture;
+} //IsActive
+
+/// Find the objects that could collide with an active object by searching
+/// the spatial grid around it, widened to its whole path this frame if it is
+/// fast, and test it against each of them. A pair of active objects is
+/// tested by only one of them: the fast one if exactly one of them is fast,
+/// since only its search covers its path, and otherwise the one with the
+/// lower handle index. Dormant objects are left out altogether, so nothing
+/// can push one away from the position recorded for it in `m_vecDormant`.
+/// \param p0 Pointer to an active object.
+
+void CObjectManager::BroadPhase(CObject* p0){
+  Vector2 vMin = p0->m_vPos, vMax = p0->m_vPos;
+
+  if(p0->m_bFast){ //whole path this frame
+    vMin = Vector2(std::min(vMin.x, p0->m_vOldPos.x), std::min(vMin.y, p0->m_vOldPos.y));
+    vMax = Vector2(std::max(vMax.x, p0->m_vOldPos.x), std::max(vMax.y, p0->m_vOldPos.y));
+  } //if
+
+  const Vector2 vRadius(p0->m_fRadius, p0->m_fRadius);
+
+  m_cGrid.Query(vMin - vRadius, vMax + vRadius, [&](CObject* p1){
+    if(p1 == p0 || p1->m_bDead || p1->m_bDormant)return;
+
+    if(IsActive(p1)){ //test pair only once
+      const bool bFirst = p0->m_bFast != p1->m_bFast? p0->m_bFast:
+        p0->m_hSelf.m_nIndex < p1->m_hSelf.m_nIndex;
+      if(!bFirst)return;
+    } //if
+
+    NarrowPhase(p0, p1);
+  }); //Query
+} //BroadPhase
+
+/// Perform collision detection and response for each active object with the
+/// objects near it, found in the spatial grid, so the cost follows the
+/// number of active objects and not the number of objects in the world.
+/// Overlapping objects that just push each other apart are handed to the
+/// position solver, which separates them from each other and from the walls
+/// all at once. Then update each kind of object and test it against the
+/// walls. Projectiles are tested against the walls by the motion store.
+/// Stationary turrets, furniture, and static objects never move into a wall,
+/// and zombies and moving turrets resolve wall contact in their own `move()`
+/// functions and ignore wall collision responses, so none of those are
+/// tested. Sleeping enemies aren't in their kind lists, so they are skipped
+/// too.
 
 void CObjectManager::BroadPhase()
 {
-    LBaseObjectManager::BroadPhase();
+    UpdateGrid(); //search where the objects are now
 
-    float dt = m_pTimer->GetFrameTime();
+    auto pair = [&](const auto& v){
+      for(CObject* p: v)
+        if(IsActive(p))
+          BroadPhase(p);
+    }; //pair
 
-    for (CObject* pObj : m_stdObjectList)
-    {
-        if (!pObj->m_bDead)
-        {
-            pObj->Update(dt);
+    if (CPlayer* pPlayer = GetPlayer())
+        if (IsActive(pPlayer))
+            BroadPhase(pPlayer);
 
-            for (int i = 0; i < 2; i++)
-            {
-                Vector2 norm; float d = 0;
-                BoundingSphere s(Vector3(pObj->m_vPos), pObj->m_fRadius);
+    pair(m_vecBullets);
+    pair(m_vecEnemyBullets);
+    pair(m_vecZombies);
+    pair(m_vecTurrets);
+    pair(m_vecEnemies);
+    pair(m_vecOther);
 
-                if (m_pTileManager->CollideWithWall(s, norm, d))
-                    pObj->CollisionResponse(norm, d);
-            }
-        }
-    }
+    m_cSolver.Solve();
+
+    const float dt = m_pTimer->GetFrameTime();
+
+    CPlayer* pPlayer = GetPlayer();
+
+    if (pPlayer)
+        pPlayer->CPlayer::Update(dt);
+
+    for (CEnemy* p : m_vecEnemies)
+        if (!p->m_bDead)
+            p->CEnemy::Update(dt);
+
+    if (pPlayer)
+        CollideWithWalls(pPlayer);
+
+    CollideWithWalls(m_vecEnemies);
+
+    for (CObject* p : m_vecOther)
+        if (!p->m_bStatic)
+            CollideWithWalls(p);
+
+    m_cMotion.CollideWithWalls(); //registered objects
 }
 
+/// Test a live object against the walls twice, so that an object wedged in
+/// a corner is pushed out of both walls. The collision response is only
+/// called when there is a hit.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::CollideWithWalls(CObject* pObj){
+  for(int i=0; i<2 && !pObj->m_bDead; i++){
+    Vector2 norm; float d = 0;
+    const BoundingSphere s(Vector3(pObj->m_vPos), pObj->m_fRadius);
+
+    if(m_pTileManager->CollideWithWall(s, norm, d))
+      pObj->CollisionResponse(norm, d);
+  } //for
+} //CollideWithWalls
+
+/// Test each object of one kind against the walls.
+/// \param v List of objects of one kind.
 
+template<class t> void CObjectManager::CollideWithWalls(const std::vector<t*>& v){
+  for(t* p: v)
+    CollideWithWalls((CObject*)p);
+} //CollideWithWalls
 
-/// Perform collision detection and response for a pair of objects. Makes
-/// use of the helper function Identify() because this function may be called
-/// with the objects in an arbitrary order.
+
+
+/// Perform collision detection and response for a pair of objects. The
+/// response comes from the collision dispatch table entry for the kinds of
+/// the two objects, in the order given, so pairs that never collide, such as
+/// anything with furniture, are rejected before any geometry is done. Pairs
+/// that are contacts are only detected here and are separated later by the
+/// position solver.
 /// \param p0 Pointer to the first object.
 /// \param p1 Pointer to the second object.
 
 void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
+  const bool bContact = CCollisionTable::IsContact(p0->m_eKind, p1->m_eKind);
+  const CollisionHandler pHandler = CCollisionTable::Get(p0->m_eKind, p1->m_eKind);
+  if(!bContact && pHandler == nullptr)return; //these kinds never collide
+
   Vector2 vSep = p0->m_vPos - p1->m_vPos; //vector from *p1 to *p0
   const float d = p0->m_fRadius + p1->m_fRadius - vSep.Length(); //overlap
 
-  if (p0->isFurniture || p1->isFurniture)
-  {
-	  return; // Furniture does not collide
-  }
+  if(d > 0.0f && bContact) //bounding circles overlap
+    m_cSolver.AddContact(p0, p1);
 
-  if(d > 0.0f){ //bounding circles overlap
+  else if(d > 0.0f){ //bounding circles overlap
     vSep.Normalize(); //vSep is now the collision normal
+    pHandler(p0, p1, vSep, d); //responses of both objects
 
-    p0->CollisionResponse( vSep, d, p1); //this changes separation of objects
-    p1->CollisionResponse(-vSep, d, p0); //same separation and opposite normal
+    if(p1->isBullet())Wake(p0); //damage wakes sleepers
+    if(p0->isBullet())Wake(p1);
   } //if
+
+  else if(p0->m_bFast != p1->m_bFast) //exactly one of them may have tunneled
+    SweptPhase(p0->m_bFast? p0: p1, p0->m_bFast? p1: p0);
 } //NarrowPhase
 
+/// Swept narrow phase for a fast object that may have passed right through
+/// another object during this frame. The fast object's path from the start
+/// of the frame to its time of impact with a wall is swept against the other
+/// object's bounding circle at its current position. If they meet, the fast
+/// object is moved back to the point of contact and both objects get the
+/// usual collision response with zero overlap.
+/// \param pFast Pointer to the fast object.
+/// \param pObj Pointer to the other object.
+
+void CObjectManager::SweptPhase(CObject* pFast, CObject* pObj){
+  if(pFast->m_bDead || pObj->isBullet())return; //projectiles pass each other
+
+  const CollisionHandler pHandler = CCollisionTable::Get(pFast->m_eKind, pObj->m_eKind);
+  if(pHandler == nullptr)return; //contacts don't tunnel
+
+  const Vector2 vDelta = pFast->m_vPos - pFast->m_vOldPos; //path this frame
+  const float r = pFast->m_fRadius + pObj->m_fRadius; //combined radius
+  float t = 0.0f; //time of impact along the path
+
+  if(SweepCircle(pFast->m_vOldPos, vDelta, pObj->m_vPos, r, t)){
+    pFast->m_vPos = pFast->m_vOldPos + t*vDelta; //back up to contact
+    pFast->m_fTimeOfImpact *= t;
+
+    if(pFast->m_nMotion != UINT_MAX)
+      m_cMotion.SetPos(pFast->m_nMotion, pFast->m_vPos);
+
+    Vector2 norm = pFast->m_vPos - pObj->m_vPos; //from *pObj to *pFast
+    norm.Normalize();
+
+    pHandler(pFast, pObj, norm, 0.0f);
+    Wake(pObj); //damage wakes sleepers
+  } //if
+} //SweptPhase
+
 /// Create a bullet object and a flash particle effect. It is assumed that the
 /// object is round and that the bullet appears at the edge of the object in
 /// the direction that it is facing and continues moving in that direction.
@@ -189,29 +990,28 @@ void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
 void CObjectManager::Add(CObject* p)
 {
     if (!p) return;
-    m_stdObjectList.push_back(p);
-
-    // Track enemies if needed
-    if (CEnemy* pEnemy = dynamic_cast<CEnemy*>(p)) {
-        m_enemies.push_back(pEnemy);
-    }
+    m_nAllocations++;
+    Register(p);
 }
 
 void CObjectManager::FireGun(CPlayer* pPlayer, eSprite t, const Vector2& vDir) {
     float fSpeed = 500.0f;
     float fLifeSpan = 0.0f;
+    int nDamage = 1;
 
-    const float w0 = 0.5f * m_pRenderer->GetWidth(pPlayer->m_nSpriteIndex);
-    const float w1 = m_pRenderer->GetWidth(t);
+    const float w0 = 0.5f * CObject::GetSpriteSize(pPlayer->m_nSpriteIndex).x;
+    const float w1 = CObject::GetSpriteSize((UINT)t).x;
     float fLaunchDistance = w0 + w1;
 
     if (t == eSprite::Fireball) {
         fSpeed = FIREBALL_SPEED;
         fLifeSpan = 5.0f;
+        nDamage = FIREBALL_DAMAGE;
     }
     else if (t == eSprite::sword) {
         fSpeed = SWORD_SPEED;
         fLifeSpan = SWORD_LIFESPAN;
+        nDamage = SWORD_DAMAGE;
 
         fLaunchDistance = SWORD_OFFSET;
 
@@ -221,6 +1021,7 @@ void CObjectManager::FireGun(CPlayer* pPlayer, eSprite t, const Vector2& vDir) {
     else if (t == eSprite::greatsword) {
         fSpeed = GREATSWORD_SPEED;
         fLifeSpan = GREATSWORD_LIFESPAN;
+        nDamage = GREATSWORD_DAMAGE;
         fLaunchDistance = GREATSWORD_OFFSET;
 
         m_pAudio->stop(eSound::Gun);
@@ -230,6 +1031,7 @@ void CObjectManager::FireGun(CPlayer* pPlayer, eSprite t, const Vector2& vDir) {
     else if (t == eSprite::dagger) {
         fSpeed = DAGGER_SPEED;
         fLifeSpan = DAGGER_LIFESPAN;
+        nDamage = DAGGER_DAMAGE;
         fLaunchDistance = DAGGER_OFFSET;
 
         m_pAudio->stop(eSound::Gun);
@@ -246,20 +1048,24 @@ void CObjectManager::FireGun(CPlayer* pPlayer, eSprite t, const Vector2& vDir) {
 
     CObject* pBullet = create(t, pos);
 
-    pBullet->m_fMaxLifeSpan = fLifeSpan;
-    pBullet->m_fTimeAlive = 0.0f;
+    ((CBullet*)pBullet)->SetDamage(nDamage);
+    pBullet->m_bFast = fSpeed >= FAST_OBJECT_SPEED;
+    m_cMotion.SetFast(pBullet->m_nMotion, pBullet->m_bFast);
+    m_cMotion.SetLifeSpan(pBullet->m_nMotion, fLifeSpan);
 
     const Vector2 norm = VectorNormalCC(vDir);
     const float m = 2.0f * m_pRandom->randf() - 1.0f;
     const Vector2 deflection = 0.01f * m * norm;
 
-    pBullet->m_vVelocity = pPlayer->m_vVelocity + fSpeed * (vDir + deflection);
+    m_cMotion.SetVelocity(pBullet->m_nMotion, pPlayer->m_vVelocity + fSpeed * (vDir + deflection));
     pBullet->m_fRoll = pPlayer->m_fRoll;
 
 
     LParticleDesc2D d;
 
     if (t != eSprite::Fireball && t != eSprite::sword) {
+        m_pTileManager->GetLightGrid().Add(pos, LIGHT_FLASH, LIGHT_FLASH_TIME); //muzzle flash
+
         d.m_nSpriteIndex = (UINT)eSprite::Spark;
         d.m_vPos = pos;
         d.m_vVel = pPlayer->m_fSpeed * vDir;
@@ -297,10 +1103,12 @@ void CObjectManager::FireGun(CObject* pObj, eSprite bullet) {
 
     m_pAudio->play(eSound::Gun);
 
-    const float w0 = 0.5f * m_pRenderer->GetWidth(pObj->m_nSpriteIndex);
-    const float w1 = m_pRenderer->GetWidth(bullet);
+    const float w0 = 0.5f * CObject::GetSpriteSize(pObj->m_nSpriteIndex).x;
+    const float w1 = CObject::GetSpriteSize((UINT)bullet).x;
     const Vector2 pos = pObj->m_vPos + (w0 + w1) * vDir;
 
+    m_pTileManager->GetLightGrid().Add(pos, LIGHT_FLASH, LIGHT_FLASH_TIME); //muzzle flash
+
     CObject* pBullet = create(bullet, pos);
 
     const Vector2 norm = VectorNormalCC(vDir);
@@ -310,7 +1118,7 @@ void CObjectManager::FireGun(CObject* pObj, eSprite bullet) {
     float fEnemySpeed = 0.0f;
     float fBulletSpeed = 500.0f;
 
-    pBullet->m_vVelocity = fEnemySpeed * vDir + fBulletSpeed * (vDir + deflection);
+    m_cMotion.SetVelocity(pBullet->m_nMotion, fEnemySpeed * vDir + fBulletSpeed * (vDir + deflection));
     pBullet->m_fRoll = pObj->m_fRoll;
 
     LParticleDesc2D d;
@@ -325,16 +1133,176 @@ void CObjectManager::FireGun(CObject* pObj, eSprite bullet) {
     m_pParticleEngine->create(d);
 }
 
-/// Reader function for the number of Zombies. 
-/// \return Number of Zombies in the object list.
+/// Reader function for the number of live objects of a given kind. The
+/// counts are kept up to date as objects are created and as dead objects are
+/// culled at the end of each frame, so this takes constant time.
+/// \param t Object kind.
+/// \return Number of live objects of that kind.
 
+const size_t CObjectManager::GetCount(eObjectKind t) const{
+  return m_nCount[(UINT)t];
+} //GetCount
+
+/// Reader function for the number of turrets, counting both moving and
+/// stationary turrets since they share the turret sprite and both have to be
+/// destroyed to finish a level.
+/// \return Number of turrets.
 
 const size_t CObjectManager::GetNumTurrets() const{
-  size_t n = 0; 
-  
-  for(CObject* pObj: m_stdObjectList)
-    if(pObj->m_nSpriteIndex == (UINT)eSprite::Turret)
-      n++;
-
-  return n;
-} //GetNumZombies
\ No newline at end of file
+  return GetCount(eObjectKind::Turret) + GetCount(eObjectKind::StationaryTurret);
+} //GetNumTurrets
+
+/// Reader function for the number of zombies.
+/// \return Number of zombies.
+
+const size_t CObjectManager::GetNumZombies() const{
+  return GetCount(eObjectKind::Zombie);
+} //GetNumZombies
+
+/// Reader function for the number of enemies of every kind.
+/// \return Number of enemies.
+
+const size_t CObjectManager::GetNumEnemies() const{
+  return GetNumTurrets() + GetNumZombies() + GetCount(eObjectKind::Enemy);
+} //GetNumEnemies
+
+/// Reader function for the number of projectiles in flight, both the
+/// player's and the enemies'.
+/// \return Number of projectiles.
+
+const size_t CObjectManager::GetNumBullets() const{
+  return GetCount(eObjectKind::Bullet) + GetCount(eObjectKind::EnemyBullet);
+} //GetNumBullets
+
+/// Reader function for the number of sleeping objects.
+/// \return Number of sleeping objects.
+
+const size_t CObjectManager::GetNumAsleep() const{
+  return m_vecAsleep.size();
+} //GetNumAsleep
+
+/// Reader function for the number of dormant objects.
+/// \return Number of dormant objects.
+
+const size_t CObjectManager::GetNumDormant() const{
+  return m_vecDormant.size();
+} //GetNumDormant
+
+/// Set the most iterations that the position solver may use in a frame.
+/// \param n Iteration budget.
+
+void CObjectManager::SetSolverIterations(UINT n){
+  m_cSolver.SetIterations(n);
+} //SetSolverIterations
+
+/// Reader function for the position solver's iteration budget.
+/// \return Most iterations per frame.
+
+const UINT CObjectManager::GetSolverIterations() const{
+  return m_cSolver.GetIterations();
+} //GetSolverIterations
+
+/// Reader function for the number of iterations that the position solver
+/// used last frame.
+/// \return Iterations used last frame.
+
+const UINT CObjectManager::GetSolverLastIterations() const{
+  return m_cSolver.GetLastIterations();
+} //GetSolverLastIterations
+
+/// Check that the broad phase and the position solver pull a crowd of
+/// zombies apart. A number of zombies are spawned packed on top of each other
+/// at the player, then paired and solved frame by frame with nothing else
+/// moving until no two of them overlap by more than `SOLVER_TOLERANCE`, or
+/// until the frames run out. Each frame's solver iterations, out of its
+/// budget, and worst overlap are logged, then the totals. The zombies are
+/// killed afterwards so that they are culled next frame. Nothing is drawn,
+/// so this can be run from a debug key without disturbing the game.
+/// \param n Number of zombies.
+/// \param frames Most frames to run.
+/// \return true if the zombies were separated.
+
+const bool CObjectManager::CrowdCheck(size_t n, UINT frames){
+  const CPlayer* pPlayer = GetPlayer();
+  if(pPlayer == nullptr || n < 2)return false;
+
+  std::vector<Vector2> vecPos(n); //packed into a few pixels
+
+  for(size_t i=0; i<n; i++)
+    vecPos[i] = pPlayer->m_vPos + Vector2(float(i%4), float(i/4));
+
+  SpawnZombies(vecPos);
+  const std::vector<CZombie*> vecCrowd(m_vecZombies.end() - n, m_vecZombies.end());
+
+  auto overlap = [&](){ //worst overlap between zombies in the crowd
+    float worst = 0.0f;
+
+    for(size_t i=0; i<n; i++)
+      for(size_t j=i + 1; j<n; j++){
+        const CObject* p0 = vecCrowd[i];
+        const CObject* p1 = vecCrowd[j];
+        const float d = p0->m_fRadius + p1->m_fRadius -
+          Vector2::Distance(p0->m_vPos, p1->m_vPos);
+        worst = std::max(worst, d);
+      } //for
+
+    return worst;
+  }; //overlap
+
+  UINT frame = 0; //frames used
+  UINT iterations = 0; //solver iterations used
+  float worst = overlap();
+
+  while(worst > SOLVER_TOLERANCE && frame < frames){
+    UpdateGrid();
+
+    for(CZombie* p: vecCrowd)
+      if(IsActive(p))
+        BroadPhase(p);
+
+    m_cSolver.Solve();
+    worst = overlap();
+    frame++;
+    iterations += GetSolverLastIterations();
+
+    LOG(Info, Collision, "crowd", "frame", frame,
+      "iterations", GetSolverLastIterations(), "budget", GetSolverIterations(),
+      "overlap", worst);
+  } //while
+
+  for(CZombie* p: vecCrowd)
+    p->m_bDead = true;
+
+  const bool bSeparated = worst <= SOLVER_TOLERANCE;
+
+  LOG(Info, Collision, "crowd", "zombies", n, "frames", frame,
+    "iterations", iterations, "separated", bSeparated);
+
+  return bSeparated;
+} //CrowdCheck
+
+/// Print the size of each type of game object and the number of bytes that
+/// 10,000 of them would take up, not counting anything that they allocate
+/// on the heap such as event timers. Also prints the size of the compact
+/// form kept for dormant objects and of one motion store entry for
+/// comparison. Results go to standard output, so use the debug console to
+/// see them.
+
+void CObjectManager::PrintSizeReport(){
+  auto report = [](const char* name, size_t n){
+    printf("  %-18s %4zu bytes, %8zu bytes per 10k\n", name, n, 10000*n);
+  }; //report
+
+  printf("Object sizes\n");
+  report("CObject", sizeof(CObject));
+  report("CPlayer", sizeof(CPlayer));
+  report("CBullet", sizeof(CBullet));
+  report("CBulletEnemy", sizeof(CBulletEnemy));
+  report("CZombie", sizeof(CZombie));
+  report("CTurret", sizeof(CTurret));
+  report("CStationaryTurret", sizeof(CStationaryTurret));
+  report("CFurniture", sizeof(CFurniture));
+  report("CEnemy", sizeof(CEnemy));
+  report("CDormantObject", sizeof(CDormantObject));
+  report("motion entry", CMotionStore::GetEntrySize());
+} //PrintSizeReport
\ No newline at end of file
@@ -4,35 +4,149 @@
 #ifndef __L4RC_GAME_OBJECTMANAGER_H__
 #define __L4RC_GAME_OBJECTMANAGER_H__
 
-#include "BaseObjectManager.h"
+#include "Component.h"
 #include "Object.h"
+#include "Animator.h"
 #include "Common.h"
+#include "Handle.h"
+#include "ObjectPool.h"
+#include "MotionStore.h"
+#include "PositionSolver.h"
+#include "RenderQueue.h"
+#include "SpatialGrid.h"
+#include "Settings.h"
+#include "TileManager.h"
 
 
 class CEnemy;
+class CBullet;
+class CBulletEnemy;
+class CZombie;
+class CTurret;
+class CStationaryTurret;
+
+/// \brief Dormant object.
+///
+/// The compact form that the object manager keeps for an object outside the
+/// activity bubble: just enough to tell when the player comes near and to
+/// find the object again.
+
+struct CDormantObject{
+  Vector2 m_vPos; ///< Position.
+  CHandle m_hObject; ///< Handle to the object.
+}; //CDormantObject
+
+/// \brief The object manager.
+///
+/// The object manager owns the game objects. Live objects are kept in a
+/// contiguous array and each is given a generation-checked handle, which is
+/// what other objects should hold if they need to refer to it, since a
+/// pointer would dangle once the object dies. Dead objects are swap-removed
+/// from the array in bulk once per frame. Live objects are also kept in a
+/// spatial grid so that drawing only visits those near the camera, and
+/// collision detection only those near each moving object.
 
 class CObjectManager: 
-  public LBaseObjectManager<CObject>,
+  public LComponent,
+  public LSettings,
   public CCommon
 {
   private:
+    std::vector<CObject*> m_vecObjects; ///< Live objects, in no particular order.
+    CHandleTable<CObject> m_cHandles; ///< Map from handles to objects.
+    CHandle m_hPlayer; ///< Handle to the player character.
+
+    CObjectPool<CBullet> m_cBulletPool; ///< Pool of player projectiles.
+    CObjectPool<CBulletEnemy> m_cEnemyBulletPool; ///< Pool of enemy bullets.
+    size_t m_nAllocations = 0; ///< Number of objects allocated outside the pools.
+    size_t m_nCount[(UINT)eObjectKind::Size] = {0}; ///< Live objects of each kind.
+    CMotionStore m_cMotion; ///< Hot movement fields of pooled projectiles.
+    CAnimator m_cAnimator; ///< Animation state of animated objects.
+    CPositionSolver m_cSolver; ///< Separates objects that push each other.
+    CRenderQueue m_cRenderQueue; ///< Sprites to draw this frame.
+    CSpatialGrid m_cGrid; ///< Spatial index of live objects for culling and collision.
+
+    std::vector<CBullet*> m_vecBullets; ///< Player projectiles.
+    std::vector<CBulletEnemy*> m_vecEnemyBullets; ///< Enemy bullets.
+    std::vector<CZombie*> m_vecZombies; ///< Zombies.
+    std::vector<CTurret*> m_vecTurrets; ///< Moving turrets.
+    std::vector<CStationaryTurret*> m_vecStationaryTurrets; ///< Stationary turrets.
+    std::vector<CObject*> m_vecFurniture; ///< Furniture.
+    std::vector<CEnemy*> m_vecEnemies; ///< Enemies.
+    std::vector<CObject*> m_vecOther; ///< Everything else, such as the shield.
+    std::vector<CObject*> m_vecAsleep; ///< Sleeping enemies of all kinds.
+    std::vector<CDormantObject> m_vecDormant; ///< Enemies outside the activity bubble.
+    float m_fNextWakeCheck = 0.0f; ///< Time of next proximity wake check.
+    UINT m_nFrame = 0; ///< Frame counter for middle ring updates.
+
     void BroadPhase(); ///< Broad phase collision detection and response.
+    void BroadPhase(CObject*); ///< Broad phase for one active object.
+    static const bool IsActive(const CObject*); ///< Looks for collisions of its own?
     void NarrowPhase(CObject*, CObject*); ///< Narrow phase collision detection and response.
+    void SweptPhase(CObject*, CObject*); ///< Swept collision for a fast object.
+    void CullDeadObjects(); ///< Delete dead objects, recycle dead projectiles.
+    CObject* CreateProjectile(eSprite, const Vector2&); ///< Create pooled projectile.
+    void ReleaseProjectile(CObject*); ///< Return projectile to pool.
+    void Register(CObject*); ///< Issue handle and put object in the list for its kind.
+    void AddToKindList(CObject*); ///< Put object in the list for its kind.
+    template<class t> void Sleep(std::vector<t*>&, float); ///< Put idle objects to sleep.
+    void Wake(CObject*); ///< Wake a sleeping object.
+    void WakeNearPlayer(); ///< Wake sleeping objects near the player.
+    void UpdateBubble(); ///< Move objects between activity bubble regions.
+    template<class t> void Classify(std::vector<t*>&, const Vector2&); ///< Find region for one kind.
+    void Revive(size_t); ///< Bring a dormant object back.
+    const bool DueThisFrame(const CObject*) const; ///< Update this frame?
+    void RemoveDeadFromKindLists(); ///< Remove dead objects from kind lists.
+    void UpdateGrid(); ///< Move objects to their cells in the spatial grid.
+    void UpdateLights(float); ///< Move light sources with their objects.
+    void ReserveSpawn(size_t); ///< Make room for a batch of new objects.
+    template<class t> void SpawnPatrols(std::vector<t*>&, const std::vector<Vector2>&); ///< Spawn patrolling enemies.
+    void CollideWithWalls(CObject*); ///< Wall pass for one object.
+    template<class t> void CollideWithWalls(const std::vector<t*>&); ///< Wall pass for one kind.
+    static const eRenderLayer GetLayer(const CObject*); ///< Layer to draw object in.
     
   public:
+    CObjectManager(); ///< Constructor.
+    ~CObjectManager(); ///< Destructor.
+
+    void move(); ///< Move all objects.
+    void clear(); ///< Reset to initial conditions.
+    const size_t GetNumAllocations() const; ///< Number of object allocations.
+
     CObject* create(eSprite, const Vector2&); ///< Create new object.
 	CObject* createFurniture(eSprite, const Vector2&, char); ///< Create new furniture object.
-    CPlayer* m_pPlayer = nullptr;
-    std::vector<CEnemy*> m_enemies;
+    void SpawnZombies(const std::vector<Vector2>&); ///< Create zombies from a spawn table.
+    void SpawnTurrets(const std::vector<Vector2>&); ///< Create moving turrets from a spawn table.
+    void SpawnStationaryTurrets(const std::vector<Vector2>&); ///< Create stationary turrets from a spawn table.
+    void SpawnFurniture(const std::vector<CTileManager::furniture>&); ///< Create furniture from a spawn table.
     void Add(CObject* p); ///< Add an object to the manager.
 
-    virtual void draw(); ///< Draw all objects.
+    CObject* Get(const CHandle&) const; ///< Get object from handle, if alive.
+    CPlayer* GetPlayer() const; ///< Get player character, if alive.
+
+    void draw(); ///< Draw all objects.
+    const CRenderQueue& GetRenderQueue() const; ///< Get last frame's render queue.
+    const CSpatialGrid& GetGrid() const; ///< Get spatial index of live objects.
+    CAnimator& GetAnimator(); ///< Get animator.
     
     
 
     void FireGun(CPlayer*, eSprite, const Vector2& vDir);
     void FireGun(CObject* pObj, eSprite t);
-    const size_t GetNumTurrets() const; 
+    const size_t GetCount(eObjectKind) const; ///< Number of live objects of a kind.
+    const size_t GetNumTurrets() const; ///< Number of turrets of both kinds.
+    const size_t GetNumZombies() const; ///< Number of zombies.
+    const size_t GetNumEnemies() const; ///< Number of enemies of all kinds.
+    const size_t GetNumBullets() const; ///< Number of projectiles.
+    const size_t GetNumAsleep() const; ///< Number of sleeping objects.
+    const size_t GetNumDormant() const; ///< Number of dormant objects.
+
+    void SetSolverIterations(UINT); ///< Set position solver iteration budget.
+    const UINT GetSolverIterations() const; ///< Position solver iteration budget.
+    const UINT GetSolverLastIterations() const; ///< Iterations used last frame.
+    const bool CrowdCheck(size_t, UINT); ///< Check that a packed crowd separates.
+
+    static void PrintSizeReport(); ///< Print memory used by each object type.
 }; //CObjectManager
 
 #endif //__L4RC_GAME_OBJECTMANAGER_H__
@@ -0,0 +1,114 @@
+/// \file ObjectPool.h
+/// \brief Interface and code for the object pool template CObjectPool.
+
+#ifndef __L4RC_GAME_OBJECTPOOL_H__
+#define __L4RC_GAME_OBJECTPOOL_H__
+
+#include <vector>
+
+#include "Defines.h"
+#include "Handle.h"
+
+/// \brief The object pool.
+///
+/// An object pool owns a set of preallocated objects of type `t` and hands
+/// them out by handle. Free slots are kept on a stack so that acquiring and
+/// releasing are constant time and do no heap allocation. The pool only
+/// grows if it runs dry, and every object it allocates is counted so that
+/// the growth can be seen at runtime.
+
+template<class t> class CObjectPool{
+  private:
+    std::vector<t*> m_vecObjects; ///< One object per slot.
+    std::vector<UINT> m_vecGeneration; ///< Current generation of each slot.
+    std::vector<UINT> m_vecFreeList; ///< Stack of free slot indices.
+
+    size_t m_nAllocations = 0; ///< Number of objects allocated so far.
+
+    void Grow(t*); ///< Add a new slot holding an object.
+
+  public:
+    ~CObjectPool(); ///< Destructor.
+
+    void Reserve(size_t, t* (*)()); ///< Preallocate objects.
+    const CHandle Acquire(t* (*)()); ///< Get a free object.
+    void Release(const CHandle&); ///< Return an object to the pool.
+    t* Get(const CHandle&) const; ///< Get object from handle, if still live.
+
+    const size_t GetNumAllocations() const{return m_nAllocations;} ///< Allocation count.
+    const size_t GetNumFree() const{return m_vecFreeList.size();} ///< Free slot count.
+}; //CObjectPool
+
+/// Delete all of the objects owned by the pool, whether or not they are
+/// in use. The caller must make sure that nobody else deletes them.
+
+template<class t> CObjectPool<t>::~CObjectPool(){
+  for(t* p: m_vecObjects)
+    delete p;
+} //destructor
+
+/// Add a slot at the end of the pool holding a newly allocated object and
+/// put it on the free list.
+/// \param p Pointer to the new object.
+
+template<class t> void CObjectPool<t>::Grow(t* p){
+  m_vecFreeList.push_back((UINT)m_vecObjects.size());
+  m_vecObjects.push_back(p);
+  m_vecGeneration.push_back(0);
+  m_nAllocations++;
+} //Grow
+
+/// Allocate enough objects up front that the pool holds at least a given
+/// number of them.
+/// \param n Number of objects.
+/// \param make Factory function that allocates one object.
+
+template<class t> void CObjectPool<t>::Reserve(size_t n, t* (*make)()){
+  m_vecObjects.reserve(n);
+  m_vecGeneration.reserve(n);
+  m_vecFreeList.reserve(n);
+
+  while(m_vecObjects.size() < n)
+    Grow(make());
+} //Reserve
+
+/// Pop a slot off the free list, growing the pool first if it is empty.
+/// \param make Factory function that allocates one object.
+/// \return Handle to the acquired object.
+
+template<class t> const CHandle CObjectPool<t>::Acquire(t* (*make)()){
+  if(m_vecFreeList.empty())
+    Grow(make());
+
+  CHandle h;
+  h.m_nIndex = m_vecFreeList.back();
+  h.m_nGeneration = m_vecGeneration[h.m_nIndex];
+  m_vecFreeList.pop_back();
+
+  return h;
+} //Acquire
+
+/// Return a slot to the free list and bump its generation so that stale
+/// handles to it no longer resolve. Stale and null handles are ignored.
+/// \param h Handle to the object.
+
+template<class t> void CObjectPool<t>::Release(const CHandle& h){
+  if(Get(h) == nullptr)return; //stale or null
+
+  m_vecGeneration[h.m_nIndex]++;
+  m_vecFreeList.push_back(h.m_nIndex);
+} //Release
+
+/// Resolve a handle.
+/// \param h Handle to an object.
+/// \return Pointer to the object, or `nullptr` if the handle is stale or null.
+
+template<class t> t* CObjectPool<t>::Get(const CHandle& h) const{
+  if(h.m_nIndex >= m_vecObjects.size() ||
+    m_vecGeneration[h.m_nIndex] != h.m_nGeneration)
+    return nullptr;
+
+  return m_vecObjects[h.m_nIndex];
+} //Get
+
+#endif //__L4RC_GAME_OBJECTPOOL_H__
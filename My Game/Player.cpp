@@ -5,13 +5,17 @@
 #include "ComponentIncludes.h"
 #include "Helpers.h"
 #include "Object.h"
+#include "ObjectManager.h"
 #include "Particle.h"
 #include "ParticleEngine.h"
+#include "Hud.h"
+#include "Animator.h"
 
 
 CPlayer::CPlayer(eSprite t, const Vector2& p) : CObject(t, p) {
 	
 	m_bIsTarget = true;
+	m_eKind = eObjectKind::Player;
 
 	m_fSpeed = 0.0f; 
 	m_bStrafeLeft = false;
@@ -19,8 +23,6 @@ CPlayer::CPlayer(eSprite t, const Vector2& p) : CObject(t, p) {
 	m_bStrafeBack = false; 
 	m_bStatic = false;
 
-	m_pFrameEvent = new LEventTimer(0.12f);
-	
 	m_fRadius = 16.0f; // player collision radius
 
 	m_pBulletCooldown = new LEventTimer(COOLDOWN_BULLET);
@@ -30,12 +32,12 @@ CPlayer::CPlayer(eSprite t, const Vector2& p) : CObject(t, p) {
 	m_pDaggerCooldown = new LEventTimer(COOLDOWN_DAGGER);
 
 	m_bShieldActive = false;
-	m_pShieldObject = nullptr;
+
+	HealthChanged();
 } 
 
 CPlayer::~CPlayer() {
 	
-	delete m_pFrameEvent;
 	delete m_pBulletCooldown;
 	delete m_pFireballCooldown;
 	delete m_pSwordCooldown;
@@ -66,13 +68,13 @@ void CPlayer::move() {
 	m_bStrafeLeft = m_bStrafeRight = m_bStrafeBack = false;
 
 
-	if (m_bShieldActive && m_pShieldObject) {
+	CObject* pShield = m_bShieldActive? m_pObjectManager->Get(m_hShield): nullptr;
+
+	if (pShield) {
 		Vector2 playerDir = GetDirectionVector();
-		m_pShieldObject->m_vPos = m_vPos + playerDir * SHIELD_OFFSET;
-		m_pShieldObject->m_fRoll = m_fRoll;
+		pShield->m_vPos = m_vPos + playerDir * SHIELD_OFFSET;
+		pShield->m_fRoll = m_fRoll;
 	}
-
-	UpdateFramenumber();
 }
 
 
@@ -188,46 +190,47 @@ void CPlayer::Stop() {
 } */
 //not sure which stop function is intended
 
-void CPlayer::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
-	if (m_bDead)return;
-
-	if (pObj && pObj->isBullet()) {
+/// Take a hit from a projectile. A projectile that arrives from in front of
+/// the player while the shield is up is destroyed, otherwise the player
+/// loses a point of health and gets pushed back as from any other object.
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param pObj Pointer to the projectile.
 
+void CPlayer::TakeHit(const Vector2& norm, float d, CObject* pObj) {
+	if (m_bDead)return;
 
-		if (m_bShieldActive) {
-			Vector2 playerDir = GetDirectionVector();
-			Vector2 toBullet = Normalize(pObj->GetPos() - m_vPos);
+	if (m_bShieldActive) {
+		Vector2 playerDir = GetDirectionVector();
+		Vector2 toBullet = Normalize(pObj->GetPos() - m_vPos);
 
 
-			const float SHIELD_BLOCK_THRESHOLD = 0.5f;
+		const float SHIELD_BLOCK_THRESHOLD = 0.5f;
 
-			if (Dot(playerDir, toBullet) > SHIELD_BLOCK_THRESHOLD) {
-				pObj->SetDead();
-				m_pAudio->play(eSound::Clang);
-				return;
-			}
+		if (Dot(playerDir, toBullet) > SHIELD_BLOCK_THRESHOLD) {
+			pObj->SetDead();
+			m_pAudio->play(eSound::Clang);
+			return;
 		}
+	}
 
+	if (m_bGodMode)
+		m_pAudio->play(eSound::Grunt);
 
+	else if (--m_nHealth == 0) {
 
+		m_pAudio->play(eSound::Boom);
+		m_bDead = true;
+		DeathFX();
+		HealthChanged();
+	}
 
-		if (m_bGodMode)
-			m_pAudio->play(eSound::Grunt);
-
-		else if (--m_nHealth == 0) {
-
-			m_pAudio->play(eSound::Boom);
-			m_bDead = true;
-			DeathFX();
-			m_pPlayer = nullptr;
-		}
-
-		else {
+	else {
 
-			m_pAudio->play(eSound::Grunt);
-			const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth;
-			m_f4Tint = XMFLOAT4(1.0f, f, f, 0);
-		}
+		HealthChanged();
+		m_pAudio->play(eSound::Grunt);
+		const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth;
+		m_f4Tint = XMFLOAT4(1.0f, f, f, 0);
 	}
 
 	CObject::CollisionResponse(norm, d, pObj);
@@ -246,26 +249,6 @@ void CPlayer::Update(float dt)
             
             Stop();                 // Go back to idle sprite
         }
-        return;
-    }
-
-    UpdateFramenumber();
-}
-
-
-void CPlayer::UpdateFramenumber()
-{
-    if (!m_pRenderer || m_nSpriteIndex >= (UINT)eSprite::Size)
-        return;
-
-    UINT n = m_pRenderer->GetNumFrames(m_nSpriteIndex);
-
-    if (n > 1 && m_pFrameEvent && m_pFrameEvent->Triggered()) {
-        m_nCurrentFrame++;
-        if (!m_bAttacking)
-            m_nCurrentFrame %= n;
-        else if (m_nCurrentFrame >= n)
-            m_nCurrentFrame = n - 1;  // stop on final attack frame
     }
 }
 
@@ -289,14 +272,12 @@ void CPlayer::SetSprite(eSprite sprite)
         break; // Leave m_fRoll as-is for attack sprites
     }
 
-    if (m_nSpriteIndex != (UINT)sprite) {
-        m_nSpriteIndex = (UINT)sprite;
-        m_nCurrentFrame = 0;
-    }
+    if (m_nSpriteIndex != (UINT)sprite)
+        SetAnimation((UINT)sprite);
     else {
-        UINT n = m_pRenderer->GetNumFrames(m_nSpriteIndex);
+        const UINT n = CAnimator::GetClip(m_nSpriteIndex).m_nFrames;
         if (m_nCurrentFrame >= n)
-            m_nCurrentFrame = 0;
+            SetAnimation(m_nSpriteIndex);
     }
 }
 
@@ -371,6 +352,15 @@ void CPlayer::DeathFX()
 
 // ------------ Damage ------------
 
+/// Tell the heads-up display that the player's health has changed. This is
+/// the only way that the health bar finds out, so it must be called after
+/// every change.
+
+void CPlayer::HealthChanged() const
+{
+    m_pHud->SetHealth(m_nHealth, m_nMaxHealth);
+}
+
 void CPlayer::TakeDamage(int damage)
 {
     if (m_bDead) return;
@@ -385,6 +375,8 @@ void CPlayer::TakeDamage(int damage)
         m_nHealth -= (UINT)damage;
     }
 
+    HealthChanged();
+
     // small hit effect
     LParticleDesc2D pd;
     pd.m_vPos = m_vPos;
@@ -6,7 +6,6 @@
 
 #include "Object.h"
 #include "EventTimer.h"
-#include <iostream>
 
 
 class CPlayer : public CObject {
@@ -23,8 +22,8 @@ protected:
     bool m_bAttacking = false;
     float m_fAttackDuration = 0.3f; // duration of attack animation
     float m_fAttackTimer = 0.0f;
+    float m_fRotSpeed = 0.0f; ///< Rotation speed.
 
-    LEventTimer* m_pFrameEvent = nullptr;
     LEventTimer* m_pBulletCooldown = nullptr;
     LEventTimer* m_pFireballCooldown = nullptr;
     LEventTimer* m_pSwordCooldown = nullptr;
@@ -32,12 +31,11 @@ protected:
     LEventTimer* m_pDaggerCooldown = nullptr;
 
     bool m_bShieldActive = false;
-    CObject* m_pShieldObject = nullptr;
+    CHandle m_hShield; ///< Handle to the shield object, if any.
 
-    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr);
     virtual void DeathFX();
 
-    void UpdateFramenumber(); 
+    void HealthChanged() const; ///< Report health to the heads-up display.
 
 public:
     CPlayer(eSprite t, const Vector2& p);
@@ -48,6 +46,7 @@ public:
 	void TakeDamage() //This is here for testing purposes, it might come in handy later so I'm leaving it
     {
 		m_nHealth -= 1;
+		HealthChanged();
     }//Take Damage
 
     int GetHealth()
@@ -83,6 +82,7 @@ public:
 
 
     void TakeDamage(int damage); // added: allow others to damage player
+    void TakeHit(const Vector2&, float, CObject*); ///< Take a hit from a projectile.
 
 private:
 	void SetSprite(eSprite sprite);
@@ -0,0 +1,212 @@
+/// \file PositionSolver.cpp
+/// \brief Code for the position solver CPositionSolver.
+
+#include "PositionSolver.h"
+#include "Object.h"
+#include "TileManager.h"
+
+/// Reserve space for a number of bodies and contacts.
+/// \param n Number of bodies.
+
+void CPositionSolver::reserve(size_t n){
+  m_vecPosX.reserve(n);
+  m_vecPosY.reserve(n);
+  m_vecRadius.reserve(n);
+  m_vecInvMass.reserve(n);
+  m_vecMoved.reserve(n);
+  m_vecOwner.reserve(n);
+  m_vecContact.reserve(4*n); //two contacts per body
+} //reserve
+
+/// Inverse mass of an object, which says how much of a correction it takes.
+/// Everything that moves around gets the same mass. Stationary turrets and
+/// objects that never move, such as the shield, are immovable. Objects in the
+/// motion store are only there because they are projectiles, which never get
+/// here, but they are treated as immovable since the store owns their
+/// positions.
+/// \param pObj Pointer to an object.
+/// \return Inverse mass, 0 for an immovable object.
+
+const float CPositionSolver::GetInvMass(const CObject* pObj){
+  if(pObj->m_nMotion != UINT_MAX)return 0.0f;
+
+  switch(pObj->m_eKind){
+    case eObjectKind::Player:
+    case eObjectKind::Zombie:
+    case eObjectKind::Turret:
+    case eObjectKind::Enemy: return 1.0f;
+    case eObjectKind::StationaryTurret: return 0.0f;
+    default: return pObj->m_bStatic? 0.0f: 1.0f;
+  } //switch
+} //GetInvMass
+
+/// Get the body for an object, making one from the object's current position
+/// if it doesn't have one yet. Objects are looked up by the slot index of
+/// their handle, so this is constant time.
+/// \param pObj Pointer to an object.
+/// \return Body index.
+
+const UINT CPositionSolver::GetBody(CObject* pObj){
+  const UINT slot = pObj->m_hSelf.m_nIndex;
+
+  if(slot >= m_vecBodyOf.size())
+    m_vecBodyOf.resize(slot + 1, UINT_MAX);
+
+  UINT& b = m_vecBodyOf[slot]; //shorthand
+
+  if(b == UINT_MAX){
+    b = (UINT)m_vecOwner.size();
+    m_vecPosX.push_back(pObj->m_vPos.x);
+    m_vecPosY.push_back(pObj->m_vPos.y);
+    m_vecRadius.push_back(pObj->m_fRadius);
+    m_vecInvMass.push_back(GetInvMass(pObj));
+    m_vecMoved.push_back(1); //test against walls in the first iteration
+    m_vecOwner.push_back(pObj);
+  } //if
+
+  return b;
+} //GetBody
+
+/// Add a contact between a pair of overlapping objects. Pairs in which
+/// neither object can move are dropped.
+/// \param p0 Pointer to the first object.
+/// \param p1 Pointer to the second object.
+
+void CPositionSolver::AddContact(CObject* p0, CObject* p1){
+  if(p0->m_bDead || p1->m_bDead)return;
+  if(GetInvMass(p0) + GetInvMass(p1) == 0.0f)return; //both immovable
+
+  m_vecContact.push_back(GetBody(p0));
+  m_vecContact.push_back(GetBody(p1));
+} //AddContact
+
+/// Relax one contact by moving its two bodies apart along the line between
+/// their centers, each by a share of the overlap in proportion to its
+/// inverse mass. A little overlap is left alone so that bodies resting
+/// against each other don't jitter. Bodies whose centers coincide are
+/// separated along the x-axis.
+/// \param i Contact index.
+/// \return Overlap before the correction, 0 if the bodies don't overlap.
+
+const float CPositionSolver::SolveContact(UINT i){
+  const UINT b0 = m_vecContact[2*i];
+  const UINT b1 = m_vecContact[2*i + 1];
+
+  float dx = m_vecPosX[b0] - m_vecPosX[b1]; //vector from b1 to b0
+  float dy = m_vecPosY[b0] - m_vecPosY[b1];
+  const float r = m_vecRadius[b0] + m_vecRadius[b1]; //combined radius
+  const float dsq = dx*dx + dy*dy; //distance squared
+
+  if(dsq >= r*r)return 0.0f; //no longer overlapping
+
+  const float dist = sqrtf(dsq);
+  const float d = r - dist; //overlap
+  if(d <= SOLVER_SLOP)return d;
+
+  if(dist > 0.0f){dx /= dist; dy /= dist;}
+  else{dx = 1.0f; dy = 0.0f;}
+
+  const float w0 = m_vecInvMass[b0];
+  const float w1 = m_vecInvMass[b1];
+  const float s = (d - SOLVER_SLOP)/(w0 + w1); //correction per unit inverse mass
+
+  m_vecPosX[b0] += w0*s*dx; m_vecPosY[b0] += w0*s*dy;
+  m_vecPosX[b1] -= w1*s*dx; m_vecPosY[b1] -= w1*s*dy;
+  m_vecMoved[b0] |= (BYTE)(w0 > 0.0f);
+  m_vecMoved[b1] |= (BYTE)(w1 > 0.0f);
+
+  return d;
+} //SolveContact
+
+/// Push a body out of the walls, twice so that a body wedged in a corner is
+/// pushed out of both. Walls are immovable, so the body takes all of the
+/// correction. Bodies that haven't moved since their last wall test can't
+/// have been pushed into a wall and are skipped.
+/// \param b Body index.
+/// \return Largest overlap with a wall before the correction.
+
+const float CPositionSolver::SolveWalls(UINT b){
+  if(!m_vecMoved[b])return 0.0f;
+  m_vecMoved[b] = 0;
+
+  float worst = 0.0f; //largest overlap
+
+  for(int k=0; k<2; k++){
+    Vector2 norm; float d = 0;
+    const BoundingSphere s(Vector3(m_vecPosX[b], m_vecPosY[b], 0), m_vecRadius[b]);
+    if(!m_pTileManager->CollideWithWall(s, norm, d))break;
+
+    m_vecPosX[b] += d*norm.x;
+    m_vecPosY[b] += d*norm.y;
+    worst = std::max(worst, d);
+  } //for
+
+  return worst;
+} //SolveWalls
+
+/// Separate all of the bodies from each other and from the walls. Each
+/// iteration is a Gauss-Seidel sweep that relaxes every contact in turn using
+/// the positions left by the ones before it, then pushes every body that
+/// moved back out of the walls, so the walls always get the last word. The
+/// sweeps alternate direction so that the order in which contacts were found
+/// doesn't bias the result. It stops when the worst overlap found in a sweep
+/// is within tolerance or the iteration budget is used up, then copies the
+/// positions back to the objects and empties the solver for the next frame.
+
+void CPositionSolver::Solve(){
+  const UINT nContacts = (UINT)m_vecContact.size()/2;
+  const UINT nBodies = (UINT)m_vecOwner.size();
+  m_nLastIterations = 0;
+
+  while(nContacts > 0 && m_nLastIterations < m_nIterations){
+    const bool bForward = (m_nLastIterations & 1) == 0;
+    float worst = 0.0f; //largest overlap this iteration
+
+    for(UINT i=0; i<nContacts; i++)
+      worst = std::max(worst, SolveContact(bForward? i: nContacts - 1 - i));
+
+    for(UINT b=0; b<nBodies; b++)
+      if(m_vecInvMass[b] > 0.0f)
+        worst = std::max(worst, SolveWalls(b));
+
+    m_nLastIterations++;
+    if(worst <= SOLVER_TOLERANCE)break; //converged
+  } //while
+
+  for(UINT b=0; b<nBodies; b++){
+    CObject* pObj = m_vecOwner[b];
+    if(m_vecInvMass[b] > 0.0f)
+      pObj->m_vPos = Vector2(m_vecPosX[b], m_vecPosY[b]);
+    m_vecBodyOf[pObj->m_hSelf.m_nIndex] = UINT_MAX;
+  } //for
+
+  m_vecPosX.clear();
+  m_vecPosY.clear();
+  m_vecRadius.clear();
+  m_vecInvMass.clear();
+  m_vecMoved.clear();
+  m_vecOwner.clear();
+  m_vecContact.clear();
+} //Solve
+
+/// Set the most iterations that the solver may use in a frame. More
+/// iterations settle dense crowds faster at a higher cost per frame.
+/// \param n Iteration budget, at least 1.
+
+void CPositionSolver::SetIterations(UINT n){
+  m_nIterations = std::max(n, 1U);
+} //SetIterations
+
+/// Reader function for the iteration budget.
+/// \return Most iterations per frame.
+
+const UINT CPositionSolver::GetIterations() const{
+  return m_nIterations;
+} //GetIterations
+
+/// Reader function for the number of iterations used by the last solve.
+/// \return Iterations used last frame.
+
+const UINT CPositionSolver::GetLastIterations() const{
+  return m_nLastIterations;
+} //GetLastIterations
@@ -0,0 +1,57 @@
+/// \file PositionSolver.h
+/// \brief Interface for the position solver CPositionSolver.
+
+#ifndef __L4RC_GAME_POSITIONSOLVER_H__
+#define __L4RC_GAME_POSITIONSOLVER_H__
+
+#include <vector>
+
+#include "Common.h"
+#include "GameDefines.h"
+
+class CObject;
+
+/// \brief The position solver.
+///
+/// The position solver separates overlapping objects that push each other
+/// around, such as a crowd of zombies closing in on the player. Instead of
+/// each pair of objects shoving each other apart as soon as they are found to
+/// overlap, which in a crowd just pushes one object into the next, the
+/// overlapping pairs are collected as contacts and then relaxed together with
+/// the walls in a few Gauss-Seidel sweeps over a compact copy of the bodies
+/// involved. It stops as soon as nothing overlaps by more than a pixel or so,
+/// or when its iteration budget runs out, so a crowd settles over a few
+/// frames without the cost of a frame ever getting out of hand.
+
+class CPositionSolver: public CCommon{
+  private:
+    std::vector<float> m_vecPosX; ///< Body position x coordinates.
+    std::vector<float> m_vecPosY; ///< Body position y coordinates.
+    std::vector<float> m_vecRadius; ///< Body bounding circle radii.
+    std::vector<float> m_vecInvMass; ///< Body inverse masses, 0 for immovable.
+    std::vector<BYTE> m_vecMoved; ///< Whether each body moved since its wall test.
+    std::vector<CObject*> m_vecOwner; ///< Object that each body belongs to.
+
+    std::vector<UINT> m_vecContact; ///< Body index pairs of the contacts.
+    std::vector<UINT> m_vecBodyOf; ///< Body index for each handle slot.
+
+    UINT m_nIterations = SOLVER_ITERATIONS; ///< Iteration budget.
+    UINT m_nLastIterations = 0; ///< Iterations used by the last solve.
+
+    const UINT GetBody(CObject*); ///< Get or make body for an object.
+    static const float GetInvMass(const CObject*); ///< Inverse mass of an object.
+    const float SolveContact(UINT); ///< Relax one contact.
+    const float SolveWalls(UINT); ///< Push one body out of the walls.
+
+  public:
+    void reserve(size_t); ///< Reserve space for bodies and contacts.
+
+    void AddContact(CObject*, CObject*); ///< Add an overlapping pair.
+    void Solve(); ///< Separate everything and empty the solver.
+
+    void SetIterations(UINT); ///< Set the iteration budget.
+    const UINT GetIterations() const; ///< Get the iteration budget.
+    const UINT GetLastIterations() const; ///< Iterations used by the last solve.
+}; //CPositionSolver
+
+#endif //__L4RC_GAME_POSITIONSOLVER_H__
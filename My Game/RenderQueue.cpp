@@ -0,0 +1,185 @@
+/// \file RenderQueue.cpp
+/// \brief Code for the render queue CRenderQueue.
+
+#include "RenderQueue.h"
+
+/// Reserve space for a number of commands.
+/// \param n Number of commands.
+
+void CRenderQueue::reserve(size_t n){
+  m_vecCommand.reserve(n);
+  m_vecKey.reserve(n);
+  m_vecSortKey.reserve(n);
+  m_vecOrder.reserve(n);
+  m_vecScratchKey.reserve(n);
+  m_vecScratchOrder.reserve(n);
+} //reserve
+
+/// Remove all commands, keeping the space for them.
+
+void CRenderQueue::clear(){
+  m_vecCommand.clear();
+  m_vecKey.clear();
+  m_vecOrder.clear();
+
+  for(size_t& n: m_nLayerCount)
+    n = 0;
+
+  m_nTextureSwitches = 0;
+  m_bSorted = true;
+} //clear
+
+/// Reader function for the number of commands.
+/// \return Number of commands.
+
+const size_t CRenderQueue::size() const{
+  return m_vecCommand.size();
+} //size
+
+/// Pack a tint into 32 bits, 8 bits per component, clamping each component
+/// to the unit interval.
+/// \param v Tint.
+/// \return Packed tint, red in the low byte.
+
+const UINT CRenderQueue::PackTint(const XMFLOAT4& v){
+  auto pack = [](float f){
+    return (UINT)(std::min(std::max(f, 0.0f), 1.0f)*255.0f + 0.5f);};
+
+  return pack(v.x) | pack(v.y) << 8 | pack(v.z) << 16 | pack(v.w) << 24;
+} //PackTint
+
+/// Unpack a tint packed by `PackTint()`.
+/// \param n Packed tint.
+/// \return Tint.
+
+const XMFLOAT4 CRenderQueue::UnpackTint(UINT n){
+  const float s = 1.0f/255.0f;
+  return XMFLOAT4((n & 0xFF)*s, (n >> 8 & 0xFF)*s, (n >> 16 & 0xFF)*s, (n >> 24)*s);
+} //UnpackTint
+
+/// Make a command to draw a sprite, for adding to a render queue now or
+/// keeping to add later.
+/// \param desc Sprite descriptor.
+/// \param layer Layer to draw it in.
+/// \return Render command.
+
+const CRenderCommand CRenderQueue::MakeCommand(const LSpriteDesc2D& desc,
+  eRenderLayer layer)
+{
+  CRenderCommand c;
+  c.m_vPos = desc.m_vPos;
+  c.m_fRoll = desc.m_fRoll;
+  c.m_nTint = PackTint(desc.m_f4Tint);
+  c.m_nSprite = (uint16_t)desc.m_nSpriteIndex;
+  c.m_nFrame = (uint16_t)desc.m_nCurrentFrame;
+  c.m_eLayer = layer;
+  return c;
+} //MakeCommand
+
+/// Add a command to draw a sprite. The sort key has the layer above the
+/// sprite index, so sorting on it groups by layer first and texture second.
+/// \param desc Sprite descriptor.
+/// \param layer Layer to draw it in.
+
+void CRenderQueue::Add(const LSpriteDesc2D& desc, eRenderLayer layer){
+  const CRenderCommand c = MakeCommand(desc, layer);
+  Add(&c, 1);
+} //Add
+
+/// Add a batch of commands made earlier by `MakeCommand()`, copying them to
+/// the end of the buffer in one go.
+/// \param p Pointer to the first command.
+/// \param n Number of commands.
+
+void CRenderQueue::Add(const CRenderCommand* p, size_t n){
+  m_vecCommand.insert(m_vecCommand.end(), p, p + n);
+
+  for(size_t i=0; i<n; i++){
+    m_vecKey.push_back((UINT)p[i].m_eLayer << 16 | p[i].m_nSprite);
+    m_nLayerCount[(UINT)p[i].m_eLayer]++;
+  } //for
+
+  if(n > 0)m_bSorted = false;
+} //Add
+
+/// Sort the commands by key with a least significant digit first radix sort,
+/// one byte of the key per pass, leaving the commands and their keys where
+/// they are and sorting a list of their indices. A pass in which every key
+/// has the same byte wouldn't change anything, so it is skipped, which is
+/// the usual case for the high byte of the sprite index. Afterwards count
+/// the texture changes in the sorted order.
+
+void CRenderQueue::Sort(){
+  if(m_bSorted)return;
+
+  const size_t n = m_vecCommand.size();
+
+  m_vecSortKey = m_vecKey;
+  m_vecOrder.resize(n);
+
+  for(size_t i=0; i<n; i++)
+    m_vecOrder[i] = (UINT)i;
+
+  m_vecScratchKey.resize(n);
+  m_vecScratchOrder.resize(n);
+
+  for(UINT shift=0; shift<24; shift+=8){
+    size_t count[256] = {0}; //histogram of this byte
+
+    for(UINT k: m_vecSortKey)
+      count[k >> shift & 0xFF]++;
+
+    if(n > 0 && count[m_vecSortKey[0] >> shift & 0xFF] == n)
+      continue; //all the same
+
+    size_t sum = 0; //prefix sum, start of each bucket
+
+    for(size_t& c: count){
+      const size_t t = c;
+      c = sum;
+      sum += t;
+    } //for
+
+    for(size_t i=0; i<n; i++){
+      const size_t j = count[m_vecSortKey[i] >> shift & 0xFF]++;
+      m_vecScratchKey[j] = m_vecSortKey[i];
+      m_vecScratchOrder[j] = m_vecOrder[i];
+    } //for
+
+    m_vecSortKey.swap(m_vecScratchKey);
+    m_vecOrder.swap(m_vecScratchOrder);
+  } //for
+
+  m_nTextureSwitches = 0;
+
+  for(size_t i=1; i<n; i++)
+    if(m_vecCommand[m_vecOrder[i]].m_nSprite != m_vecCommand[m_vecOrder[i - 1]].m_nSprite)
+      m_nTextureSwitches++;
+
+  m_bSorted = true;
+} //Sort
+
+/// Get a command in sorted order. Call `Sort()` first.
+/// \param i Position in sorted order.
+/// \return Command.
+
+const CRenderCommand& CRenderQueue::GetCommand(size_t i) const{
+  return m_vecCommand[m_vecOrder[i]];
+} //GetCommand
+
+/// Reader function for the number of commands in a layer.
+/// \param layer Layer.
+/// \return Number of commands in that layer.
+
+const size_t CRenderQueue::GetCount(eRenderLayer layer) const{
+  return m_nLayerCount[(UINT)layer];
+} //GetCount
+
+/// Reader function for the number of times that consecutive commands in
+/// sorted order use different sprites, which is the number of texture
+/// changes that `Submit()` causes. Call `Sort()` first.
+/// \return Number of texture changes.
+
+const size_t CRenderQueue::GetNumTextureSwitches() const{
+  return m_nTextureSwitches;
+} //GetNumTextureSwitches
@@ -0,0 +1,95 @@
+/// \file RenderQueue.h
+/// \brief Interface for the render queue CRenderQueue.
+
+#ifndef __L4RC_GAME_RENDERQUEUE_H__
+#define __L4RC_GAME_RENDERQUEUE_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "GameDefines.h"
+#include "SpriteDesc.h"
+
+/// \brief Render command.
+///
+/// Everything needed to draw one sprite, packed into 24 bytes.
+
+struct CRenderCommand{
+  Vector2 m_vPos; ///< Position.
+  float m_fRoll = 0.0f; ///< Orientation.
+  UINT m_nTint = 0; ///< Tint packed as 8-bit RGBA.
+  uint16_t m_nSprite = 0; ///< Sprite index.
+  uint16_t m_nFrame = 0; ///< Animation frame.
+  eRenderLayer m_eLayer = eRenderLayer::Floor; ///< Layer.
+}; //CRenderCommand
+
+/// \brief The render queue.
+///
+/// The render queue collects a frame's sprites as render commands in a
+/// linear buffer, then sorts them by layer and, within each layer, by sprite
+/// so that the renderer changes texture as seldom as possible, and finally
+/// submits them all in one pass. The sort is a radix sort on a small integer
+/// key, so it takes linear time, and it is stable, so sprites that share a
+/// layer and a texture are drawn in the order that they were added. Apart
+/// from `Submit()`, which takes anything with a `Draw(const LSpriteDesc2D*)`
+/// function, the render queue doesn't touch the renderer, so it can be
+/// filled, sorted, and counted without one.
+
+class CRenderQueue{
+  private:
+    std::vector<CRenderCommand> m_vecCommand; ///< Commands in the order added.
+    std::vector<UINT> m_vecKey; ///< Sort key for each command.
+    std::vector<UINT> m_vecSortKey; ///< Sort keys in sorted order.
+    std::vector<UINT> m_vecOrder; ///< Command indices in sorted order.
+    std::vector<UINT> m_vecScratchKey; ///< Radix sort scratch keys.
+    std::vector<UINT> m_vecScratchOrder; ///< Radix sort scratch indices.
+
+    size_t m_nLayerCount[(UINT)eRenderLayer::Size] = {0}; ///< Commands in each layer.
+    size_t m_nTextureSwitches = 0; ///< Texture changes in sorted order.
+    bool m_bSorted = true; ///< Whether the order is up to date.
+
+    static const XMFLOAT4 UnpackTint(UINT); ///< Unpack tint from 32 bits.
+
+  public:
+    void reserve(size_t); ///< Reserve space for commands.
+    void clear(); ///< Remove all commands.
+    const size_t size() const; ///< Number of commands.
+
+    void Add(const LSpriteDesc2D&, eRenderLayer); ///< Add a command.
+    void Add(const CRenderCommand*, size_t); ///< Add prebuilt commands.
+    void Sort(); ///< Sort commands by layer and sprite.
+    template<class t> void Submit(t*); ///< Draw everything in sorted order.
+
+    const CRenderCommand& GetCommand(size_t) const; ///< Get command in sorted order.
+    const size_t GetCount(eRenderLayer) const; ///< Number of commands in a layer.
+    const size_t GetNumTextureSwitches() const; ///< Number of texture changes.
+
+    static const CRenderCommand MakeCommand(const LSpriteDesc2D&, eRenderLayer); ///< Make a command.
+    static const UINT PackTint(const XMFLOAT4&); ///< Pack tint into 32 bits.
+}; //CRenderQueue
+
+/// Sort the commands if they aren't already sorted, then draw each of them
+/// in order by filling in a single sprite descriptor and passing it to a
+/// renderer.
+/// \param pRenderer Pointer to anything that has a `Draw(const LSpriteDesc2D*)`
+/// function, normally the sprite renderer.
+
+template<class t> void CRenderQueue::Submit(t* pRenderer){
+  Sort();
+
+  LSpriteDesc2D desc; //sprite descriptor for every command
+
+  for(UINT i: m_vecOrder){
+    const CRenderCommand& c = m_vecCommand[i]; //shorthand
+
+    desc.m_vPos = c.m_vPos;
+    desc.m_fRoll = c.m_fRoll;
+    desc.m_nSpriteIndex = c.m_nSprite;
+    desc.m_nCurrentFrame = c.m_nFrame;
+    desc.m_f4Tint = UnpackTint(c.m_nTint);
+
+    pRenderer->Draw(&desc);
+  } //for
+} //Submit
+
+#endif //__L4RC_GAME_RENDERQUEUE_H__
@@ -0,0 +1,123 @@
+/// \file SpatialGrid.cpp
+/// \brief Code for the spatial index CSpatialGrid.
+
+#include "SpatialGrid.h"
+#include "Object.h"
+
+/// Start out with a single cell, which works for any world size until
+/// `Resize()` is called.
+
+CSpatialGrid::CSpatialGrid():
+  m_vecCell(1){
+} //constructor
+
+/// Make the grid just big enough to cover the world and empty it. Objects
+/// outside the world go in the nearest cell on the edge.
+/// \param vSize World width and height.
+
+void CSpatialGrid::Resize(const Vector2& vSize){
+  m_nWidth  = std::max(1U, (UINT)ceilf(vSize.x/m_fCellSize));
+  m_nHeight = std::max(1U, (UINT)ceilf(vSize.y/m_fCellSize));
+
+  m_vecCell.clear();
+  m_vecCell.resize(m_nWidth*m_nHeight);
+  m_vecCellOf.clear();
+  m_fMaxRadius = 0.0f;
+} //Resize
+
+/// Remove all objects, keeping the size of the grid.
+
+void CSpatialGrid::clear(){
+  for(auto& v: m_vecCell)
+    v.clear();
+
+  m_vecCellOf.clear();
+  m_fMaxRadius = 0.0f;
+} //clear
+
+/// Get the column of cells that contains an x coordinate.
+/// \param x Horizontal coordinate.
+/// \return Column index, clamped to the grid.
+
+const UINT CSpatialGrid::GetColumn(float x) const{
+  const float j = floorf(x/m_fCellSize);
+  return j <= 0.0f? 0: std::min((UINT)j, m_nWidth - 1);
+} //GetColumn
+
+/// Get the row of cells that contains a y coordinate.
+/// \param y Vertical coordinate.
+/// \return Row index, clamped to the grid.
+
+const UINT CSpatialGrid::GetRow(float y) const{
+  const float i = floorf(y/m_fCellSize);
+  return i <= 0.0f? 0: std::min((UINT)i, m_nHeight - 1);
+} //GetRow
+
+/// Get the cell that contains the center of an object.
+/// \param pObj Pointer to an object.
+/// \return Cell index.
+
+const UINT CSpatialGrid::GetCell(const CObject* pObj) const{
+  return GetRow(pObj->m_vPos.y)*m_nWidth + GetColumn(pObj->m_vPos.x);
+} //GetCell
+
+/// Take an object out of a cell by moving the last object in the cell into
+/// its place. Cells are small, so finding it is quick.
+/// \param pObj Pointer to an object.
+/// \param n Index of the cell that it is in.
+
+void CSpatialGrid::RemoveFromCell(CObject* pObj, UINT n){
+  std::vector<CObject*>& v = m_vecCell[n]; //shorthand
+
+  for(size_t i=0; i<v.size(); i++)
+    if(v[i] == pObj){
+      v[i] = v.back();
+      v.pop_back();
+      return;
+    } //if
+} //RemoveFromCell
+
+/// Insert an object into the cell for its position.
+/// \param pObj Pointer to an object that has a handle.
+
+void CSpatialGrid::Insert(CObject* pObj){
+  const UINT slot = pObj->m_hSelf.m_nIndex;
+
+  if(slot >= m_vecCellOf.size())
+    m_vecCellOf.resize(slot + 1, UINT_MAX);
+
+  if(m_vecCellOf[slot] != UINT_MAX)
+    RemoveFromCell(pObj, m_vecCellOf[slot]); //already in
+
+  const UINT n = GetCell(pObj);
+  m_vecCell[n].push_back(pObj);
+  m_vecCellOf[slot] = n;
+  m_fMaxRadius = std::max(m_fMaxRadius, pObj->m_fRadius);
+} //Insert
+
+/// Remove an object from the grid. Does nothing if it isn't in the grid.
+/// \param pObj Pointer to an object.
+
+void CSpatialGrid::Remove(CObject* pObj){
+  const UINT slot = pObj->m_hSelf.m_nIndex;
+  if(slot >= m_vecCellOf.size() || m_vecCellOf[slot] == UINT_MAX)return;
+
+  RemoveFromCell(pObj, m_vecCellOf[slot]);
+  m_vecCellOf[slot] = UINT_MAX;
+} //Remove
+
+/// Move an object to a different cell if it has crossed into one since it
+/// was last inserted or updated. Does nothing if it isn't in the grid.
+/// \param pObj Pointer to an object.
+
+void CSpatialGrid::Update(CObject* pObj){
+  const UINT slot = pObj->m_hSelf.m_nIndex;
+  if(slot >= m_vecCellOf.size() || m_vecCellOf[slot] == UINT_MAX)return;
+
+  const UINT n = GetCell(pObj);
+  if(n == m_vecCellOf[slot])return; //same cell
+
+  RemoveFromCell(pObj, m_vecCellOf[slot]);
+  m_vecCell[n].push_back(pObj);
+  m_vecCellOf[slot] = n;
+} //Update
@@ -0,0 +1,75 @@
+/// \file SpatialGrid.h
+/// \brief Interface for the spatial index CSpatialGrid.
+
+#ifndef __L4RC_GAME_SPATIALGRID_H__
+#define __L4RC_GAME_SPATIALGRID_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+
+class CObject;
+
+/// \brief The spatial grid.
+///
+/// The spatial grid is a uniform grid of square cells over the world, each
+/// holding the objects whose centers are in it. An object is only moved from
+/// one cell to another when it crosses a cell boundary, so keeping the grid
+/// up to date costs next to nothing for objects that don't move and very
+/// little for those that do. A query for a rectangle visits just the cells
+/// that it overlaps, widened by the radius of the largest object so that
+/// objects poking in from a neighboring cell aren't missed. Objects are
+/// found by the slot index of their handle, so each needs a handle before it
+/// goes in.
+
+class CSpatialGrid{
+  private:
+    float m_fCellSize = GRID_CELL_SIZE; ///< Width and height of a cell.
+    UINT m_nWidth = 1; ///< Number of columns.
+    UINT m_nHeight = 1; ///< Number of rows.
+    float m_fMaxRadius = 0.0f; ///< Largest radius of an object inserted so far.
+
+    std::vector<std::vector<CObject*>> m_vecCell; ///< Objects in each cell, row by row.
+    std::vector<UINT> m_vecCellOf; ///< Cell of the object in each handle slot.
+
+    const UINT GetColumn(float) const; ///< Column containing an x coordinate.
+    const UINT GetRow(float) const; ///< Row containing a y coordinate.
+    const UINT GetCell(const CObject*) const; ///< Cell containing an object.
+    void RemoveFromCell(CObject*, UINT); ///< Take an object out of a cell.
+
+  public:
+    CSpatialGrid(); ///< Constructor.
+
+    void Resize(const Vector2&); ///< Fit grid to world and empty it.
+    void clear(); ///< Remove all objects.
+
+    void Insert(CObject*); ///< Insert an object.
+    void Remove(CObject*); ///< Remove an object.
+    void Update(CObject*); ///< Move an object to the cell for its position.
+
+    template<class t> void Query(const Vector2&, const Vector2&, t) const; ///< Visit objects near a rectangle.
+}; //CSpatialGrid
+
+/// Call a function for each object in the cells that overlap a rectangle,
+/// widened by the radius of the largest object. Objects near the rectangle
+/// may be visited too, so the function should test each object itself if
+/// that matters.
+/// \param vMin Bottom left corner of the rectangle.
+/// \param vMax Top right corner of the rectangle.
+/// \param visit Function to call for each object, taking a `CObject*`.
+
+template<class t> void CSpatialGrid::Query(const Vector2& vMin,
+  const Vector2& vMax, t visit) const
+{
+  const UINT left   = GetColumn(vMin.x - m_fMaxRadius);
+  const UINT right  = GetColumn(vMax.x + m_fMaxRadius);
+  const UINT bottom = GetRow(vMin.y - m_fMaxRadius);
+  const UINT top    = GetRow(vMax.y + m_fMaxRadius);
+
+  for(UINT i=bottom; i<=top; i++)
+    for(UINT j=left; j<=right; j++)
+      for(CObject* pObj: m_vecCell[i*m_nWidth + j])
+        visit(pObj);
+} //Query
+
+#endif //__L4RC_GAME_SPATIALGRID_H__
@@ -10,9 +10,14 @@
 
 CStationaryTurret::CStationaryTurret(const Vector2& p) : CObject(eSprite::Turret, p) {
 	m_bStatic = true; 
+	m_eKind = eObjectKind::StationaryTurret;
 	m_fRoll = 0.0f; 
-	m_fRotSpeed = 0.0f; 
 	m_fSpeed = 0.0f;
+	m_pGunFireEvent = new LEventTimer(1.0f);
+}
+
+CStationaryTurret::~CStationaryTurret() {
+	delete m_pGunFireEvent;
 }
 
 
@@ -25,21 +30,22 @@ void CStationaryTurret::move() {
 
 
 
-void CStationaryTurret::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
+/// Take a hit from a projectile, which costs one point of health whatever
+/// the projectile is. Stationary turrets don't get pushed around.
+
+void CStationaryTurret::TakeHit() {
 	if (m_bDead)return; 
 
-	if (pObj && pObj->isBullet()) { 
-		if (--m_nHealth == 0) { 
-			m_pAudio->play(eSound::Boom);
-			m_bDead = true;
-			DeathFX(); 
-		} 
-
-		else { 
-			m_pAudio->play(eSound::Clang); 
-			const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth; 
-			m_f4Tint = XMFLOAT4(1.0f, f, f, 0); 
-		} 
+	if (--m_nHealth == 0) { 
+		m_pAudio->play(eSound::Boom);
+		m_bDead = true;
+		DeathFX(); 
+	} 
+
+	else { 
+		m_pAudio->play(eSound::Clang); 
+		const float f = 0.5f + 0.5f * (float)m_nHealth / m_nMaxHealth; 
+		m_f4Tint = XMFLOAT4(1.0f, f, f, 0); 
 	} 
 } 
 
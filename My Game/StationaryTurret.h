@@ -3,19 +3,22 @@
 #define __L4RC_GAME_STATIONARYTURRET_H__
 
 #include "Object.h"
+#include "EventTimer.h"
 #include "Enemy.h"
 
 class CStationaryTurret : public CObject {
 protected:
 	const UINT m_nMaxHealth = 8;
 	UINT m_nHealth = m_nMaxHealth; 
+	LEventTimer* m_pGunFireEvent = nullptr; ///< Gun fire timer.
 
-	virtual void CollisionResponse(const Vector2& norm, float d, CObject* pObj = nullptr); 
 	virtual void DeathFX(); 
 
 public:
 	CStationaryTurret(const Vector2& p);
+	virtual ~CStationaryTurret();
 	virtual void move(); 
+	void TakeHit(); ///< Take a hit from a projectile.
 }; 
 
 #endif 
\ No newline at end of file
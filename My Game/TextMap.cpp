@@ -0,0 +1,140 @@
+/// \file TextMap.cpp
+/// \brief Code for the text map reader CTextMap.
+
+#include <cctype>
+#include <cstdio>
+
+#include "TextMap.h"
+
+/// Read a map file, which must have a line feed at the end of every row and
+/// every row the same length, replacing the objects on it by floor tiles and
+/// noting where they are. Anything read before is forgotten.
+/// \param filename Name of the map file.
+/// \param t Tile width and height, for object positions.
+/// \return true if the map was read, otherwise `GetBadLine()` says why not.
+
+const bool CTextMap::Read(const char* filename, float t){
+  m_vecRow.clear();
+  m_vecTurrets.clear();
+  m_vecStationaryTurrets.clear();
+  m_vecZombies.clear();
+  m_vecFurniture.clear();
+  m_vPlayer = Vector2::Zero;
+  m_nBadLine = 0;
+
+  FILE* input = fopen(filename, "rb"); //map file handle
+  if(input == nullptr)return false; //missing
+
+  std::string s; //contents of the map file
+  char buffer[4096]; //read buffer
+
+  for(size_t n; (n = fread(buffer, 1, sizeof(buffer), input)) > 0;)
+    s.append(buffer, n);
+
+  fclose(input);
+
+  //split into rows, checking that they are all the same nonzero length
+
+  for(size_t i=0, j; (j = s.find('\n', i)) != std::string::npos; i=j + 1){
+    if(j == i || (!m_vecRow.empty() && j - i != m_vecRow[0].size())){
+      m_nBadLine = m_vecRow.size() + 1;
+      m_vecRow.clear();
+      return false;
+    } //if
+
+    m_vecRow.push_back(s.substr(i, j - i));
+  } //for
+
+  //objects, which stand on floor tiles
+
+  const size_t h = m_vecRow.size(); //shorthand
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<m_vecRow[i].size(); j++){
+      char& c = m_vecRow[i][j]; //shorthand
+      const Vector2 pos = t*Vector2(j + 0.5f, h - i - 0.5f); //center of tile
+
+      if(c == 'T')m_vecTurrets.push_back(pos);
+      else if(c == 'S')m_vecStationaryTurrets.push_back(pos);
+      else if(c == 'Z')m_vecZombies.push_back(pos);
+      else if(c == 'P')m_vPlayer = pos;
+
+      else if(isdigit((unsigned char)c)){
+        CFurniture f;
+        f.m_vPos = pos;
+        f.m_chType = c;
+        m_vecFurniture.push_back(f);
+      } //else if
+
+      else continue; //just a tile
+
+      c = 'F'; //floor tile
+    } //for
+
+  return true;
+} //Read
+
+/// Reader function for the width of the map.
+/// \return Number of tiles wide, 0 if no map has been read.
+
+const size_t CTextMap::GetWidth() const{
+  return m_vecRow.empty()? 0: m_vecRow[0].size();
+} //GetWidth
+
+/// Reader function for the height of the map.
+/// \return Number of tiles high, 0 if no map has been read.
+
+const size_t CTextMap::GetHeight() const{
+  return m_vecRow.size();
+} //GetHeight
+
+/// Reader function for a row of tiles.
+/// \param i Row, from the top.
+/// \return The tiles in the row, left to right.
+
+const std::string& CTextMap::GetRow(size_t i) const{
+  return m_vecRow[i];
+} //GetRow
+
+/// Reader function for the line at which the last read failed.
+/// \return Line number counting from 1, or 0 if the file couldn't be opened
+/// or the last read succeeded.
+
+const size_t CTextMap::GetBadLine() const{
+  return m_nBadLine;
+} //GetBadLine
+
+/// Reader function for the turret positions.
+/// \return Turret positions.
+
+const std::vector<Vector2>& CTextMap::GetTurrets() const{
+  return m_vecTurrets;
+} //GetTurrets
+
+/// Reader function for the stationary turret positions.
+/// \return Stationary turret positions.
+
+const std::vector<Vector2>& CTextMap::GetStationaryTurrets() const{
+  return m_vecStationaryTurrets;
+} //GetStationaryTurrets
+
+/// Reader function for the zombie positions.
+/// \return Zombie positions.
+
+const std::vector<Vector2>& CTextMap::GetZombies() const{
+  return m_vecZombies;
+} //GetZombies
+
+/// Reader function for the furniture.
+/// \return Furniture positions and types.
+
+const std::vector<CTextMap::CFurniture>& CTextMap::GetFurniture() const{
+  return m_vecFurniture;
+} //GetFurniture
+
+/// Reader function for the player position.
+/// \return Player position.
+
+const Vector2& CTextMap::GetPlayerPos() const{
+  return m_vPlayer;
+} //GetPlayerPos
@@ -0,0 +1,59 @@
+/// \file TextMap.h
+/// \brief Interface for the text map reader CTextMap.
+
+#ifndef __L4RC_GAME_TEXTMAP_H__
+#define __L4RC_GAME_TEXTMAP_H__
+
+#include <string>
+#include <vector>
+
+#include "GameDefines.h"
+
+/// \brief The text map reader.
+///
+/// A text map has one line per row of tiles, top first, and one character
+/// per tile: `W` for a wall, `F` for a floor, and so on. An object on the map
+/// is a character too, `T` for a turret, `S` for a stationary turret, `Z` for
+/// a zombie, a digit for a piece of furniture of that type, and `P` for the
+/// player, and each of them stands on a floor tile. The text map reader
+/// reads a map file into rows of tiles, with objects replaced by floor, and
+/// into the positions at which to spawn each kind of object. It uses nothing
+/// from the engine, so tools can read maps just as the tile manager does.
+
+class CTextMap{
+  public:
+    /// \brief Furniture.
+    ///
+    /// The position and type of a piece of furniture.
+
+    struct CFurniture{
+      Vector2 m_vPos; ///< Position.
+      char m_chType = '0'; ///< Type, a digit.
+    }; //CFurniture
+
+  private:
+    std::vector<std::string> m_vecRow; ///< Rows of tiles, top first.
+    size_t m_nBadLine = 0; ///< Line that failed to read, 0 if none.
+
+    std::vector<Vector2> m_vecTurrets; ///< Turret positions.
+    std::vector<Vector2> m_vecStationaryTurrets; ///< Stationary turret positions.
+    std::vector<Vector2> m_vecZombies; ///< Zombie positions.
+    std::vector<CFurniture> m_vecFurniture; ///< Furniture positions and types.
+    Vector2 m_vPlayer; ///< Player position.
+
+  public:
+    const bool Read(const char*, float); ///< Read a map file.
+
+    const size_t GetWidth() const; ///< Number of tiles wide.
+    const size_t GetHeight() const; ///< Number of tiles high.
+    const std::string& GetRow(size_t) const; ///< Row of tiles.
+    const size_t GetBadLine() const; ///< Line that failed to read.
+
+    const std::vector<Vector2>& GetTurrets() const; ///< Turret positions.
+    const std::vector<Vector2>& GetStationaryTurrets() const; ///< Stationary turret positions.
+    const std::vector<Vector2>& GetZombies() const; ///< Zombie positions.
+    const std::vector<CFurniture>& GetFurniture() const; ///< Furniture.
+    const Vector2& GetPlayerPos() const; ///< Player position.
+}; //CTextMap
+
+#endif //__L4RC_GAME_TEXTMAP_H__
@@ -0,0 +1,84 @@
+/// \file ThreadPool.cpp
+/// \brief Code for the thread pool CThreadPool.
+
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+/// Start the worker threads.
+/// \param n Number of worker threads, or 0 for one fewer than the number of
+/// hardware threads, leaving one for the thread that pushes the tasks.
+
+CThreadPool::CThreadPool(size_t n){
+  if(n == 0)
+    n = std::max(1U, std::thread::hardware_concurrency()) - 1;
+
+  n = std::max(n, (size_t)1);
+
+  for(size_t i=0; i<n; i++)
+    m_vecThread.push_back(std::thread(&CThreadPool::Run, this));
+} //constructor
+
+/// Let the workers finish the tasks already queued, then stop them.
+
+CThreadPool::~CThreadPool(){
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bStop = true;
+  }
+
+  m_cvTask.notify_all();
+
+  for(std::thread& t: m_vecThread)
+    t.join();
+} //destructor
+
+/// Worker thread function. Take tasks off the front of the queue and run
+/// them, sleeping while the queue is empty, until told to stop and there is
+/// nothing left to do.
+
+void CThreadPool::Run(){
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  for(;;){
+    m_cvTask.wait(lock, [this]{return m_bStop || !m_qTask.empty();});
+    if(m_qTask.empty())return; //stopping and nothing left
+
+    std::function<void()> task = std::move(m_qTask.front());
+    m_qTask.pop_front();
+    m_nBusy++;
+
+    lock.unlock();
+    task();
+    lock.lock();
+
+    m_nBusy--;
+    m_cvIdle.notify_all();
+  } //for
+} //Run
+
+/// Add a task to the back of the queue and wake a worker to run it.
+/// \param task Task.
+
+void CThreadPool::Push(std::function<void()> task){
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_qTask.push_back(std::move(task));
+  }
+
+  m_cvTask.notify_one();
+} //Push
+
+/// Block until the queue is empty and no task is running.
+
+void CThreadPool::Wait(){
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cvIdle.wait(lock, [this]{return m_qTask.empty() && m_nBusy == 0;});
+} //Wait
+
+/// Reader function for the number of worker threads.
+/// \return Number of worker threads.
+
+const size_t CThreadPool::GetNumThreads() const{
+  return m_vecThread.size();
+} //GetNumThreads
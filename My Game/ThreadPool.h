@@ -0,0 +1,47 @@
+/// \file ThreadPool.h
+/// \brief Interface for the thread pool CThreadPool.
+
+#ifndef __L4RC_GAME_THREADPOOL_H__
+#define __L4RC_GAME_THREADPOOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief The thread pool.
+///
+/// The thread pool is a fixed set of worker threads that take tasks from a
+/// shared queue in the order that they were pushed. It is meant for a batch
+/// of independent, chunky jobs such as decoding image files, where a mutex
+/// around the queue costs nothing next to the work. `Wait()` blocks until
+/// the queue is empty and every worker is idle. The destructor finishes the
+/// tasks already queued before joining the workers.
+
+class CThreadPool{
+  private:
+    std::vector<std::thread> m_vecThread; ///< Worker threads.
+    std::deque<std::function<void()>> m_qTask; ///< Tasks waiting to run.
+
+    std::mutex m_mutex; ///< Guards the queue and the counters.
+    std::condition_variable m_cvTask; ///< Signals a new task or stopping.
+    std::condition_variable m_cvIdle; ///< Signals that a task has finished.
+
+    size_t m_nBusy = 0; ///< Number of tasks running.
+    bool m_bStop = false; ///< Whether the workers are to stop.
+
+    void Run(); ///< Worker thread function.
+
+  public:
+    CThreadPool(size_t=0); ///< Constructor.
+    ~CThreadPool(); ///< Destructor.
+
+    void Push(std::function<void()>); ///< Queue a task.
+    void Wait(); ///< Wait for every task to finish.
+
+    const size_t GetNumThreads() const; ///< Number of worker threads.
+}; //CThreadPool
+
+#endif //__L4RC_GAME_THREADPOOL_H__
@@ -0,0 +1,137 @@
+/// \file TileChunks.cpp
+/// \brief Code for the baked tile chunks CTileChunks.
+
+#include <algorithm>
+#include <cmath>
+
+#include "TileChunks.h"
+
+/// Work out the tint for each light level, which goes from `LIGHT_AMBIENT`
+/// when unlit up to full brightness at `LIGHT_MAX`.
+
+CTileChunks::CTileChunks(){
+  for(UINT i=0; i<=LIGHT_MAX; i++){
+    const float b = LIGHT_AMBIENT + (1.0f - LIGHT_AMBIENT)*i/LIGHT_MAX; //brightness
+    m_nLightTint[i] = CRenderQueue::PackTint(XMFLOAT4(b, b, b, 1.0f));
+  } //for
+} //constructor
+
+/// Use a new map, which will be baked when it is next drawn.
+/// \param map The map, row by row from the top, which must outlive the chunks.
+/// \param w Number of tiles wide.
+/// \param h Number of tiles high.
+/// \param t Tile width and height.
+
+void CTileChunks::SetMap(char** map, size_t w, size_t h, float t){
+  m_chMap = map;
+  m_nWidth = w;
+  m_nHeight = h;
+  m_fTileSize = t;
+  m_eSprite = eSprite::Size; //chunks need rebaking
+} //SetMap
+
+/// Bake the render commands for the tiles in each chunk of the map, chunk
+/// by chunk, so that each chunk's commands are contiguous. Within a chunk
+/// the order is top-down, left-to-right so that the image agrees with the
+/// map text file viewed in NotePad. Each tile is tinted for its current
+/// light level, and where its command went is kept so that it can be
+/// retinted when its light level changes.
+/// \param t Sprite type for a 3-frame sprite: 0 is floor, 1 is wall, 2 is an error tile.
+/// \param lights Light grid for the map.
+
+void CTileChunks::Bake(eSprite t, CLightGrid& lights){
+  LSpriteDesc2D desc; //sprite descriptor for tile
+  desc.m_nSpriteIndex = (UINT)t; //sprite index for tile
+
+  const size_t n = TILE_CHUNK_SIZE; //shorthand
+  m_nChunksWide = (m_nWidth + n - 1)/n;
+  m_nChunksHigh = (m_nHeight + n - 1)/n;
+
+  m_vecCommand.clear();
+  m_vecCommand.reserve(m_nWidth*m_nHeight);
+  m_vecChunkStart.clear();
+  m_vecChunkStart.reserve(m_nChunksWide*m_nChunksHigh + 1);
+  m_vecTileCommand.resize(m_nWidth*m_nHeight);
+
+  for(size_t ci=0; ci<m_nChunksHigh; ci++) //for each row of chunks
+    for(size_t cj=0; cj<m_nChunksWide; cj++){ //for each chunk in the row
+      m_vecChunkStart.push_back(m_vecCommand.size());
+
+      for(size_t i=ci*n; i<std::min((ci + 1)*n, m_nHeight); i++) //for each row
+        for(size_t j=cj*n; j<std::min((cj + 1)*n, m_nWidth); j++){ //for each column
+          desc.m_vPos.x = (j + 0.5f)*m_fTileSize; //horizontal component of tile position
+          desc.m_vPos.y = (m_nHeight - 1 - i + 0.5f)*m_fTileSize; //vertical component of tile position
+
+          switch(m_chMap[i][j]){ //select which frame of the tile sprite is to be drawn
+            case 'F': desc.m_nCurrentFrame = 4;  break; // floor
+            case 'W': desc.m_nCurrentFrame = 1;  break; //wall
+            case 'D': desc.m_nCurrentFrame = 3;  break; //One instance of Furniture
+            default:  desc.m_nCurrentFrame = 2;  break; //error tile
+          } //switch
+
+          const size_t k = i*m_nWidth + j; //tile index
+          m_vecTileCommand[k] = (UINT)m_vecCommand.size();
+          m_vecCommand.push_back(CRenderQueue::MakeCommand(desc, eRenderLayer::Floor));
+          m_vecCommand.back().m_nTint = m_nLightTint[lights.GetLevel((UINT)k)];
+        } //for
+    } //for
+
+  m_vecChunkStart.push_back(m_vecCommand.size());
+  m_eSprite = t;
+  lights.ClearChanged(); //baked in already
+} //Bake
+
+/// Retint the baked commands of the tiles whose light level changed since
+/// the last frame, which is nothing at all unless a light source moved to
+/// another tile, appeared, or went away.
+/// \param lights Light grid for the map.
+
+void CTileChunks::ApplyLight(CLightGrid& lights){
+  for(UINT k: lights.GetChanged())
+    m_vecCommand[m_vecTileCommand[k]].m_nTint = m_nLightTint[lights.GetLevel(k)];
+
+  lights.ClearChanged();
+} //ApplyLight
+
+/// Draw the background by copying the baked render commands for each chunk
+/// that overlaps the window into a render queue, baking them first if the
+/// map or the tile sprite has changed since they were last baked, and
+/// retinting those whose light level has changed. The tiles are in the
+/// floor layer, so they end up under everything else no matter when the
+/// queue is submitted.
+/// \param t Sprite type for a 3-frame sprite: 0 is floor, 1 is wall, 2 is an error tile.
+/// \param lights Light grid for the map.
+/// \param campos Camera position.
+/// \param winw Window width.
+/// \param winh Window height.
+/// \param q Render queue.
+
+void CTileChunks::Draw(eSprite t, CLightGrid& lights, const Vector2& campos,
+  int winw, int winh, CRenderQueue& q)
+{
+  if(m_nWidth == 0 || m_nHeight == 0)return; //no map
+  if(m_eSprite != t)Bake(t, lights);
+  ApplyLight(lights);
+
+  const int w = (int)ceil(winw/m_fTileSize) + 2; //width of window in tiles, with 2 extra
+  const int h = (int)ceil(winh/m_fTileSize) + 2; //height of window in tiles, with 2 extra
+
+  const Vector2 origin = campos + 0.5f*winw*Vector2(-1.0f, 1.0f); //position of top left corner of window
+
+  const int top = std::max(0, (int)m_nHeight - (int)round(origin.y/m_fTileSize) + 1); //index of top tile
+  const int bottom = std::min(top + h + 1, (int)m_nHeight - 1); //index of bottom tile
+
+  const int left = std::max(0, (int)round(origin.x/m_fTileSize) - 1); //index of left tile
+  const int right = std::min(left + w, (int)m_nWidth - 1); //index of right tile
+
+  if(top > bottom || left > right)return; //window is off the map
+
+  const int n = (int)TILE_CHUNK_SIZE; //shorthand
+
+  for(int ci=top/n; ci<=bottom/n; ci++) //for each row of chunks in view
+    for(int cj=left/n; cj<=right/n; cj++){ //for each chunk in view
+      const size_t k = ci*m_nChunksWide + cj; //chunk index
+      const size_t first = m_vecChunkStart[k];
+      q.Add(m_vecCommand.data() + first, m_vecChunkStart[k + 1] - first);
+    } //for
+} //Draw
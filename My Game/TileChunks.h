@@ -0,0 +1,50 @@
+/// \file TileChunks.h
+/// \brief Interface for the baked tile chunks CTileChunks.
+
+#ifndef __L4RC_GAME_TILECHUNKS_H__
+#define __L4RC_GAME_TILECHUNKS_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+#include "RenderQueue.h"
+#include "LightGrid.h"
+
+/// \brief The baked tile chunks.
+///
+/// The map is cut into square chunks of `TILE_CHUNK_SIZE` tiles, and the
+/// render commands for the tiles of each chunk are baked once, chunk by
+/// chunk, so that drawing the background is just a matter of copying the
+/// baked commands for the chunks in view into a render queue. Each tile is
+/// tinted for its light level, and just the tiles whose light level changed
+/// are retinted in place. This is the tile manager's background, split off
+/// from it so that it uses nothing from the engine but the sprite
+/// descriptor, which lets tools draw the background just as the game does.
+
+class CTileChunks{
+  private:
+    char** m_chMap = nullptr; ///< The map, which belongs to the tile manager.
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    float m_fTileSize = 0.0f; ///< Tile width and height.
+
+    std::vector<CRenderCommand> m_vecCommand; ///< Baked tile commands, chunk by chunk.
+    std::vector<size_t> m_vecChunkStart; ///< First command of each chunk, then the end.
+    size_t m_nChunksWide = 0; ///< Number of chunks wide.
+    size_t m_nChunksHigh = 0; ///< Number of chunks high.
+    eSprite m_eSprite = eSprite::Size; ///< Tile sprite baked in, `Size` if none.
+    std::vector<UINT> m_vecTileCommand; ///< Baked command for each tile, row by row.
+
+    UINT m_nLightTint[LIGHT_MAX + 1] = {0}; ///< Packed tint for each light level.
+
+    void Bake(eSprite, CLightGrid&); ///< Bake render commands for each chunk.
+    void ApplyLight(CLightGrid&); ///< Retint tiles whose light level changed.
+
+  public:
+    CTileChunks(); ///< Constructor.
+
+    void SetMap(char**, size_t, size_t, float); ///< Use a new map.
+    void Draw(eSprite, CLightGrid&, const Vector2&, int, int, CRenderQueue&); ///< Queue the chunks in view.
+}; //CTileChunks
+
+#endif //__L4RC_GAME_TILECHUNKS_H__
@@ -1,19 +1,25 @@
 /// \file TileManager.cpp
 /// \brief Code for the tile manager CTileManager.
-#define STBI_ASSERT(x)
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include <cfloat>
+#include <cstring>
+
 #include "TileManager.h"
+#include "TextMap.h"
+#include "ImageDecoder.h"
 #include "SpriteRenderer.h"
 #include "Abort.h"
+#include "Helpers.h"
 
 /// Construct a tile manager using square tiles, given the width and height
-/// of each tile.
+/// of each tile. The pixel sprite must already have been loaded, for the
+/// minimap.
 /// \param n Width and height of square tile in pixels.
 
 CTileManager::CTileManager(size_t n):
-  m_fTileSize((float)n){
-} //constructor
+  m_fTileSize((float)n),
+  m_cMinimap(Vector2(m_pRenderer->GetWidth(eSprite::Pixel),
+    m_pRenderer->GetHeight(eSprite::Pixel)), m_nWinWidth, m_nWinHeight)
+{} //constructor
 
 /// Delete the memory used for storing the map.
 
@@ -42,12 +48,16 @@ void CTileManager::LoadMapFromImageFile(char* filename) {
         delete[] m_chMap;
     } //if
 
-    //read map file into a byte buffer 
+    //decode the map image
+
+    CDecodedImage img;
+    if(!CImageDecoder::DecodeFile(filename, img))
+      ABORT("Map %s not found.", filename); //panic
 
-    int channels = 0, w = 0, h = 0;
-    unsigned char* buffer = stbi_load(filename, &w, &h, &channels, 0);
-    m_nWidth = (size_t)w;
-    m_nHeight = (size_t)h;
+    const unsigned char* buffer = img.GetData();
+    const int channels = img.m_nChannels;
+    m_nWidth = (size_t)img.m_nWidth;
+    m_nHeight = (size_t)img.m_nHeight;
 
     //allocate space for the map 
 
@@ -74,8 +84,9 @@ void CTileManager::LoadMapFromImageFile(char* filename) {
         } 
     m_vWorldSize = Vector2((float)m_nWidth, (float)m_nHeight) * m_fTileSize;
     MakeBoundingBoxes();
-
-    stbi_image_free(buffer);
+    m_cLightGrid.Resize(m_chMap, m_nWidth, m_nHeight, m_fTileSize); //dark, no lights
+    m_cMinimap.Build(m_chMap, m_nWidth, m_nHeight, m_fTileSize);
+    m_cChunks.SetMap(m_chMap, m_nWidth, m_nHeight, m_fTileSize);
 } //LoadMapFromImageFile
 
 
@@ -191,11 +202,21 @@ void CTileManager::MakeBoundingBoxes(){
   } //for
 } //MakeBoundingBoxes
 
-/// Delete the old map (if any), allocate the right sized chunk of memory for
-/// the new map, and read it from a text file.
+/// Delete the old map (if any), read the new one from a text file, and
+/// allocate the right sized chunk of memory for it.
 /// \param filename Name of the map file.
 
 void CTileManager::LoadMap(char* filename){
+  CTextMap map; //the map file
+
+  if(!map.Read(filename, m_fTileSize)){
+    if(map.GetBadLine() == 0) //abort if it's missing
+      ABORT("Map %s not found.", filename); //panic
+
+    ABORT("Line %d of map is not the same length as the previous one.",
+      (int)map.GetBadLine());
+  } //if
+
   if(m_chMap != nullptr){ //unload any previous maps
     for(size_t i=0; i<m_nHeight; i++)
       delete [] m_chMap[i];
@@ -203,112 +224,37 @@ void CTileManager::LoadMap(char* filename){
     delete [] m_chMap;
   } //if
 
-  m_vecTurrets.clear(); //clear out the turret list
-  m_vecFurniture.clear(); //clear out furniture list
-  m_vecStationaryTurrets.clear();
-
-  FILE *input; //input file handle
-
-  fopen_s(&input, filename, "rb"); //open the map file
-  if(input == nullptr) //abort if it's missing
-    ABORT("Map &s not found.", filename); //panic
+  //allocate space for the map and copy it in
 
-  //read map file into a character buffer 
-
-  fseek(input, 0, SEEK_END); //seek to end of map file
-  const size_t n = ftell(input); //get file size in bytes
-  rewind(input); //seek to start of file
-
-  char *buffer = new char[n + 1]; //temporary character buffer
-  fread(buffer, n, 1, input); //read the whole thing in a chunk
-  fclose(input); //close the map file, we're done with it
-
-  //get map width and height into m_nWidth and m_nHeight
-
-  m_nWidth = 0; 
-  m_nHeight = 0;
-  size_t w = 0; //width of current row
-  bool bFirstLine = true;
-
-  for(size_t i=0; i<n; i++){
-    if(buffer[i] != '\n')
-      w++; //skip characters until the end of line
-    else{
-      if(w == 0)ABORT("Panic!"); //should never happen
-
-      if(w != m_nWidth && !bFirstLine && w != 0) //not the same length as the previous one
-        ABORT("Line %d of map is not the same length as the previous one.", m_nHeight);
-
-      m_nWidth = w; w = 0; m_nHeight++; //next line
-      bFirstLine = false; //the next line is not the first
-    } //else
-  } //for
-
-
-  //allocate space for the map 
-  
+  m_nWidth = map.GetWidth();
+  m_nHeight = map.GetHeight();
   m_chMap = new char*[m_nHeight];
 
-  for(size_t i=0; i<m_nHeight; i++)
-    m_chMap[i] = new char[m_nWidth];
-
-  //load the map information from the buffer to the map
-
-  size_t index = 0; //index into character buffer
-  
   for(size_t i=0; i<m_nHeight; i++){
-    for(size_t j=0; j<m_nWidth; j++){
-      const char c = buffer[index];
-
-      if(c == 'T'){
-        m_chMap[i][j] = 'F'; //floor tile
-        const Vector2 pos = m_fTileSize*Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-        m_vecTurrets.push_back(pos);
-      } //if
-
-      else if (c == 'S') {
-          m_chMap[i][j] = 'F'; 
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vecStationaryTurrets.push_back(pos);
-      }
-      
-      else if (isdigit(c)) { //furniture
-          m_chMap[i][j] = 'F'; //floor tile
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          furniture furn;
-		  furn.location = pos;
-		  furn.type = c;
-          m_vecFurniture.push_back(furn);
-      } //else if
-      
-      else if(c == 'P'){
-        m_chMap[i][j] = 'F'; //floor tile
-        m_vPlayer = m_fTileSize*Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-        furniture furn;
-		furn.location = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 5.5f);
-		furn.type = 'H'; //health bar above player
-        m_vecFurniture.push_back(furn);
-      } //else if
-
-      else if (c == 'Z') {
-          m_chMap[i][j] = 'F'; // zombies stand on floor tiles
-          const Vector2 pos = m_fTileSize * Vector2(j + 0.5f, m_nHeight - i - 0.5f);
-          m_vecZombies.push_back(pos);
-      }
-
+    m_chMap[i] = new char[m_nWidth];
+    memcpy(m_chMap[i], map.GetRow(i).data(), m_nWidth);
+  } //for
 
-      else m_chMap[i][j] = c; //load character into map
+  //objects on the map
 
-      index++; //next index
-    } //for
+  m_vecTurrets = map.GetTurrets();
+  m_vecStationaryTurrets = map.GetStationaryTurrets();
+  m_vecZombies = map.GetZombies();
+  m_vPlayer = map.GetPlayerPos();
+  m_vecFurniture.clear();
 
-    index += 1; //skip end of line character (assume single linefeed now)
+  for(const CTextMap::CFurniture& f: map.GetFurniture()){
+    furniture furn;
+    furn.location = f.m_vPos;
+    furn.type = f.m_chType;
+    m_vecFurniture.push_back(furn);
   } //for
 
   m_vWorldSize = Vector2((float)m_nWidth, (float)m_nHeight)*m_fTileSize;
   MakeBoundingBoxes();
-
-  delete [] buffer; //clean up
+  m_cLightGrid.Resize(m_chMap, m_nWidth, m_nHeight, m_fTileSize); //dark, no lights
+  m_cMinimap.Build(m_chMap, m_nWidth, m_nHeight, m_fTileSize);
+  m_cChunks.SetMap(m_chMap, m_nWidth, m_nHeight, m_fTileSize);
 } //LoadMap
 
 /// Get positions of objects listed on map.
@@ -332,42 +278,15 @@ void CTileManager::DrawBoundingBoxes(eSprite t){
     m_pRenderer->DrawBoundingBox(t, p);
 } //DrawBoundingBoxes
 
-/// Draw order is top-down, left-to-right so that the image
-/// agrees with the map text file viewed in NotePad.
+/// Draw the background by putting the baked tile chunks in view into a
+/// render queue. The tiles are in the floor layer, so they end up under
+/// everything else no matter when the queue is submitted.
 /// \param t Sprite type for a 3-frame sprite: 0 is floor, 1 is wall, 2 is an error tile.
+/// \param q Render queue.
  
-void CTileManager::Draw(eSprite t){
-  LSpriteDesc2D desc; //sprite descriptor for tile
-  desc.m_nSpriteIndex = (UINT)t; //sprite index for tile
-
-  
-
-  const int w = (int)ceil(m_nWinWidth/m_fTileSize) + 2; //width of window in tiles, with 2 extra
-  const int h = (int)ceil(m_nWinHeight/m_fTileSize) + 2; //height of window in tiles, with 2 extra
-
-  const Vector2 campos = m_pRenderer->GetCameraPos(); //camera position
-  const Vector2 origin = campos + 0.5f*m_nWinWidth*Vector2(-1.0f, 1.0f); //position of top left corner of window
-
-  const int top = std::max(0, (int)m_nHeight - (int)round(origin.y/m_fTileSize) + 1); //index of top tile
-  const int bottom = std::min(top + h + 1, (int)m_nHeight - 1); //index of bottom tile
-
-  const int left = std::max(0, (int)round(origin.x/m_fTileSize) - 1); //index of left tile
-  const int right = std::min(left + w, (int)m_nWidth - 1); //index of right tile
-
-  for(int i=top; i<=bottom; i++) //for each column
-    for(int j=left; j<=right; j++){ //for each row
-      desc.m_vPos.x = (j + 0.5f)*m_fTileSize; //horizontal component of tile position
-      desc.m_vPos.y = (m_nHeight - 1 - i + 0.5f)*m_fTileSize; //vertical component of tile position
-
-      switch(m_chMap[i][j]){ //select which frame of the tile sprite is to be drawn
-	  case 'F': desc.m_nCurrentFrame = 4;  break; // floor
-      case 'W': desc.m_nCurrentFrame = 1;  break; //wall
-      case 'D': desc.m_nCurrentFrame = 3;  break; //One instance of Furniture
-      default:  desc.m_nCurrentFrame = 2;  break; //error tile
-      } //switch
-
-      m_pRenderer->Draw(&desc); //finally we can draw a tile
-    } //for
+void CTileManager::Draw(eSprite t, CRenderQueue& q){
+  m_cChunks.Draw(t, m_cLightGrid, m_pRenderer->GetCameraPos(),
+    m_nWinWidth, m_nWinHeight, q);
 } //Draw
 
 /// Check whether a circle is visible from a point, that is, either the left
@@ -472,4 +391,108 @@ const bool CTileManager::CollideWithWall(
   } //for
 
   return hit;
-} //CollideWithWall
\ No newline at end of file
+} //CollideWithWall
+
+/// Sweep a bounding sphere along a displacement vector and find the earliest
+/// time at which it touches a wall bounding box. This is a ray cast of the
+/// sphere center against each wall expanded by the sphere radius. The slab
+/// test against the expanded box gives the entry time and face, and when the
+/// entry point falls in one of the expanded box's corner regions the ray is
+/// tested against a circle at the wall's corner instead, which gives the
+/// exact rounded Minkowski sum. Spheres that already overlap a wall at the
+/// start of the sweep are ignored here and left to `CollideWithWall()`.
+/// \param s Bounding sphere of object at the start of the sweep.
+/// \param v Displacement of the object over the sweep.
+/// \param t [out] Time of impact as a fraction of the displacement.
+/// \param norm [out] Collision normal at the time of impact.
+/// \return true If the sphere hits a wall during the sweep.
+
+const bool CTileManager::SweepWithWall(const BoundingSphere& s,
+  const Vector2& v, float& t, Vector2& norm) const
+{
+  const Vector2 c(s.Center.x, s.Center.y); //start position
+  const float r = s.Radius; //shorthand
+  bool hit = false; //return result, true if there is a collision with a wall
+  t = 1.0f; //earliest time of impact so far
+
+  for(const BoundingBox& aabb: m_vecWalls){
+    const float fLeft   = aabb.Center.x - aabb.Extents.x; //left of wall
+    const float fRight  = aabb.Center.x + aabb.Extents.x; //right of wall
+    const float fBottom = aabb.Center.y - aabb.Extents.y; //bottom of wall
+    const float fTop    = aabb.Center.y + aabb.Extents.y; //top of wall
+
+    //slab test against the wall expanded by the radius
+
+    float tEnter = -FLT_MAX; //entry time
+    float tExit = FLT_MAX; //exit time
+    Vector2 n; //normal of the face entered last
+
+    const float lo[2] = {fLeft - r, fBottom - r}; //expanded minimum
+    const float hi[2] = {fRight + r, fTop + r}; //expanded maximum
+    const float p[2] = {c.x, c.y}; //start position as array
+    const float d[2] = {v.x, v.y}; //displacement as array
+    bool miss = false; //true if the ray misses the expanded box
+
+    for(int i=0; i<2 && !miss; i++){
+      if(d[i] == 0.0f) //parallel to this slab
+        miss = p[i] < lo[i] || p[i] > hi[i];
+
+      else{
+        float t0 = (lo[i] - p[i])/d[i]; //time at the low plane
+        float t1 = (hi[i] - p[i])/d[i]; //time at the high plane
+        float sign = -1.0f; //entered through the low plane
+        if(t0 > t1){std::swap(t0, t1); sign = 1.0f;}
+
+        if(t0 > tEnter){ //entry through this slab is later
+          tEnter = t0;
+          n = (i == 0)? sign*Vector2::UnitX: sign*Vector2::UnitY;
+        } //if
+
+        tExit = std::min(tExit, t1);
+        miss = tEnter > tExit;
+      } //else
+    } //for
+
+    if(miss || tEnter < 0.0f || tEnter > t) //no earlier hit on this wall
+      continue;
+
+    //corner regions of the expanded box are rounded
+
+    const Vector2 q = c + tEnter*v; //entry point on expanded box
+    const bool bOutX = q.x < fLeft || q.x > fRight; //beyond a vertical edge
+    const bool bOutY = q.y < fBottom || q.y > fTop; //beyond a horizontal edge
+
+    if(bOutX && bOutY){ //in a corner region
+      const Vector2 corner(q.x < fLeft? fLeft: fRight, q.y < fBottom? fBottom: fTop);
+      float tCorner = 0.0f; //time of impact with the corner
+
+      if(!SweepCircle(c, v, corner, r, tCorner) || tCorner > t)
+        continue; //passes the rounded corner, or not earlier
+
+      tEnter = tCorner;
+      n = c + tEnter*v - corner;
+      n.Normalize();
+    } //if
+
+    t = tEnter;
+    norm = n;
+    hit = true;
+  } //for
+
+  return hit;
+} //SweepWithWall
+
+/// Reader function for the light grid, which is where light sources go.
+/// \return Reference to the light grid.
+
+CLightGrid& CTileManager::GetLightGrid(){
+  return m_cLightGrid;
+} //GetLightGrid
+
+/// Reader function for the minimap, which has to be told about any change
+/// to the map after it is loaded.
+/// \return Reference to the minimap.
+
+CMinimap& CTileManager::GetMinimap(){
+  return m_cMinimap;
+} //GetMinimap
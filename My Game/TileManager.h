@@ -10,10 +10,20 @@
 #include "Settings.h"
 #include "Sprite.h"
 #include "GameDefines.h"
+#include "RenderQueue.h"
+#include "TileChunks.h"
+#include "LightGrid.h"
+#include "Minimap.h"
 
 /// \brief The tile manager.
 ///
-/// The tile manager is responsible for the tile-based background.
+/// The tile manager is responsible for the tile-based background, which it
+/// draws from tile chunks that are baked once after the map is loaded.
+///
+/// The tile manager also owns the light grid for the map. Each baked tile is
+/// tinted for its light level, and before drawing, just the tiles whose
+/// light level changed since the last frame are retinted in place. It owns
+/// the minimap too, which is built from the map whenever one is loaded.
 
 class CTileManager: 
   public CCommon, 
@@ -36,6 +46,10 @@ class CTileManager:
  
     Vector2 m_vPlayer; ///< Player location.
 
+    CTileChunks m_cChunks; ///< Baked background.
+    CLightGrid m_cLightGrid; ///< Light level of each tile.
+    CMinimap m_cMinimap; ///< Minimap of the map.
+
     void MakeBoundingBoxes(); ///< Make bounding boxes for walls.
 
   public:
@@ -53,9 +67,13 @@ class CTileManager:
 
     void LoadMapFromImageFile(char*); ///< Load map.
     void LoadMap(char*); ///< Load a map.
-    void Draw(eSprite); ///< Draw the map with a given tile.
+    void Draw(eSprite, CRenderQueue&); ///< Draw the map with a given tile.
     void DrawBoundingBoxes(eSprite); ///< Draw the bounding boxes.
 
+    CLightGrid& GetLightGrid(); ///< Get the light grid.
+    CMinimap& GetMinimap(); ///< Get the minimap.
+
+    const std::vector<Vector2>& GetZombies() const { return m_vecZombies; }
     const std::vector<Vector2>& GetTurrets() const { return m_vecTurrets; }
     const std::vector<furniture>& GetFurniture() const { return m_vecFurniture; }
     const Vector2& GetPlayerPos() const { return m_vPlayer; }
@@ -67,6 +85,8 @@ class CTileManager:
 
     const bool Visible(const Vector2&, const Vector2&, float) const; ///< Check visibility.
     const bool CollideWithWall(BoundingSphere, Vector2&, float&) const; ///< Object-wall collision test.
+    const bool SweepWithWall(const BoundingSphere&, const Vector2&,
+      float&, Vector2&) const; ///< Swept object-wall collision test.
 }; //CTileManager
 
 #endif //__L4RC_GAME_TILEMANAGER_H__
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 CTurret::CTurret(const Vector2& p) : CObject(eSprite::Turret, p) {
     m_bStatic = true; //turrets are static
+    m_eKind = eObjectKind::Turret;
     m_fPatrolSpeed = 70.0f;
     m_vHomePos = p; // store spawn position
 } //constructor
@@ -29,13 +30,14 @@ void CTurret::InitializePatrol(const std::vector<Vector2>& points) {
 }
 
 void CTurret::move() {
-    const float t = m_pTimer->GetFrameTime();
+    const float t = GetStepTime();
     Vector2 desiredDir(0, 0);
     float moveSpeed = 0.0f;
     Vector2 targetPos;
+    CPlayer* pPlayer = m_pObjectManager->GetPlayer();
 
-    if (m_pPlayer) {
-        float distToPlayer = (m_pPlayer->GetPos() - m_vPos).Length();
+    if (pPlayer) {
+        float distToPlayer = (pPlayer->GetPos() - m_vPos).Length();
 
         if (distToPlayer < m_fFollowRadius)
             m_bChasing = true;
@@ -43,8 +45,8 @@ void CTurret::move() {
             m_bChasing = false;
     }
 
-    if (m_bChasing && m_pPlayer) {
-        targetPos = m_pPlayer->GetPos();
+    if (m_bChasing && pPlayer) {
+        targetPos = pPlayer->GetPos();
         moveSpeed = m_fPatrolSpeed * 2.5f;
     }
     else {
@@ -97,43 +99,6 @@ void CTurret::move() {
     }
 
     m_vPos = nextPos;
-    m_fRotSpeed = 0.0f;
-}
-
-void CTurret::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
-    if (m_bDead)return;
-
-    if (pObj && !pObj->isBullet()) {
-        const float MAX_PUSH_DISTANCE = 5.0f;
-        const float COLLISION_EPSILON = 0.05f;
-        float required_total_push = d + COLLISION_EPSILON;
-        float required_push_half = required_total_push * 0.5f;
-        float safe_d = std::min(required_push_half, MAX_PUSH_DISTANCE);
-        m_vPos += norm * safe_d;
-    }
-
-    if (pObj && pObj->isBullet()) {
-
-        int damageToTake = 1;
-
-        if (pObj->m_nSpriteIndex == (UINT)eSprite::Fireball) {
-            damageToTake = FIREBALL_DAMAGE;
-        }
-        else if (pObj->m_nSpriteIndex == (UINT)eSprite::sword) {
-            damageToTake = SWORD_DAMAGE;
-        }
-        else if (pObj->m_nSpriteIndex == (UINT)eSprite::greatsword) {
-            damageToTake = GREATSWORD_DAMAGE;
-        }
-
-        else if (pObj->m_nSpriteIndex == (UINT)eSprite::dagger) {
-            damageToTake = DAGGER_DAMAGE;
-        }
-
-        pObj->SetDead();
-
-        this->TakeDamage(damageToTake);
-    }
 }
 
 void CTurret::TakeDamage(int damage) {
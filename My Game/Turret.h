@@ -14,7 +14,6 @@ protected:
     UINT m_nHealth = m_nMaxHealth;
 
     //void RotateTowards(const Vector2&); ///< Swivel towards position.
-    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
     virtual void DeathFX(); ///< Death special effects.
 
     std::vector<Vector2> m_vPatrolPoints;
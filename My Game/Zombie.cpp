@@ -15,12 +15,12 @@
 /// \param p Position of Zombie.
 CZombie::CZombie(const Vector2& p) : CObject(eSprite::ZombieStandDown, p) {
     m_bStatic = true;
+    m_eKind = eObjectKind::Zombie;
     m_fPatrolSpeed = 70.0f;
     m_vHomePos = p;
 
     m_fRadius = 16.0f; // reduce zombie collision radius to match player/turret
 
-    m_pFrameEvent = new LEventTimer(0.12f);
     m_pDirectionCooldown = new LEventTimer(0.1f); // add cooldown for direction flip
 
     m_nLastSpriteIndex = m_nSpriteIndex;
@@ -37,13 +37,14 @@ void CZombie::InitializePatrol(const std::vector<Vector2>& points) {
 }
 
 void CZombie::move() {
-    const float t = m_pTimer->GetFrameTime();
+    const float t = GetStepTime();
     Vector2 desiredDir(0, 0);
     float moveSpeed = 0.0f;
     Vector2 targetPos;
+    CPlayer* pPlayer = m_pObjectManager->GetPlayer();
 
-    if (m_pPlayer) {
-        float distToPlayer = (m_pPlayer->GetPos() - m_vPos).Length();
+    if (pPlayer) {
+        float distToPlayer = (pPlayer->GetPos() - m_vPos).Length();
 
         if (distToPlayer < m_fFollowRadius)
             m_bChasing = true;
@@ -51,8 +52,8 @@ void CZombie::move() {
             m_bChasing = false;
     }
 
-    if (m_bChasing && m_pPlayer) {
-        targetPos = m_pPlayer->GetPos();
+    if (m_bChasing && pPlayer) {
+        targetPos = pPlayer->GetPos();
         moveSpeed = m_fPatrolSpeed * 2.5f;
     }
     else {
@@ -82,33 +83,34 @@ void CZombie::move() {
     }
 
     bool isMoving = desiredDir.x != 0 || desiredDir.y != 0;
+    UINT sprite = m_nSpriteIndex; //sprite to show
 
     if (isMoving) {
         if (desiredDir != m_vLastDirection && m_pDirectionCooldown->Triggered()) {
             if (desiredDir.x > 0)
-                m_nSpriteIndex = (UINT)eSprite::ZombieWalkRight;
+                sprite = (UINT)eSprite::ZombieWalkRight;
             else if (desiredDir.x < 0)
-                m_nSpriteIndex = (UINT)eSprite::ZombieWalkLeft;
+                sprite = (UINT)eSprite::ZombieWalkLeft;
             else if (desiredDir.y < 0)
-                m_nSpriteIndex = (UINT)eSprite::ZombieWalkDown;
+                sprite = (UINT)eSprite::ZombieWalkDown;
             else if (desiredDir.y > 0)
-                m_nSpriteIndex = (UINT)eSprite::ZombieWalkUp;
+                sprite = (UINT)eSprite::ZombieWalkUp;
             m_vLastDirection = desiredDir;
         }
     }
     else {
-        switch (m_nSpriteIndex) {
-        case (UINT)eSprite::ZombieWalkLeft:  m_nSpriteIndex = (UINT)eSprite::ZombieStandLeft; break;
-        case (UINT)eSprite::ZombieWalkRight: m_nSpriteIndex = (UINT)eSprite::ZombieStandRight; break;
-        case (UINT)eSprite::ZombieWalkUp:    m_nSpriteIndex = (UINT)eSprite::ZombieStandUp; break;
-        case (UINT)eSprite::ZombieWalkDown:  m_nSpriteIndex = (UINT)eSprite::ZombieStandDown; break;
+        switch (sprite) {
+        case (UINT)eSprite::ZombieWalkLeft:  sprite = (UINT)eSprite::ZombieStandLeft; break;
+        case (UINT)eSprite::ZombieWalkRight: sprite = (UINT)eSprite::ZombieStandRight; break;
+        case (UINT)eSprite::ZombieWalkUp:    sprite = (UINT)eSprite::ZombieStandUp; break;
+        case (UINT)eSprite::ZombieWalkDown:  sprite = (UINT)eSprite::ZombieStandDown; break;
         default: break;
         }
     }
 
-    if (m_nSpriteIndex != m_nLastSpriteIndex) {
-        m_nCurrentFrame = 0;
-        m_nLastSpriteIndex = m_nSpriteIndex;
+    if (sprite != m_nLastSpriteIndex) {
+        SetAnimation(sprite);
+        m_nLastSpriteIndex = sprite;
     }
 
     m_bIsMoving = isMoving;
@@ -123,45 +125,12 @@ void CZombie::move() {
     }
 
     m_vPos = nextPos;
-    UpdateFramenumber();
-    m_fRotSpeed = 0.0f;
-}
-
-void CZombie::UpdateFramenumber() {
-    const UINT n = (UINT)m_pRenderer->GetNumFrames(m_nSpriteIndex);
-    if (n > 1 && m_pFrameEvent && m_pFrameEvent->Triggered())
-        m_nCurrentFrame = (m_nCurrentFrame + 1) % n;
 }
 
 Vector2 CZombie::GetDominantDirection(const Vector2& v) {
     return (fabsf(v.x) > fabsf(v.y)) ? Vector2((v.x > 0) ? 1 : -1, 0) : Vector2(0, (v.y > 0) ? 1 : -1);
 }
 
-void CZombie::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
-    if (m_bDead) return;
-
-    if (pObj && !pObj->isBullet()) {
-        const float MAX_PUSH_DISTANCE = 5.0f;
-        const float COLLISION_EPSILON = 0.05f;
-        float required_total_push = d + COLLISION_EPSILON;
-        float required_push_half = required_total_push * 0.5f;
-        float safe_d = std::min(required_push_half, MAX_PUSH_DISTANCE);
-        m_vPos += norm * safe_d;
-    }
-
-    if (pObj && pObj->isBullet()) {
-        int damageToTake = 1;
-
-        if (pObj->m_nSpriteIndex == (UINT)eSprite::Fireball) damageToTake = FIREBALL_DAMAGE;
-        else if (pObj->m_nSpriteIndex == (UINT)eSprite::sword) damageToTake = SWORD_DAMAGE;
-        else if (pObj->m_nSpriteIndex == (UINT)eSprite::greatsword) damageToTake = GREATSWORD_DAMAGE;
-        else if (pObj->m_nSpriteIndex == (UINT)eSprite::dagger) damageToTake = DAGGER_DAMAGE;
-
-        pObj->SetDead();
-        TakeDamage(damageToTake);
-    }
-}
-
 void CZombie::TakeDamage(int damage) {
     if (m_bDead) return;
 
@@ -205,6 +174,5 @@ void CZombie::DeathFX() {
 }
 
 CZombie::~CZombie() {
-    delete m_pFrameEvent;
     delete m_pDirectionCooldown;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #define __L4RC_GAME_Zombie_H__ //__L4RC_GAME_TURRET_H__
 
 #include "Object.h"
+#include "EventTimer.h"
 
 
 
@@ -14,7 +15,6 @@ class CZombie: public CObject{
     UINT m_nHealth = m_nMaxHealth; 
     
     //void RotateTowards(const Vector2&); ///< Swivel towards position.
-    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
     virtual void DeathFX(); ///< Death special effects.
 
     std::vector<Vector2> m_vPatrolPoints;
@@ -27,7 +27,6 @@ class CZombie: public CObject{
     float m_fReturnSpeed = 2.0f;
     
     LEventTimer* m_pDirectionCooldown = nullptr;
-    LEventTimer* m_pFrameEvent = nullptr;
     Vector2 m_vLastDirection = Vector2(0, 0);
     bool m_bIsMoving = false;
     Vector2 GetDominantDirection(const Vector2& v);
@@ -43,7 +42,6 @@ class CZombie: public CObject{
     void InitializePatrol(const std::vector<Vector2>& points);
     CZombie(const Vector2& p); 
     ~CZombie();
-    void UpdateFramenumber();
 
 
     virtual void move(); 
@@ -0,0 +1,693 @@
+/// \file AtlasPacker.cpp
+/// \brief Offline texture atlas packer.
+///
+/// Reads the `<sprites>` element of a settings file such as
+/// `Media/XML/gamesettings.xml`, packs every image that it refers to into as
+/// few atlases as possible with the MaxRects packer, writes the atlases out
+/// as PNG files next to the original images, and writes a copy of the
+/// settings file whose `<sprites>` element draws every sprite from an atlas.
+/// Sprites keep their names, frame counts, and frame sizes, so
+/// `LSpriteRenderer::Load` in `CGame::LoadImages` works unchanged on the new
+/// settings file; only the number of textures goes down.
+///
+/// Each atlas is itself a sprite with a `file` attribute, and every other
+/// sprite becomes a sheet sprite on an atlas, in the same form as the walk
+/// and attack animations already use. So:
+///
+/// - A single-image sprite becomes a one-frame sheet sprite.
+/// - A multi-image sprite (`file`, `ext`, `frames`) becomes a sheet sprite
+///   with one frame per image, all in the same atlas.
+/// - A sheet sprite keeps its frame rectangles, moved to wherever its sheet
+///   went, and its sheet is packed whole so that the sheet's own sprite still
+///   works.
+///
+/// Each image is surrounded by a border of copies of its edge pixels so that
+/// filtering at the edge of a frame doesn't pick up its neighbor in the
+/// atlas.
+///
+/// Run it from the folder that the game runs from, for example:
+///
+///     AtlasPacker Media\XML\gamesettings.xml Media\XML\gamesettings-atlas.xml
+///
+/// The engine always reads `Media\XML\gamesettings.xml`, so to play with the
+/// atlases copy the new settings file over it, or give the same file name
+/// for both.
+///
+/// Options are `--size n` for the largest atlas width and height (default
+/// 2048), `--border n` for the border width (default 1), and `--name s` for
+/// the atlas name prefix (default `atlas`). It depends on nothing but
+/// `stb_image.h` from the game, so it also builds on Linux with
+/// `g++ -O2 -std=c++14 -I"My Game" Tools/AtlasPacker/*.cpp -o AtlasPacker`.
+
+#define STBI_ONLY_PNG
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "stb_image.h"
+#include "MaxRects.h"
+#include "PngWriter.h"
+
+typedef unsigned char BYTE; ///< Byte.
+
+static const int ATLAS_STEP = 64; ///< Granularity of atlas sizes.
+
+/// \brief XML tag.
+///
+/// One tag from a settings file. Settings files only use attributes, never
+/// text, so a flat list of tags is all the structure that is needed.
+
+struct CTag{
+  std::string m_strName; ///< Tag name, with a leading '/' for a closing tag.
+  std::map<std::string, std::string> m_mapAttr; ///< Attributes.
+  bool m_bEmpty = false; ///< Whether it ends in "/>".
+  size_t m_nBegin = 0; ///< Offset of the '<'.
+  size_t m_nEnd = 0; ///< Offset one past the '>'.
+
+  const std::string Get(const char*) const; ///< Get an attribute.
+}; //CTag
+
+/// \brief Image.
+///
+/// An image file and where it goes in the atlases.
+
+struct CImage{
+  std::string m_strFile; ///< File name relative to the sprite path.
+  int m_nWidth = 0; ///< Width.
+  int m_nHeight = 0; ///< Height.
+  std::vector<BYTE> m_vecPixel; ///< RGBA pixels.
+  int m_nAtlas = -1; ///< Atlas index.
+  CRect m_rPos; ///< Position in the atlas, not counting the border.
+}; //CImage
+
+/// \brief Sprite.
+///
+/// A sprite tag from the settings file.
+
+struct CSprite{
+  std::string m_strName; ///< Sprite name.
+  std::string m_strSheet; ///< Name of its sheet, if it is a sheet sprite.
+  std::vector<int> m_vecImage; ///< Image of each frame, or the sheet image.
+  std::vector<CRect> m_vecFrame; ///< Frame rectangles in a sheet sprite.
+}; //CSprite
+
+/// \brief Options.
+///
+/// Command line options.
+
+struct COptions{
+  std::string m_strIn = "Media\\XML\\gamesettings.xml"; ///< Settings file in.
+  std::string m_strOut = "Media\\XML\\gamesettings-atlas.xml"; ///< Settings file out.
+  std::string m_strName = "atlas"; ///< Atlas name prefix.
+  int m_nSize = 2048; ///< Largest atlas width and height.
+  int m_nBorder = 1; ///< Border width.
+}; //COptions
+
+/// Get an attribute value.
+/// \param name Attribute name.
+/// \return Its value, or the empty string if there isn't one.
+
+const std::string CTag::Get(const char* name) const{
+  const auto it = m_mapAttr.find(name);
+  return it == m_mapAttr.end()? std::string(): it->second;
+} //Get
+
+/// Turn a path from a settings file, which uses backslashes, into one that
+/// `fopen` takes on any platform.
+/// \param s Path.
+/// \return Path with forward slashes.
+
+static std::string FixPath(std::string s){
+  std::replace(s.begin(), s.end(), '\\', '/');
+  return s;
+} //FixPath
+
+/// Read a whole text file.
+/// \param name File name.
+/// \param s [out] Contents.
+/// \return true if it was read.
+
+static const bool ReadFile(const std::string& name, std::string& s){
+  std::ifstream in(FixPath(name), std::ios::binary);
+  if(!in)return false;
+
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  s = ss.str();
+  return true;
+} //ReadFile
+
+/// Scan a settings file into a list of tags, skipping comments, the
+/// declaration, and anything else that starts with "<!" or "<?".
+/// \param s Text of the settings file.
+/// \return Tags in order.
+
+static std::vector<CTag> Scan(const std::string& s){
+  std::vector<CTag> vecTag;
+  size_t i = 0;
+
+  auto skipSpace = [&](){
+    while(i < s.size() && isspace((BYTE)s[i]))i++;
+  }; //skipSpace
+
+  auto readName = [&](){
+    const size_t j = i;
+    while(i < s.size() && !isspace((BYTE)s[i]) && !strchr("=/>", s[i]))i++;
+    return s.substr(j, i - j);
+  }; //readName
+
+  while((i = s.find('<', i)) != std::string::npos){
+    if(s.compare(i, 4, "<!--") == 0){
+      i = s.find("-->", i);
+      if(i == std::string::npos)break;
+      continue;
+    } //if
+
+    if(s[i + 1] == '?' || s[i + 1] == '!'){
+      i = s.find('>', i);
+      if(i == std::string::npos)break;
+      continue;
+    } //if
+
+    CTag tag;
+    tag.m_nBegin = i++;
+
+    if(s[i] == '/')
+      tag.m_strName = "/" + (i++, readName());
+    else tag.m_strName = readName();
+
+    for(;;){
+      skipSpace();
+      if(i >= s.size() || s[i] == '>' || s[i] == '/')break;
+
+      const std::string key = readName();
+      skipSpace();
+      if(i >= s.size() || s[i] != '=')continue;
+      i++; skipSpace();
+
+      const char q = s[i]; //quote character
+      const size_t j = s.find(q, i + 1);
+      if(j == std::string::npos)break;
+
+      tag.m_mapAttr[key] = s.substr(i + 1, j - i - 1);
+      i = j + 1;
+    } //for
+
+    tag.m_bEmpty = i < s.size() && s[i] == '/';
+    i = s.find('>', i);
+    if(i == std::string::npos)break;
+    tag.m_nEnd = ++i;
+
+    vecTag.push_back(tag);
+  } //while
+
+  return vecTag;
+} //Scan
+
+/// Load an image once, however many sprites use it.
+/// \param path Sprite path.
+/// \param file File name relative to the sprite path.
+/// \param vecImage Images loaded so far.
+/// \param mapImage Index of each file name in `vecImage`.
+/// \return Index of the image, or -1 if it couldn't be loaded.
+
+static int LoadImage(const std::string& path, const std::string& file,
+  std::vector<CImage>& vecImage, std::map<std::string, int>& mapImage)
+{
+  const auto it = mapImage.find(file);
+  if(it != mapImage.end())return it->second;
+
+  const std::string name = FixPath(path + "/" + file);
+  int w = 0, h = 0, n = 0;
+  BYTE* p = stbi_load(name.c_str(), &w, &h, &n, 4);
+
+  if(p == nullptr){
+    fprintf(stderr, "Cannot load %s: %s\n", name.c_str(), stbi_failure_reason());
+    return -1;
+  } //if
+
+  CImage img;
+  img.m_strFile = file;
+  img.m_nWidth = w;
+  img.m_nHeight = h;
+  img.m_vecPixel.assign(p, p + (size_t)w*h*4);
+  stbi_image_free(p);
+
+  vecImage.push_back(img);
+  return mapImage[file] = (int)vecImage.size() - 1;
+} //LoadImage
+
+/// Read the sprites and load their images. A tag's `frames` attribute gives
+/// the number of frames for both kinds of multi-frame sprite; the frame
+/// tags of a sheet sprite follow it up to its closing tag.
+/// \param vecTag Tags of the settings file.
+/// \param first Index of the `<sprites>` tag.
+/// \param vecSprite [out] Sprites.
+/// \param vecImage [out] Images.
+/// \return true if every image was loaded.
+
+static const bool ReadSprites(const std::vector<CTag>& vecTag, size_t first,
+  std::vector<CSprite>& vecSprite, std::vector<CImage>& vecImage)
+{
+  const std::string path = vecTag[first].Get("path");
+  std::map<std::string, int> mapImage; //image index of each file
+  std::map<std::string, size_t> mapSprite; //sprite index of each name
+  bool ok = true;
+
+  for(size_t i=first + 1; i<vecTag.size() && vecTag[i].m_strName != "/sprites"; i++){
+    const CTag& tag = vecTag[i]; //shorthand
+    if(tag.m_strName != "sprite")continue;
+
+    CSprite sprite;
+    sprite.m_strName = tag.Get("name");
+    const std::string file = tag.Get("file");
+    const std::string sheet = tag.Get("sheet");
+    const int frames = atoi(tag.Get("frames").c_str());
+
+    if(!sheet.empty()){ //sheet sprite
+      const auto it = mapSprite.find(sheet);
+
+      if(it == mapSprite.end() || vecSprite[it->second].m_vecImage.size() != 1){
+        fprintf(stderr, "Sprite %s: no single-image sheet %s\n",
+          sprite.m_strName.c_str(), sheet.c_str());
+        ok = false;
+        continue;
+      } //if
+
+      sprite.m_strSheet = sheet;
+      sprite.m_vecImage = vecSprite[it->second].m_vecImage;
+      sprite.m_vecFrame.resize(std::max(frames, 0));
+
+      while(i + 1 < vecTag.size() && vecTag[i + 1].m_strName == "frame"){
+        const CTag& f = vecTag[++i]; //shorthand
+        const int n = atoi(f.Get("index").c_str());
+        if(n < 0 || n >= frames)continue;
+
+        CRect& r = sprite.m_vecFrame[n]; //shorthand
+        r.m_nX = atoi(f.Get("left").c_str());
+        r.m_nY = atoi(f.Get("top").c_str());
+        r.m_nWidth = atoi(f.Get("right").c_str()) - r.m_nX;
+        r.m_nHeight = atoi(f.Get("bottom").c_str()) - r.m_nY;
+      } //for
+    } //if
+
+    else if(!tag.Get("ext").empty()){ //one image per frame
+      for(int n=0; n<frames; n++)
+        sprite.m_vecImage.push_back(LoadImage(path,
+          file + std::to_string(n) + "." + tag.Get("ext"), vecImage, mapImage));
+    } //else if
+
+    else sprite.m_vecImage.push_back(LoadImage(path, file, vecImage, mapImage));
+
+    for(int n: sprite.m_vecImage)
+      ok = ok && n >= 0;
+
+    mapSprite[sprite.m_strName] = vecSprite.size();
+    vecSprite.push_back(sprite);
+  } //for
+
+  return ok;
+} //ReadSprites
+
+/// Place a group of images in an atlas, all or none of them.
+/// \param packer The atlas's packer.
+/// \param group Indices of the images.
+/// \param vecImage Images.
+/// \param border Border width.
+/// \param vecPos [out] Position of each image in the group, border included.
+/// \return true if they all fit, in which case `packer` is updated.
+
+static const bool InsertGroup(CMaxRects& packer, const std::vector<int>& group,
+  const std::vector<CImage>& vecImage, int border, std::vector<CRect>& vecPos)
+{
+  CMaxRects trial = packer; //try it on a copy
+  vecPos.clear();
+
+  for(int n: group){
+    CRect r;
+    if(!trial.Insert(vecImage[n].m_nWidth + 2*border, vecImage[n].m_nHeight + 2*border, r))
+      return false;
+    vecPos.push_back(r);
+  } //for
+
+  packer = trial;
+  return true;
+} //InsertGroup
+
+/// Pack groups of images into one atlas of a given size.
+/// \param vecGroup Groups of image indices.
+/// \param vecImage Images.
+/// \param border Border width.
+/// \param w Atlas width.
+/// \param h Atlas height.
+/// \param packer [out] The atlas's packer.
+/// \param vecPos [out] Position of each image in each group.
+/// \param vecLeft [out] Groups that didn't fit.
+
+static void PackAtlas(const std::vector<std::vector<int>>& vecGroup,
+  const std::vector<CImage>& vecImage, int border, int w, int h,
+  CMaxRects& packer, std::vector<std::vector<CRect>>& vecPos,
+  std::vector<std::vector<int>>& vecLeft)
+{
+  packer = CMaxRects(w, h);
+  vecPos.clear();
+  vecLeft.clear();
+
+  for(const auto& group: vecGroup){
+    std::vector<CRect> pos;
+
+    if(InsertGroup(packer, group, vecImage, border, pos))
+      vecPos.push_back(pos);
+    else{
+      vecPos.push_back(std::vector<CRect>());
+      vecLeft.push_back(group);
+    } //else
+  } //for
+} //PackAtlas
+
+/// Pack the images into atlases. The images of a multi-image sprite must all
+/// go in the same atlas, so images are packed in groups, one group per
+/// sprite, biggest first. The packer places rectangles all over the bin that
+/// it is given, so rather than trimming a big atlas afterwards, look for the
+/// smallest atlas that takes every group still to be packed, trying sizes in
+/// steps of `ATLAS_STEP` in order of area. If even the largest atlas is too
+/// small, fill one of those with whatever fits and go around again with the
+/// rest.
+/// \param vecSprite Sprites.
+/// \param vecImage Images, whose atlas and position are filled in.
+/// \param opt Options.
+/// \param vecAtlas [out] A packer for each atlas.
+/// \return true if every image fit.
+
+static const bool Pack(const std::vector<CSprite>& vecSprite,
+  std::vector<CImage>& vecImage, const COptions& opt,
+  std::vector<CMaxRects>& vecAtlas)
+{
+  std::vector<std::vector<int>> vecGroup; //image indices in each group
+  std::vector<bool> vecGrouped(vecImage.size(), false); //whether in a group yet
+
+  for(const CSprite& sprite: vecSprite){
+    std::vector<int> group;
+
+    for(int n: sprite.m_vecImage)
+      if(!vecGrouped[n]){
+        vecGrouped[n] = true;
+        group.push_back(n);
+      } //if
+
+    if(!group.empty())
+      vecGroup.push_back(group);
+  } //for
+
+  auto size = [&](int n){
+    return std::max(vecImage[n].m_nWidth, vecImage[n].m_nHeight);};
+
+  for(auto& group: vecGroup)
+    std::stable_sort(group.begin(), group.end(),
+      [&](int a, int b){return size(a) > size(b);});
+
+  std::stable_sort(vecGroup.begin(), vecGroup.end(),
+    [&](const std::vector<int>& a, const std::vector<int>& b){
+      return size(a[0]) > size(b[0]);});
+
+  std::vector<std::pair<int, int>> vecSize; //atlas sizes to try, smallest first
+
+  for(int w=ATLAS_STEP; w<=opt.m_nSize; w+=ATLAS_STEP)
+    for(int h=ATLAS_STEP; h<=opt.m_nSize; h+=ATLAS_STEP)
+      vecSize.push_back(std::make_pair(w, h));
+
+  std::stable_sort(vecSize.begin(), vecSize.end(),
+    [](const std::pair<int, int>& a, const std::pair<int, int>& b){
+      const long long x = (long long)a.first*a.second, y = (long long)b.first*b.second;
+      return x < y || (x == y && abs(a.first - a.second) < abs(b.first - b.second));});
+
+  while(!vecGroup.empty()){
+    long long area = 0; //area still to be packed, borders included
+
+    for(const auto& group: vecGroup)
+      for(int n: group)
+        area += (long long)(vecImage[n].m_nWidth + 2*opt.m_nBorder)*
+          (vecImage[n].m_nHeight + 2*opt.m_nBorder);
+
+    CMaxRects packer(0, 0);
+    std::vector<std::vector<CRect>> vecPos;
+    std::vector<std::vector<int>> vecLeft;
+    bool done = false; //whether everything fit
+
+    for(const auto& wh: vecSize)
+      if((long long)wh.first*wh.second >= area){
+        PackAtlas(vecGroup, vecImage, opt.m_nBorder, wh.first, wh.second,
+          packer, vecPos, vecLeft);
+        if((done = vecLeft.empty()))break;
+      } //if
+
+    if(!done){
+      PackAtlas(vecGroup, vecImage, opt.m_nBorder, opt.m_nSize, opt.m_nSize,
+        packer, vecPos, vecLeft);
+
+      if(packer.IsEmpty()){
+        fprintf(stderr, "%s is too big for a %dx%d atlas\n",
+          vecImage[vecGroup[0][0]].m_strFile.c_str(), opt.m_nSize, opt.m_nSize);
+        return false;
+      } //if
+    } //if
+
+    const int k = (int)vecAtlas.size();
+    vecAtlas.push_back(packer);
+
+    for(size_t i=0; i<vecGroup.size(); i++)
+      for(size_t j=0; j<vecPos[i].size(); j++){
+        CImage& img = vecImage[vecGroup[i][j]]; //shorthand
+        img.m_nAtlas = k;
+        img.m_rPos.m_nX = vecPos[i][j].m_nX + opt.m_nBorder;
+        img.m_rPos.m_nY = vecPos[i][j].m_nY + opt.m_nBorder;
+        img.m_rPos.m_nWidth = img.m_nWidth;
+        img.m_rPos.m_nHeight = img.m_nHeight;
+      } //for
+
+    vecGroup.swap(vecLeft);
+  } //while
+
+  return true;
+} //Pack
+
+/// Copy the images into an atlas, each with its edge pixels repeated out
+/// over its border, and write the atlas out. The atlas is trimmed to the
+/// packed area, rounded up to a multiple of 4.
+/// \param k Atlas index.
+/// \param packer Its packer.
+/// \param vecImage Images.
+/// \param opt Options.
+/// \param file File name to write.
+/// \param w [out] Atlas width.
+/// \param h [out] Atlas height.
+/// \return true if it was written.
+
+static const bool WriteAtlas(int k, const CMaxRects& packer,
+  const std::vector<CImage>& vecImage, const COptions& opt,
+  const std::string& file, int& w, int& h)
+{
+  const CRect bounds = packer.GetBounds();
+  w = (bounds.m_nWidth + 3) & ~3;
+  h = (bounds.m_nHeight + 3) & ~3;
+
+  std::vector<BYTE> vecPixel((size_t)w*h*4, 0);
+  const int b = opt.m_nBorder; //shorthand
+
+  for(const CImage& img: vecImage){
+    if(img.m_nAtlas != k)continue;
+
+    for(int y=-b; y<img.m_nHeight + b; y++){
+      const int sy = std::min(std::max(y, 0), img.m_nHeight - 1);
+
+      for(int x=-b; x<img.m_nWidth + b; x++){
+        const int sx = std::min(std::max(x, 0), img.m_nWidth - 1);
+        const BYTE* src = &img.m_vecPixel[((size_t)sy*img.m_nWidth + sx)*4];
+        BYTE* dest = &vecPixel[((size_t)(img.m_rPos.m_nY + y)*w + img.m_rPos.m_nX + x)*4];
+        memcpy(dest, src, 4);
+      } //for
+    } //for
+  } //for
+
+  return WritePNG(FixPath(file).c_str(), w, h, vecPixel.data());
+} //WriteAtlas
+
+/// Append a frame tag to the new sprites element.
+/// \param out Output stream.
+/// \param n Frame index.
+/// \param r Frame rectangle in the atlas.
+
+static void WriteFrame(std::ostream& out, size_t n, const CRect& r){
+  out << "      <frame index=\"" << n << "\" left=\"" << r.m_nX <<
+    "\" top=\"" << r.m_nY << "\" right=\"" << r.GetRight() <<
+    "\" bottom=\"" << r.GetBottom() << "\"/>\n";
+} //WriteFrame
+
+/// Write the new `<sprites>` element: one sprite per atlas, then every
+/// original sprite, in its original order, as a sheet sprite on an atlas.
+/// \param out Output stream.
+/// \param vecSprite Sprites.
+/// \param vecImage Images.
+/// \param nAtlases Number of atlases.
+/// \param opt Options.
+
+static void WriteSprites(std::ostream& out, const std::vector<CSprite>& vecSprite,
+  const std::vector<CImage>& vecImage, size_t nAtlases, const COptions& opt)
+{
+  out << "\n    <!-- atlases, made by AtlasPacker from " << opt.m_strIn << " -->\n";
+
+  for(size_t k=0; k<nAtlases; k++)
+    out << "    <sprite name=\"" << opt.m_strName << k << "\" file=\"" <<
+      opt.m_strName << k << ".png\"/>\n";
+
+  out << "\n";
+
+  for(const CSprite& sprite: vecSprite){
+    const CImage& first = vecImage[sprite.m_vecImage[0]]; //decides the atlas
+    const bool sheet = !sprite.m_strSheet.empty();
+    const size_t frames = sheet? sprite.m_vecFrame.size(): sprite.m_vecImage.size();
+
+    out << "    <sprite name=\"" << sprite.m_strName << "\" sheet=\"" <<
+      opt.m_strName << first.m_nAtlas << "\" frames=\"" << frames << "\">\n";
+
+    for(size_t n=0; n<frames; n++){
+      CRect r;
+
+      if(sheet){ //frame of the sheet, moved with it
+        r = sprite.m_vecFrame[n];
+        r.m_nX += first.m_rPos.m_nX;
+        r.m_nY += first.m_rPos.m_nY;
+      } //if
+
+      else r = vecImage[sprite.m_vecImage[n]].m_rPos;
+
+      WriteFrame(out, n, r);
+    } //for
+
+    out << "    </sprite>\n";
+  } //for
+
+  out << "\n  ";
+} //WriteSprites
+
+/// Read the command line.
+/// \param argc Argument count.
+/// \param argv Arguments.
+/// \param opt [out] Options.
+/// \return true if the command line made sense.
+
+static const bool ReadOptions(int argc, char* argv[], COptions& opt){
+  int positional = 0; //number of file names so far
+
+  for(int i=1; i<argc; i++){
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+
+    if(arg == "--size" && hasValue)opt.m_nSize = atoi(argv[++i]);
+    else if(arg == "--border" && hasValue)opt.m_nBorder = atoi(argv[++i]);
+    else if(arg == "--name" && hasValue)opt.m_strName = argv[++i];
+    else if(arg.compare(0, 2, "--") != 0 && positional == 0){opt.m_strIn = arg; positional++;}
+    else if(arg.compare(0, 2, "--") != 0 && positional == 1){opt.m_strOut = arg; positional++;}
+    else return false;
+  } //for
+
+  return opt.m_nSize > 0 && opt.m_nBorder >= 0 && !opt.m_strName.empty();
+} //ReadOptions
+
+/// Pack the atlases, write them and the new settings file, and report how
+/// full the atlases are, which is the area of the images over the area of
+/// the atlases. Borders count as waste.
+/// \param argc Argument count.
+/// \param argv Arguments.
+/// \return 0 on success, 1 on failure.
+
+int main(int argc, char* argv[]){
+  COptions opt;
+
+  if(!ReadOptions(argc, argv, opt)){
+    fprintf(stderr, "Usage: AtlasPacker [in.xml [out.xml]] [--size n] [--border n] [--name s]\n");
+    return 1;
+  } //if
+
+  std::string text; //settings file
+
+  if(!ReadFile(opt.m_strIn, text)){
+    fprintf(stderr, "Cannot read %s\n", opt.m_strIn.c_str());
+    return 1;
+  } //if
+
+  const std::vector<CTag> vecTag = Scan(text);
+  size_t first = 0, last = 0; //indices of <sprites> and </sprites>
+
+  while(first < vecTag.size() && vecTag[first].m_strName != "sprites")first++;
+  for(last=first; last < vecTag.size() && vecTag[last].m_strName != "/sprites"; last++);
+
+  if(last >= vecTag.size()){
+    fprintf(stderr, "No <sprites> element in %s\n", opt.m_strIn.c_str());
+    return 1;
+  } //if
+
+  std::vector<CSprite> vecSprite;
+  std::vector<CImage> vecImage;
+  std::vector<CMaxRects> vecAtlas;
+
+  if(!ReadSprites(vecTag, first, vecSprite, vecImage) ||
+    !Pack(vecSprite, vecImage, opt, vecAtlas))
+    return 1;
+
+  const std::string path = vecTag[first].Get("path");
+  long long imageArea = 0, atlasArea = 0; //for fill ratio
+
+  for(const CImage& img: vecImage)
+    imageArea += (long long)img.m_nWidth*img.m_nHeight;
+
+  for(size_t k=0; k<vecAtlas.size(); k++){
+    const std::string file = path + "/" + opt.m_strName + std::to_string(k) + ".png";
+    int w = 0, h = 0;
+
+    if(!WriteAtlas((int)k, vecAtlas[k], vecImage, opt, file, w, h)){
+      fprintf(stderr, "Cannot write %s\n", file.c_str());
+      return 1;
+    } //if
+
+    long long area = 0; //image area in this atlas
+    size_t count = 0; //images in this atlas
+
+    for(const CImage& img: vecImage)
+      if(img.m_nAtlas == (int)k){
+        area += (long long)img.m_nWidth*img.m_nHeight;
+        count++;
+      } //if
+
+    atlasArea += (long long)w*h;
+    printf("%s: %dx%d, %zu images, fill %.1f%%\n", file.c_str(), w, h, count,
+      100.0*area/((long long)w*h));
+  } //for
+
+  std::ostringstream out;
+  out << text.substr(0, vecTag[first].m_nEnd);
+  WriteSprites(out, vecSprite, vecImage, vecAtlas.size(), opt);
+  out << text.substr(vecTag[last].m_nBegin);
+
+  std::ofstream file(FixPath(opt.m_strOut), std::ios::binary);
+  file << out.str();
+
+  if(!file){
+    fprintf(stderr, "Cannot write %s\n", opt.m_strOut.c_str());
+    return 1;
+  } //if
+
+  printf("%zu sprites, %zu textures packed into %zu atlases, fill %.1f%%\n",
+    vecSprite.size(), vecImage.size(), vecAtlas.size(), 100.0*imageArea/atlasArea);
+  printf("Wrote %s\n", opt.m_strOut.c_str());
+
+  return 0;
+} //main
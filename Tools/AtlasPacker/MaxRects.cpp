@@ -0,0 +1,191 @@
+/// \file MaxRects.cpp
+/// \brief Code for the rectangle packer CMaxRects.
+
+#include <algorithm>
+#include <climits>
+
+#include "MaxRects.h"
+
+/// Reader function for the x coordinate one past the right edge.
+/// \return One past the right edge.
+
+const int CRect::GetRight() const{
+  return m_nX + m_nWidth;
+} //GetRight
+
+/// Reader function for the y coordinate one past the bottom edge.
+/// \return One past the bottom edge.
+
+const int CRect::GetBottom() const{
+  return m_nY + m_nHeight;
+} //GetBottom
+
+/// Test whether another rectangle lies entirely inside this one.
+/// \param r A rectangle.
+/// \return true if `r` is inside this rectangle.
+
+const bool CRect::Contains(const CRect& r) const{
+  return r.m_nX >= m_nX && r.m_nY >= m_nY &&
+    r.GetRight() <= GetRight() && r.GetBottom() <= GetBottom();
+} //Contains
+
+/// Test whether another rectangle shares any pixels with this one.
+/// \param r A rectangle.
+/// \return true if they overlap.
+
+const bool CRect::Overlaps(const CRect& r) const{
+  return r.m_nX < GetRight() && m_nX < r.GetRight() &&
+    r.m_nY < GetBottom() && m_nY < r.GetBottom();
+} //Overlaps
+
+/// Start with an empty bin, which is a single free rectangle.
+/// \param w Bin width.
+/// \param h Bin height.
+
+CMaxRects::CMaxRects(int w, int h):
+  m_nWidth(w), m_nHeight(h)
+{
+  CRect r;
+  r.m_nWidth = w;
+  r.m_nHeight = h;
+  m_vecFree.push_back(r);
+} //constructor
+
+/// Place a rectangle in the free rectangle that leaves the least space along
+/// its shorter leftover side, breaking ties on the longer leftover side.
+/// \param w Width.
+/// \param h Height.
+/// \param r [out] Where it was placed.
+/// \return true if it fit.
+
+const bool CMaxRects::Insert(int w, int h, CRect& r){
+  int bestShort = INT_MAX; //best short side leftover so far
+  int bestLong = INT_MAX; //best long side leftover so far
+  const CRect* pBest = nullptr; //best free rectangle so far
+
+  for(const CRect& f: m_vecFree)
+    if(w <= f.m_nWidth && h <= f.m_nHeight){
+      const int dx = f.m_nWidth - w;
+      const int dy = f.m_nHeight - h;
+      const int s = std::min(dx, dy);
+      const int l = std::max(dx, dy);
+
+      if(s < bestShort || (s == bestShort && l < bestLong)){
+        bestShort = s;
+        bestLong = l;
+        pBest = &f;
+      } //if
+    } //if
+
+  if(pBest == nullptr)return false;
+
+  r.m_nX = pBest->m_nX;
+  r.m_nY = pBest->m_nY;
+  r.m_nWidth = w;
+  r.m_nHeight = h;
+
+  Split(r);
+  Prune();
+  m_vecUsed.push_back(r);
+
+  return true;
+} //Insert
+
+/// Replace each free rectangle that overlaps a newly placed rectangle by the
+/// parts of it that stick out to the left, right, top, and bottom. These
+/// overlap each other at the corners, which is what keeps them maximal.
+/// \param r The placed rectangle.
+
+void CMaxRects::Split(const CRect& r){
+  std::vector<CRect> vecNew; //free rectangles after splitting
+
+  for(const CRect& f: m_vecFree){
+    if(!f.Overlaps(r)){
+      vecNew.push_back(f);
+      continue;
+    } //if
+
+    if(r.m_nX > f.m_nX){ //left part
+      CRect t = f;
+      t.m_nWidth = r.m_nX - f.m_nX;
+      vecNew.push_back(t);
+    } //if
+
+    if(r.GetRight() < f.GetRight()){ //right part
+      CRect t = f;
+      t.m_nX = r.GetRight();
+      t.m_nWidth = f.GetRight() - r.GetRight();
+      vecNew.push_back(t);
+    } //if
+
+    if(r.m_nY > f.m_nY){ //top part
+      CRect t = f;
+      t.m_nHeight = r.m_nY - f.m_nY;
+      vecNew.push_back(t);
+    } //if
+
+    if(r.GetBottom() < f.GetBottom()){ //bottom part
+      CRect t = f;
+      t.m_nY = r.GetBottom();
+      t.m_nHeight = f.GetBottom() - r.GetBottom();
+      vecNew.push_back(t);
+    } //if
+  } //for
+
+  m_vecFree.swap(vecNew);
+} //Split
+
+/// Throw away every free rectangle that lies inside another, keeping one of
+/// any duplicates.
+
+void CMaxRects::Prune(){
+  const size_t n = m_vecFree.size();
+  std::vector<bool> vecDead(n, false); //whether each is to go
+
+  for(size_t i=0; i<n; i++)
+    for(size_t j=0; j<n && !vecDead[i]; j++)
+      if(i != j && !vecDead[j] && m_vecFree[j].Contains(m_vecFree[i]))
+        vecDead[i] = true;
+
+  size_t k = 0; //number kept so far
+
+  for(size_t i=0; i<n; i++)
+    if(!vecDead[i])
+      m_vecFree[k++] = m_vecFree[i];
+
+  m_vecFree.resize(k);
+} //Prune
+
+/// Get the smallest rectangle at the top left of the bin that contains every
+/// rectangle placed so far.
+/// \return Bounding rectangle.
+
+const CRect CMaxRects::GetBounds() const{
+  CRect b;
+
+  for(const CRect& r: m_vecUsed){
+    b.m_nWidth = std::max(b.m_nWidth, r.GetRight());
+    b.m_nHeight = std::max(b.m_nHeight, r.GetBottom());
+  } //for
+
+  return b;
+} //GetBounds
+
+/// Reader function for the total area of the rectangles placed so far.
+/// \return Area in pixels.
+
+const long long CMaxRects::GetUsedArea() const{
+  long long n = 0;
+
+  for(const CRect& r: m_vecUsed)
+    n += (long long)r.m_nWidth*r.m_nHeight;
+
+  return n;
+} //GetUsedArea
+
+/// Reader function for whether nothing has been placed yet.
+/// \return true if the bin is empty.
+
+const bool CMaxRects::IsEmpty() const{
+  return m_vecUsed.empty();
+} //IsEmpty
@@ -0,0 +1,59 @@
+/// \file MaxRects.h
+/// \brief Interface for the rectangle packer CMaxRects.
+
+#ifndef __L4RC_ATLAS_MAXRECTS_H__
+#define __L4RC_ATLAS_MAXRECTS_H__
+
+#include <vector>
+
+/// \brief Rectangle.
+///
+/// An axis-aligned rectangle in pixels, with the origin at the top left as
+/// in an image.
+
+struct CRect{
+  int m_nX = 0; ///< Left edge.
+  int m_nY = 0; ///< Top edge.
+  int m_nWidth = 0; ///< Width.
+  int m_nHeight = 0; ///< Height.
+
+  const int GetRight() const; ///< One past the right edge.
+  const int GetBottom() const; ///< One past the bottom edge.
+  const bool Contains(const CRect&) const; ///< Whether it contains another.
+  const bool Overlaps(const CRect&) const; ///< Whether it overlaps another.
+}; //CRect
+
+/// \brief The MaxRects packer.
+///
+/// The MaxRects packer places rectangles into a bin of fixed size without
+/// rotating them. It keeps a list of the maximal free rectangles, that is,
+/// every largest rectangle of free space, which may overlap each other. A new
+/// rectangle goes at the top left of the free rectangle that it fits most
+/// snugly along its shorter leftover side (best short side fit), then every
+/// free rectangle that it overlaps is split into the up to four maximal
+/// rectangles around it, and free rectangles contained in others are thrown
+/// away. A packer can be copied to try out a group of insertions and the
+/// copy kept only if they all fit.
+
+class CMaxRects{
+  private:
+    int m_nWidth = 0; ///< Bin width.
+    int m_nHeight = 0; ///< Bin height.
+
+    std::vector<CRect> m_vecFree; ///< Maximal free rectangles.
+    std::vector<CRect> m_vecUsed; ///< Rectangles placed so far.
+
+    void Split(const CRect&); ///< Split free rectangles around a placed one.
+    void Prune(); ///< Remove contained free rectangles.
+
+  public:
+    CMaxRects(int, int); ///< Constructor.
+
+    const bool Insert(int, int, CRect&); ///< Place a rectangle.
+
+    const CRect GetBounds() const; ///< Bounding box of placed rectangles.
+    const long long GetUsedArea() const; ///< Total area placed.
+    const bool IsEmpty() const; ///< Whether nothing is placed.
+}; //CMaxRects
+
+#endif //__L4RC_ATLAS_MAXRECTS_H__
@@ -0,0 +1,349 @@
+/// \file PngWriter.cpp
+/// \brief Code for the PNG writer.
+///
+/// `stb_image` only reads images, so this is just enough of a PNG encoder
+/// to write out an atlas: 8-bit RGBA, one filter per row chosen by the usual
+/// minimum sum of absolute differences rule, and a deflate stream made with
+/// a hashed LZ77 match finder and the fixed Huffman codes. The fixed codes
+/// cost a little over building tables per block, but sprite art is mostly
+/// long runs of transparent pixels, which LZ77 takes care of.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "PngWriter.h"
+
+typedef unsigned char BYTE; ///< Byte.
+typedef unsigned int UINT; ///< Unsigned integer.
+
+/// \brief Bit writer.
+///
+/// Appends bits to a byte vector least significant bit first, which is the
+/// order that deflate packs them in.
+
+struct CBitWriter{
+  std::vector<BYTE>& m_vecOut; ///< Output bytes.
+  UINT m_nBits = 0; ///< Bits waiting to be written.
+  UINT m_nCount = 0; ///< Number of bits waiting.
+
+  CBitWriter(std::vector<BYTE>& v): m_vecOut(v){}
+
+  /// Append bits.
+  /// \param bits Bits, first bit in the least significant place.
+  /// \param n Number of bits, at most 24.
+
+  void Put(UINT bits, UINT n){
+    m_nBits |= bits << m_nCount;
+    m_nCount += n;
+
+    while(m_nCount >= 8){
+      m_vecOut.push_back((BYTE)m_nBits);
+      m_nBits >>= 8;
+      m_nCount -= 8;
+    } //while
+  } //Put
+
+  /// Append a Huffman code, which deflate stores most significant bit first.
+  /// \param code Code.
+  /// \param n Code length.
+
+  void PutCode(UINT code, UINT n){
+    UINT r = 0; //code reversed
+
+    for(UINT i=0; i<n; i++)
+      r |= (code >> i & 1) << (n - 1 - i);
+
+    Put(r, n);
+  } //PutCode
+
+  /// Write out the last partial byte.
+
+  void Flush(){
+    if(m_nCount > 0)
+      m_vecOut.push_back((BYTE)m_nBits);
+
+    m_nBits = m_nCount = 0;
+  } //Flush
+}; //CBitWriter
+
+static const UINT LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17,
+  19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const UINT LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2,
+  2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const UINT DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65,
+  97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+  12289, 16385, 24577};
+static const UINT DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5,
+  6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static const UINT WINDOW_SIZE = 32768; ///< Deflate window size.
+static const UINT HASH_BITS = 15; ///< Bits in match finder hash.
+static const UINT MAX_CHAIN = 32; ///< Most earlier positions tried per match.
+static const UINT MIN_MATCH = 3; ///< Shortest match.
+static const UINT MAX_MATCH = 258; ///< Longest match.
+
+/// Write a literal or length symbol in the fixed Huffman code.
+/// \param w Bit writer.
+/// \param sym Symbol, 0 to 287.
+
+static void PutLiteral(CBitWriter& w, UINT sym){
+  if(sym < 144)w.PutCode(0x30 + sym, 8);
+  else if(sym < 256)w.PutCode(0x190 + sym - 144, 9);
+  else if(sym < 280)w.PutCode(sym - 256, 7);
+  else w.PutCode(0xC0 + sym - 280, 8);
+} //PutLiteral
+
+/// Write a match as a length and distance in the fixed Huffman code.
+/// \param w Bit writer.
+/// \param len Match length.
+/// \param dist Match distance.
+
+static void PutMatch(CBitWriter& w, UINT len, UINT dist){
+  UINT i = 28;
+  while(LENGTH_BASE[i] > len)i--;
+  PutLiteral(w, 257 + i);
+  w.Put(len - LENGTH_BASE[i], LENGTH_EXTRA[i]);
+
+  UINT j = 29;
+  while(DIST_BASE[j] > dist)j--;
+  w.PutCode(j, 5);
+  w.Put(dist - DIST_BASE[j], DIST_EXTRA[j]);
+} //PutMatch
+
+/// Hash the three bytes at a position for the match finder.
+/// \param p Pointer to the bytes.
+/// \return Hash value.
+
+static UINT Hash3(const BYTE* p){
+  return ((p[0] << 16 | p[1] << 8 | p[2])*2654435761U) >> (32 - HASH_BITS);
+} //Hash3
+
+/// Compress data into a zlib stream, which is a deflate stream with a two
+/// byte header and an Adler-32 checksum, as a single block of fixed Huffman
+/// codes. The match finder keeps the most recent position for each hash and
+/// a chain back from each position to the previous one with the same hash,
+/// and takes the longest match found within a few steps along the chain.
+/// \param data Data.
+/// \return zlib stream.
+
+static std::vector<BYTE> Compress(const std::vector<BYTE>& data){
+  std::vector<BYTE> out = {0x78, 0x01}; //zlib header
+  CBitWriter w(out);
+  w.Put(1, 1); //final block
+  w.Put(1, 2); //fixed Huffman codes
+
+  const UINT n = (UINT)data.size();
+  const BYTE* p = data.data(); //shorthand
+  std::vector<int> head(1 << HASH_BITS, -1); //latest position of each hash
+  std::vector<int> prev(n, -1); //previous position with same hash
+
+  auto insert = [&](UINT i){
+    if(i + MIN_MATCH > n)return;
+    const UINT h = Hash3(p + i);
+    prev[i] = head[h];
+    head[h] = (int)i;
+  }; //insert
+
+  UINT i = 0;
+
+  while(i < n){
+    UINT bestLen = 0; //longest match so far
+    UINT bestDist = 0; //its distance
+
+    if(i + MIN_MATCH <= n){
+      const UINT limit = std::min(MAX_MATCH, n - i);
+      int j = head[Hash3(p + i)];
+
+      for(UINT k=0; k<MAX_CHAIN && j >= 0 && i - j <= WINDOW_SIZE; k++, j=prev[j]){
+        UINT len = 0;
+        while(len < limit && p[j + len] == p[i + len])len++;
+
+        if(len > bestLen){
+          bestLen = len;
+          bestDist = i - j;
+          if(len == limit)break;
+        } //if
+      } //for
+    } //if
+
+    if(bestLen >= MIN_MATCH){
+      PutMatch(w, bestLen, bestDist);
+      for(UINT k=0; k<bestLen; k++)insert(i + k);
+      i += bestLen;
+    } //if
+
+    else{
+      PutLiteral(w, p[i]);
+      insert(i++);
+    } //else
+  } //while
+
+  PutLiteral(w, 256); //end of block
+  w.Flush();
+
+  UINT a = 1, b = 0; //Adler-32 sums
+
+  for(BYTE c: data){
+    a = (a + c)%65521;
+    b = (b + a)%65521;
+  } //for
+
+  const UINT adler = b << 16 | a;
+
+  for(int k=3; k>=0; k--)
+    out.push_back((BYTE)(adler >> 8*k));
+
+  return out;
+} //Compress
+
+/// Compute the CRC-32 of some bytes, as used by PNG chunks.
+/// \param p Pointer to the bytes.
+/// \param n Number of bytes.
+/// \param crc CRC so far, for continuing a previous call.
+/// \return CRC.
+
+static UINT Crc32(const BYTE* p, size_t n, UINT crc=0){
+  static UINT table[256] = {0};
+
+  if(table[1] == 0)
+    for(UINT i=0; i<256; i++){
+      UINT c = i;
+      for(int k=0; k<8; k++)c = c & 1? 0xEDB88320U ^ c >> 1: c >> 1;
+      table[i] = c;
+    } //for
+
+  crc = ~crc;
+
+  for(size_t i=0; i<n; i++)
+    crc = table[(crc ^ p[i]) & 0xFF] ^ crc >> 8;
+
+  return ~crc;
+} //Crc32
+
+/// Write a PNG chunk, which is its length, type, data, and a CRC of the type
+/// and data.
+/// \param fp File pointer.
+/// \param type Four-letter chunk type.
+/// \param data Chunk data.
+
+static void WriteChunk(FILE* fp, const char* type, const std::vector<BYTE>& data){
+  BYTE header[8];
+  const UINT n = (UINT)data.size();
+
+  for(int k=0; k<4; k++){
+    header[k] = (BYTE)(n >> 8*(3 - k));
+    header[4 + k] = (BYTE)type[k];
+  } //for
+
+  const UINT crc = Crc32(data.data(), data.size(), Crc32(header + 4, 4));
+  const BYTE footer[4] = {(BYTE)(crc >> 24), (BYTE)(crc >> 16), (BYTE)(crc >> 8), (BYTE)crc};
+
+  fwrite(header, 1, 8, fp);
+  fwrite(data.data(), 1, data.size(), fp);
+  fwrite(footer, 1, 4, fp);
+} //WriteChunk
+
+/// Paeth predictor from the PNG specification.
+/// \param a Byte to the left.
+/// \param b Byte above.
+/// \param c Byte above and to the left.
+/// \return Whichever of them is closest to a + b - c.
+
+static BYTE Paeth(int a, int b, int c){
+  const int p = a + b - c;
+  const int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  return (BYTE)(pa <= pb && pa <= pc? a: pb <= pc? b: c);
+} //Paeth
+
+/// Filter the rows of an image. Each row gets whichever of the five PNG
+/// filters gives the smallest sum of absolute values, taking the filtered
+/// bytes as signed, which tends to compress best.
+/// \param w Width.
+/// \param h Height.
+/// \param rgba Pixels, 4 bytes each, row by row from the top.
+/// \return Filtered rows, each starting with its filter type.
+
+static std::vector<BYTE> Filter(int w, int h, const BYTE* rgba){
+  const size_t stride = (size_t)w*4;
+  std::vector<BYTE> out;
+  out.reserve((stride + 1)*h);
+
+  std::vector<BYTE> zero(stride, 0); //row above the first
+  std::vector<BYTE> trial[5]; //row filtered each way
+
+  for(auto& v: trial)
+    v.resize(stride);
+
+  for(int y=0; y<h; y++){
+    const BYTE* row = rgba + y*stride;
+    const BYTE* up = y > 0? row - stride: zero.data();
+
+    for(size_t i=0; i<stride; i++){
+      const BYTE a = i >= 4? row[i - 4]: 0;
+      const BYTE c = i >= 4? up[i - 4]: 0;
+
+      trial[0][i] = row[i];
+      trial[1][i] = (BYTE)(row[i] - a);
+      trial[2][i] = (BYTE)(row[i] - up[i]);
+      trial[3][i] = (BYTE)(row[i] - ((a + up[i]) >> 1));
+      trial[4][i] = (BYTE)(row[i] - Paeth(a, up[i], c));
+    } //for
+
+    int best = 0; //best filter so far
+    size_t bestSum = SIZE_MAX; //its sum
+
+    for(int f=0; f<5; f++){
+      size_t sum = 0;
+
+      for(BYTE b: trial[f])
+        sum += b < 128? b: 256 - b;
+
+      if(sum < bestSum){
+        bestSum = sum;
+        best = f;
+      } //if
+    } //for
+
+    out.push_back((BYTE)best);
+    out.insert(out.end(), trial[best].begin(), trial[best].end());
+  } //for
+
+  return out;
+} //Filter
+
+/// Write an image to a PNG file as 8-bit RGBA.
+/// \param name File name.
+/// \param w Width.
+/// \param h Height.
+/// \param rgba Pixels, 4 bytes each, row by row from the top.
+/// \return true if the file was written.
+
+const bool WritePNG(const char* name, int w, int h, const unsigned char* rgba){
+  FILE* fp = fopen(name, "wb");
+  if(fp == nullptr)return false;
+
+  static const BYTE signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  fwrite(signature, 1, 8, fp);
+
+  std::vector<BYTE> ihdr(13, 0); //header chunk data
+
+  for(int k=0; k<4; k++){
+    ihdr[k] = (BYTE)(w >> 8*(3 - k));
+    ihdr[4 + k] = (BYTE)(h >> 8*(3 - k));
+  } //for
+
+  ihdr[8] = 8; //bit depth
+  ihdr[9] = 6; //RGBA
+
+  WriteChunk(fp, "IHDR", ihdr);
+  WriteChunk(fp, "IDAT", Compress(Filter(w, h, rgba)));
+  WriteChunk(fp, "IEND", std::vector<BYTE>());
+
+  const bool ok = ferror(fp) == 0;
+  fclose(fp);
+  return ok;
+} //WritePNG
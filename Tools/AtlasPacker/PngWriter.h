@@ -0,0 +1,9 @@
+/// \file PngWriter.h
+/// \brief Interface for the PNG writer.
+
+#ifndef __L4RC_ATLAS_PNGWRITER_H__
+#define __L4RC_ATLAS_PNGWRITER_H__
+
+const bool WritePNG(const char*, int, int, const unsigned char*); ///< Write RGBA image to PNG file.
+
+#endif //__L4RC_ATLAS_PNGWRITER_H__
@@ -0,0 +1,233 @@
+/// \file DecodeBenchmark.cpp
+/// \brief Benchmark for serial and parallel image decoding.
+///
+/// Decodes every PNG file in a folder, `Media/Images` by default, first one
+/// after the other on the main thread and then in parallel with the game's
+/// `CImageDecoder`, several times each, and reports the wall-clock times and
+/// the speedup. A warm-up round comes first so that every run reads the
+/// files from the operating system's file cache rather than the disk. The
+/// two ways must produce the same pixels, which is checked with a checksum.
+/// With a single hardware thread the parallel run can only lose, by the cost
+/// of handing the work over and of the worker's own heap. Given an image
+/// cache folder, it also loads the files in parallel through the cache,
+/// once to fill it and then for the timed rounds, which measures what a
+/// second load of the same images pays.
+///
+/// Run it from the folder that the game runs from. Options are `--rounds n`
+/// for the number of timed rounds (default 5), `--threads n` for the
+/// number of worker threads (default the number of hardware threads), and
+/// `--cache folder` for the image cache (default none). It builds on Linux
+/// with
+/// `g++ -O2 -std=c++14 -pthread -I"My Game" Tools/DecodeBenchmark/DecodeBenchmark.cpp "My Game/ImageDecoder.cpp" "My Game/ImageCache.cpp" "My Game/MappedFile.cpp" "My Game/ThreadPool.cpp" -o DecodeBenchmark`.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <dirent.h>
+#endif
+
+#include "ImageCache.h"
+#include "ImageDecoder.h"
+
+/// List the PNG files in a folder, sorted by name.
+/// \param dir Folder name.
+/// \return File names with the folder in front.
+
+static std::vector<std::string> ListPNGs(const std::string& dir){
+  std::vector<std::string> v;
+
+  auto isPNG = [](const std::string& s){
+    return s.size() > 4 && s.compare(s.size() - 4, 4, ".png") == 0;};
+
+#ifdef _WIN32
+  _finddata_t data;
+  const intptr_t h = _findfirst((dir + "\\*.png").c_str(), &data);
+
+  if(h != -1){
+    do v.push_back(dir + "\\" + data.name);
+    while(_findnext(h, &data) == 0);
+    _findclose(h);
+  } //if
+#else
+  DIR* pDir = opendir(dir.c_str());
+
+  if(pDir != nullptr){
+    while(const dirent* p = readdir(pDir))
+      if(isPNG(p->d_name))
+        v.push_back(dir + "/" + p->d_name);
+
+    closedir(pDir);
+  } //if
+#endif
+
+  std::sort(v.begin(), v.end());
+  return v;
+} //ListPNGs
+
+/// Make a checksum of the pixels of a batch of images, so that two ways of
+/// decoding them can be compared.
+/// \param v Images.
+/// \return Checksum.
+
+static unsigned long long Checksum(const std::vector<CDecodedImage>& v){
+  unsigned long long h = 14695981039346656037ULL; //FNV-1a
+
+  for(const CDecodedImage& img: v)
+    for(size_t i=0; i<img.GetSize(); i++)
+      h = (h ^ img.GetData()[i])*1099511628211ULL;
+
+  return h;
+} //Checksum
+
+/// Make a batch of empty images, one per file.
+/// \param vecFile File names.
+/// \return Images with only their file names filled in.
+
+static std::vector<CDecodedImage> MakeBatch(const std::vector<std::string>& vecFile){
+  std::vector<CDecodedImage> v(vecFile.size());
+
+  for(size_t i=0; i<v.size(); i++)
+    v[i].m_strFile = vecFile[i];
+
+  return v;
+} //MakeBatch
+
+/// Time a function.
+/// \param f Function.
+/// \return Wall-clock time in milliseconds.
+
+template<class t> static double Time(t f){
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start).count();
+} //Time
+
+/// Get the median of some times.
+/// \param v Times.
+/// \return Median.
+
+static double Median(std::vector<double> v){
+  std::sort(v.begin(), v.end());
+  return v[v.size()/2];
+} //Median
+
+/// Run the benchmark.
+/// \param argc Argument count.
+/// \param argv Arguments.
+/// \return 0 on success, 1 on failure.
+
+int main(int argc, char* argv[]){
+  std::string dir = "Media/Images";
+  std::string cache; //image cache folder
+  int rounds = 5;
+  size_t threads = std::max(1U, std::thread::hardware_concurrency());
+
+  for(int i=1; i<argc; i++){
+    const std::string arg = argv[i];
+
+    if(arg == "--rounds" && i + 1 < argc)rounds = std::max(1, atoi(argv[++i]));
+    else if(arg == "--threads" && i + 1 < argc)threads = std::max(1, atoi(argv[++i]));
+    else if(arg == "--cache" && i + 1 < argc)cache = argv[++i];
+    else if(arg.compare(0, 2, "--") != 0)dir = arg;
+    else{
+      fprintf(stderr, "Usage: DecodeBenchmark [folder] [--rounds n] [--threads n] [--cache folder]\n");
+      return 1;
+    } //else
+  } //for
+
+  const std::vector<std::string> vecFile = ListPNGs(dir);
+
+  if(vecFile.empty()){
+    fprintf(stderr, "No PNG files in %s\n", dir.c_str());
+    return 1;
+  } //if
+
+  CImageFormat format;
+  format.m_nChannels = 4;
+
+  CImageDecoder decoder(threads);
+
+  auto serial = [&](std::vector<CDecodedImage>& v){
+    for(CDecodedImage& img: v)
+      CImageDecoder::DecodeFile(img.m_strFile, img, format);
+  }; //serial
+
+  std::vector<CDecodedImage> vecSerial = MakeBatch(vecFile);
+  std::vector<CDecodedImage> vecParallel = MakeBatch(vecFile);
+  serial(vecSerial); //warm-up
+
+  size_t bytes = 0; //decoded bytes per round
+  size_t failed = 0; //files that didn't decode
+
+  for(const CDecodedImage& img: vecSerial){
+    bytes += img.GetSize();
+    if(!img.IsValid())failed++;
+  } //for
+
+  std::vector<double> vecSerialTime, vecParallelTime;
+
+  for(int r=0; r<rounds; r++){
+    vecSerial = MakeBatch(vecFile);
+    vecParallel = MakeBatch(vecFile);
+    vecSerialTime.push_back(Time([&]{serial(vecSerial);}));
+    vecParallelTime.push_back(Time([&]{decoder.Decode(vecParallel, format);}));
+  } //for
+
+  bool same = Checksum(vecSerial) == Checksum(vecParallel);
+  const double s = Median(vecSerialTime);
+  const double p = Median(vecParallelTime);
+
+  std::vector<double> vecCachedTime;
+  size_t hits = 0; //images found in the cache in the timed rounds
+
+  if(!cache.empty()){
+    CImageDecoder cached(threads);
+    cached.SetCache(cache);
+
+    std::vector<CDecodedImage> vecCached = MakeBatch(vecFile);
+    cached.Decode(vecCached, format); //fill the cache
+    const size_t misses = cached.GetCache()->GetNumMisses();
+
+    for(int r=0; r<rounds; r++){
+      vecCached = MakeBatch(vecFile);
+      vecCachedTime.push_back(Time([&]{cached.Decode(vecCached, format);}));
+    } //for
+
+    same = same && Checksum(vecCached) == Checksum(vecSerial);
+    hits = cached.GetCache()->GetNumHits();
+
+    if(cached.GetCache()->GetNumMisses() > misses)
+      fprintf(stderr, "Image cache in %s missed after it was filled\n", cache.c_str());
+  } //if
+
+  printf("%zu files in %s, %.1f MB decoded per round", vecFile.size(),
+    dir.c_str(), bytes/1048576.0);
+  if(failed > 0)printf(", %zu failed", failed);
+  printf("\n");
+
+  printf("serial:   median %8.2f ms, best %8.2f ms\n", s,
+    *std::min_element(vecSerialTime.begin(), vecSerialTime.end()));
+  printf("parallel: median %8.2f ms, best %8.2f ms on %zu threads (%u hardware threads)\n", p,
+    *std::min_element(vecParallelTime.begin(), vecParallelTime.end()),
+    decoder.GetNumThreads(), std::thread::hardware_concurrency());
+  printf("saved %.2f ms per load, speedup %.2fx", s - p, s/p);
+
+  if(!vecCachedTime.empty()){
+    const double c = Median(vecCachedTime);
+    printf("\ncached:   median %8.2f ms, best %8.2f ms, %zu hits, speedup %.2fx",
+      c, *std::min_element(vecCachedTime.begin(), vecCachedTime.end()), hits, s/c);
+  } //if
+
+  printf(", pixels %s\n", same? "match": "DIFFER");
+
+  return same? 0: 1;
+} //main
@@ -0,0 +1,287 @@
+/// \file MotionBenchmark.cpp
+/// \brief Benchmark for the motion store against per-object movement.
+///
+/// Moves a number of player projectiles for a number of frames twice, first
+/// by calling each projectile's own `move()` function, as the object manager
+/// did before projectiles were registered in the motion store, and then with
+/// the motion store's `Integrate()` and `WriteBack()`, as
+/// `CObjectManager::move()` does now. Each run has its own projectiles,
+/// allocated one at a time as the projectile pool allocates them, and both
+/// start from the same table of positions and velocities, spread over the
+/// world and heading in all directions. The frame times that the engine's
+/// timer gives the first run are replayed in the second, so both runs must
+/// leave the projectiles in the same places, which is checked. Only the
+/// movement is timed. There is no map, so nothing hits a wall.
+///
+/// Options are `--objects n` for the number of projectiles (default 50000),
+/// `--frames n` for the number of frames (default 60), and `--rounds n` for
+/// the number of timed rounds of each (default 5). The median and best times
+/// are reported. It builds as a console project in the solution, and links
+/// the game's object code and the engine, since that is where `move()` lives.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Bullet.h"
+#include "MotionStore.h"
+
+static const float MOTION_WORLD_SIZE = 4096.0f; ///< World width and height.
+static const float MOTION_SPEED = 200.0f; ///< Projectile speed.
+static const float MOTION_TOLERANCE = 0.01f; ///< Largest allowed difference in end position.
+
+/// \brief Starting state.
+///
+/// Where a projectile starts and how fast it goes.
+
+struct CState{
+  Vector2 m_vPos; ///< Position.
+  Vector2 m_vVelocity; ///< Velocity.
+}; //CState
+
+/// \brief Projectile.
+///
+/// A player projectile that starts from a given state. It moves exactly as a
+/// `CBullet` does.
+
+class CProjectile: public CBullet{
+  public:
+    CProjectile(const CState&); ///< Constructor.
+
+    static void SetSpriteSize(const Vector2&); ///< Set projectile sprite size.
+}; //CProjectile
+
+/// Create a player projectile in a given state.
+/// \param s Starting state.
+
+CProjectile::CProjectile(const CState& s): CBullet(eSprite::Bullet, s.m_vPos){
+  m_vVelocity = s.m_vVelocity;
+} //constructor
+
+/// Put the projectile sprite size into the cache of sprite sizes, so that
+/// making a projectile doesn't need a renderer.
+/// \param v Width and height.
+
+void CProjectile::SetSpriteSize(const Vector2& v){
+  m_vSpriteSize[(UINT)eSprite::Bullet] = v;
+} //SetSpriteSize
+
+/// \brief The benchmark.
+///
+/// The engine's timer and the game's common variables are protected static
+/// members of the classes that use them, so the benchmark derives from those
+/// classes to set them up, much as the game class does.
+
+class CMotionBenchmark:
+  public LComponent,
+  public CCommon
+{
+  private:
+    std::vector<CState> m_vecState; ///< Starting states.
+    std::vector<float> m_vecFrameTime; ///< Frame times of the last object run.
+
+    std::vector<CProjectile*> MakeProjectiles() const; ///< Make projectiles.
+    static void Delete(std::vector<CProjectile*>&); ///< Delete projectiles.
+
+  public:
+    CMotionBenchmark(size_t); ///< Constructor.
+    ~CMotionBenchmark(); ///< Destructor.
+
+    const double MoveObjects(UINT, std::vector<Vector2>&); ///< Time per-object movement.
+    const double MoveStore(std::vector<Vector2>&); ///< Time motion store movement.
+}; //CMotionBenchmark
+
+/// Start the engine's timer and make the table of starting states, spread
+/// over a world of `MOTION_WORLD_SIZE` pixels square with velocities of
+/// `MOTION_SPEED` pixels per second in all directions.
+/// \param n Number of projectiles.
+
+CMotionBenchmark::CMotionBenchmark(size_t n){
+  m_pTimer = new LTimer;
+  CProjectile::SetSpriteSize(Vector2(16.0f, 16.0f));
+  m_vecState.resize(n);
+
+  for(size_t i=0; i<n; i++){
+    const float u = (float)(i%997)/997.0f; //spread over the world
+    const float v = (float)(i%991)/991.0f;
+    const float theta = 2.39996f*i; //golden angle
+
+    m_vecState[i].m_vPos = MOTION_WORLD_SIZE*Vector2(u, v);
+    m_vecState[i].m_vVelocity = MOTION_SPEED*Vector2(cosf(theta), sinf(theta));
+  } //for
+} //constructor
+
+/// Stop the engine's timer.
+
+CMotionBenchmark::~CMotionBenchmark(){
+  delete m_pTimer;
+  m_pTimer = nullptr;
+} //destructor
+
+/// Make a projectile in each starting state, one at a time.
+/// \return Pointers to the projectiles.
+
+std::vector<CProjectile*> CMotionBenchmark::MakeProjectiles() const{
+  std::vector<CProjectile*> v;
+  v.reserve(m_vecState.size());
+
+  for(const CState& s: m_vecState)
+    v.push_back(new CProjectile(s));
+
+  return v;
+} //MakeProjectiles
+
+/// Delete projectiles.
+/// \param v [in, out] Pointers to the projectiles, emptied.
+
+void CMotionBenchmark::Delete(std::vector<CProjectile*>& v){
+  for(CProjectile* p: v)
+    delete p;
+
+  v.clear();
+} //Delete
+
+/// Move projectiles for a number of frames by calling each one's `move()`
+/// function inside the engine timer's tick, as the game moves objects, and
+/// remember the frame times.
+/// \param frames Number of frames.
+/// \param vecPos [out] Where the projectiles end up.
+/// \return Time spent moving in milliseconds.
+
+const double CMotionBenchmark::MoveObjects(UINT frames, std::vector<Vector2>& vecPos){
+  using clock = std::chrono::high_resolution_clock;
+  std::vector<CProjectile*> v = MakeProjectiles();
+  m_vecFrameTime.clear();
+  clock::duration t = clock::duration::zero();
+
+  for(UINT f=0; f<frames; f++)
+    m_pTimer->Tick([&](){
+      m_vecFrameTime.push_back(m_pTimer->GetFrameTime());
+      const auto t0 = clock::now();
+
+      for(CProjectile* p: v)
+        p->CBullet::move();
+
+      t += clock::now() - t0;
+    }); //Tick
+
+  vecPos.clear();
+
+  for(const CProjectile* p: v)
+    vecPos.push_back(p->GetPos());
+
+  Delete(v);
+  return std::chrono::duration<double, std::milli>(t).count();
+} //MoveObjects
+
+/// Move projectiles registered in a motion store for the frames of the last
+/// object run, with the same frame times.
+/// \param vecPos [out] Where the projectiles end up.
+/// \return Time spent moving in milliseconds.
+
+const double CMotionBenchmark::MoveStore(std::vector<Vector2>& vecPos){
+  using clock = std::chrono::high_resolution_clock;
+  std::vector<CProjectile*> v = MakeProjectiles();
+
+  CMotionStore store;
+  store.reserve(v.size());
+
+  for(CProjectile* p: v)
+    store.Add(p);
+
+  const auto t0 = clock::now();
+
+  for(float dt: m_vecFrameTime){
+    store.Integrate(dt);
+    store.WriteBack();
+  } //for
+
+  const auto t1 = clock::now();
+
+  vecPos.clear();
+
+  for(const CProjectile* p: v)
+    vecPos.push_back(p->GetPos());
+
+  store.clear();
+  Delete(v);
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+} //MoveStore
+
+/// Median of a list of times.
+/// \param v Times, which get sorted.
+/// \return Median time.
+
+static double Median(std::vector<double>& v){
+  std::sort(v.begin(), v.end());
+  const size_t n = v.size();
+  return n%2? v[n/2]: 0.5*(v[n/2 - 1] + v[n/2]);
+} //Median
+
+/// Largest distance between corresponding positions in two lists.
+/// \param v0 First list.
+/// \param v1 Second list, the same length.
+/// \return Largest distance.
+
+static float MaxDistance(const std::vector<Vector2>& v0, const std::vector<Vector2>& v1){
+  float d = 0.0f;
+
+  for(size_t i=0; i<v0.size(); i++)
+    d = std::max(d, Vector2::Distance(v0[i], v1[i]));
+
+  return d;
+} //MaxDistance
+
+/// Run the benchmark.
+/// \param argc Argument count.
+/// \param argv Arguments.
+/// \return 0 on success, 1 on failure.
+
+int main(int argc, char* argv[]){
+  size_t n = 50000;
+  UINT frames = 60;
+  int rounds = 5;
+
+  for(int i=1; i<argc; i++){
+    const std::string arg = argv[i];
+
+    if(arg == "--objects" && i + 1 < argc)n = (size_t)std::max(1, atoi(argv[++i]));
+    else if(arg == "--frames" && i + 1 < argc)frames = (UINT)std::max(1, atoi(argv[++i]));
+    else if(arg == "--rounds" && i + 1 < argc)rounds = std::max(1, atoi(argv[++i]));
+    else{
+      fprintf(stderr, "Usage: MotionBenchmark [--objects n] [--frames n] [--rounds n]\n");
+      return 1;
+    } //else
+  } //for
+
+  CMotionBenchmark bench(n);
+  std::vector<double> vecObjectTime, vecStoreTime;
+  std::vector<Vector2> vecObjectPos, vecStorePos;
+  float worst = 0.0f; //largest difference in end position
+
+  bench.MoveObjects(frames, vecObjectPos); //warm up
+  bench.MoveStore(vecStorePos);
+
+  for(int r=0; r<rounds; r++){
+    vecObjectTime.push_back(bench.MoveObjects(frames, vecObjectPos));
+    vecStoreTime.push_back(bench.MoveStore(vecStorePos));
+    worst = std::max(worst, MaxDistance(vecObjectPos, vecStorePos));
+  } //for
+
+  const double a = Median(vecObjectTime), b = Median(vecStoreTime); //sorts the times
+
+  printf("%zu projectiles, %u frames, %d rounds\n", n, frames, rounds);
+  printf("  move():       %8.2f ms median %8.2f ms best\n", a, vecObjectTime[0]);
+  printf("  motion store: %8.2f ms median %8.2f ms best, %.2fx\n", b, vecStoreTime[0], a/b);
+
+  if(worst > MOTION_TOLERANCE){
+    fprintf(stderr, "End positions differ by up to %g pixels\n", worst);
+    return 1;
+  } //if
+
+  return 0;
+} //main
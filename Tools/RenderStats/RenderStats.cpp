@@ -0,0 +1,265 @@
+/// \file RenderStats.cpp
+/// \brief Headless draw statistics for a map.
+///
+/// Loads the game's sprite settings into a `CNullRenderer` and a map through
+/// the game's own `CTextMap`, then moves the player over the map for a
+/// number of frames with the camera following, and draws each frame with the
+/// game's drawing code: the baked tile chunks in view, lit by the player's
+/// lantern through the light grid, and the turrets, zombies, furniture, and
+/// player in view all go into a `CRenderQueue`, which sorts them and submits
+/// them to the null renderer, and then the health bar and the minimap are
+/// drawn over them. The draw calls, texture switches, and overdraw are
+/// reported, averaged and at worst over the frames. Nothing is decoded and
+/// no GPU is needed, so it can run on a build machine and fail the build if
+/// drawing gets worse.
+///
+/// Run it from the folder that the game runs from. Options are a settings
+/// file (default `Media/XML/gamesettings.xml`), `--map file` for the map (default
+/// `Media/Maps/map.txt`), `--frames n` for the number of frames (default
+/// 600), and `--max-switches n` and `--max-overdraw x` for limits on the
+/// worst frame, which make it exit with 1 if exceeded. It needs the include
+/// folders of the engine and DirectXTK, for the math types and the sprite
+/// descriptor, but none of their libraries.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "GameDefines.h"
+#include "NullRenderer.h"
+#include "RenderQueue.h"
+#include "TextMap.h"
+#include "TileChunks.h"
+#include "LightGrid.h"
+#include "Minimap.h"
+
+/// \brief Object.
+///
+/// An object on the map, as it is first drawn, and the layer that the object
+/// manager draws objects of its kind in.
+
+struct CObjectDesc{
+  LSpriteDesc2D m_cDesc; ///< Sprite descriptor.
+  eRenderLayer m_eLayer = eRenderLayer::Characters; ///< Layer.
+}; //CObjectDesc
+
+/// \brief Statistics.
+///
+/// Averages and worst values of the frame statistics.
+
+struct CSummary{
+  CRenderStats m_cTotal; ///< Sum over the frames.
+  size_t m_nMaxDraws = 0; ///< Most draws in a frame.
+  size_t m_nMaxSwitches = 0; ///< Most texture switches in a frame.
+  double m_fMaxOverdraw = 0.0; ///< Most overdraw in a frame.
+}; //CSummary
+
+/// Add an object for each position in a spawn table.
+/// \param v Spawn positions.
+/// \param t Sprite that objects of this kind start with.
+/// \param vecObject [in, out] Objects.
+
+static void AddObjects(const std::vector<Vector2>& v, eSprite t,
+  std::vector<CObjectDesc>& vecObject)
+{
+  CObjectDesc d;
+  d.m_cDesc.m_nSpriteIndex = (UINT)t;
+
+  for(const Vector2& pos: v){
+    d.m_cDesc.m_vPos = pos;
+    vecObject.push_back(d);
+  } //for
+} //AddObjects
+
+/// Add the statistics of the last frame to a summary.
+/// \param r Null renderer.
+/// \param s [in, out] Summary.
+
+static void AddFrame(const CNullRenderer& r, CSummary& s){
+  const CRenderStats& f = r.GetFrameStats(); //shorthand
+  s.m_cTotal.Add(f);
+  s.m_nMaxDraws = std::max(s.m_nMaxDraws, f.m_nDraws);
+  s.m_nMaxSwitches = std::max(s.m_nMaxSwitches, f.m_nTextureSwitches);
+  s.m_fMaxOverdraw = std::max(s.m_fMaxOverdraw, r.GetOverdraw(f));
+} //AddFrame
+
+/// Run the statistics.
+/// \param argc Argument count.
+/// \param argv Arguments.
+/// \return 0 on success, 1 on failure or if a limit is exceeded.
+
+int main(int argc, char* argv[]){
+  std::string settings = "Media/XML/gamesettings.xml";
+  std::string mapfile = "Media/Maps/map.txt";
+  int frames = 600;
+  long maxSwitches = -1; //no limit
+  double maxOverdraw = -1.0; //no limit
+
+  for(int i=1; i<argc; i++){
+    const std::string arg = argv[i];
+
+    if(arg == "--map" && i + 1 < argc)mapfile = argv[++i];
+    else if(arg == "--frames" && i + 1 < argc)frames = std::max(1, atoi(argv[++i]));
+    else if(arg == "--max-switches" && i + 1 < argc)maxSwitches = atol(argv[++i]);
+    else if(arg == "--max-overdraw" && i + 1 < argc)maxOverdraw = atof(argv[++i]);
+    else if(arg.compare(0, 2, "--") != 0)settings = arg;
+    else{
+      fprintf(stderr, "Usage: RenderStats [settings] [--map file] [--frames n] [--max-switches n] [--max-overdraw x]\n");
+      return 1;
+    } //else
+  } //for
+
+  CNullRenderer r;
+  if(!r.LoadSettings(settings))return 1;
+
+  const bool loaded =
+    r.Load((UINT)eSprite::Tile, "tile") &&
+    r.Load((UINT)eSprite::Pixel, "pixel") &&
+    r.Load((UINT)eSprite::Turret, "turret") &&
+    r.Load((UINT)eSprite::stationaryturret, "stationaryturret") &&
+    r.Load((UINT)eSprite::HealthBar, "healthbar") &&
+    r.Load((UINT)eSprite::Furniture, "furniture") &&
+    r.Load((UINT)eSprite::PlayerStandDown, "standdown") &&
+    r.Load((UINT)eSprite::ZombieStandDown, "zombiestanddown");
+
+  if(!loaded)return 1;
+
+  const float t = r.GetWidth(eSprite::Tile); //tile size
+  CTextMap map;
+
+  if(!map.Read(mapfile.c_str(), t) || map.GetHeight() == 0){
+    fprintf(stderr, "Cannot read map %s\n", mapfile.c_str());
+    return 1;
+  } //if
+
+  //the map, as the tile manager keeps it
+
+  const size_t w = map.GetWidth(), h = map.GetHeight(); //map size in tiles
+  std::vector<std::string> vecRow(h); //rows of tiles
+  std::vector<char*> vecMap(h); //pointers to rows
+
+  for(size_t i=0; i<h; i++){
+    vecRow[i] = map.GetRow(i);
+    vecMap[i] = &vecRow[i][0];
+  } //for
+
+  CLightGrid lights;
+  lights.Resize(vecMap.data(), w, h, t);
+
+  CTileChunks chunks;
+  chunks.SetMap(vecMap.data(), w, h, t);
+
+  const Vector2 vPixelSize(r.GetWidth(eSprite::Pixel), r.GetHeight(eSprite::Pixel));
+  CMinimap minimap(vPixelSize, r.GetWinWidth(), r.GetWinHeight());
+  minimap.Build(vecMap.data(), w, h, t);
+
+  //the objects on the map, which the minimap marks if they are enemies
+
+  std::vector<CObjectDesc> vecObject;
+  AddObjects(map.GetTurrets(), eSprite::Turret, vecObject);
+  AddObjects(map.GetStationaryTurrets(), eSprite::stationaryturret, vecObject);
+  AddObjects(map.GetZombies(), eSprite::ZombieStandDown, vecObject);
+
+  std::vector<Vector2> vecEnemy;
+
+  for(const CObjectDesc& d: vecObject)
+    vecEnemy.push_back(d.m_cDesc.m_vPos);
+
+  for(const CTextMap::CFurniture& f: map.GetFurniture()){
+    CObjectDesc d;
+    d.m_cDesc.m_nSpriteIndex = (UINT)eSprite::Furniture;
+    d.m_cDesc.m_nCurrentFrame = f.m_chType - '0';
+    d.m_cDesc.m_vPos = f.m_vPos;
+    d.m_eLayer = eRenderLayer::Furniture;
+    vecObject.push_back(d);
+  } //for
+
+  CObjectDesc player; //moved every frame
+  player.m_cDesc.m_nSpriteIndex = (UINT)eSprite::PlayerStandDown;
+  player.m_cDesc.m_vPos = map.GetPlayerPos();
+  const UINT lantern = lights.Add(player.m_cDesc.m_vPos, LIGHT_PLAYER);
+
+  LSpriteDesc2D bar; //health bar, full
+  bar.m_nSpriteIndex = (UINT)eSprite::HealthBar;
+  bar.m_nCurrentFrame = (UINT)std::max<size_t>(r.GetNumFrames(eSprite::HealthBar), 1) - 1;
+
+  //move the player over the map on a Lissajous curve, with the camera
+  //following and clamped to the world as CGame::FollowCamera() clamps it
+
+  const float worldW = t*w, worldH = t*h; //world size
+  const float W = (float)r.GetWinWidth(), H = (float)r.GetWinHeight(); //window size
+
+  CRenderQueue q;
+  CSummary summary;
+
+  for(int k=0; k<frames; k++){
+    const float a = XM_2PI*k/frames; //angle around the curve
+    Vector2& pos = player.m_cDesc.m_vPos; //shorthand
+    pos = Vector2(0.5f*worldW*(1.0f + sinf(a)), 0.5f*worldH*(1.0f + sinf(2.0f*a)));
+    lights.Move(lantern, pos);
+    lights.Update(0.0f); //nothing expires
+
+    Vector2 cam = pos;
+    cam.x = worldW > W? std::min(std::max(cam.x, W/2), worldW - W/2): worldW/2;
+    cam.y = worldH > H? std::min(std::max(cam.y, H/2), worldH - H/2): worldH/2;
+    r.SetCameraPos(cam);
+
+    r.BeginFrame();
+
+    //the background and the objects in view, as CObjectManager::draw() does
+
+    q.clear();
+    chunks.Draw(eSprite::Tile, lights, cam, r.GetWinWidth(), r.GetWinHeight(), q);
+
+    auto queue = [&](const CObjectDesc& d){
+      const UINT n = d.m_cDesc.m_nSpriteIndex; //shorthand
+      const float x = 0.5f*(W + r.GetWidth(n)); //half visible width
+      const float y = 0.5f*(H + r.GetHeight(n)); //half visible height
+
+      if(fabsf(d.m_cDesc.m_vPos.x - cam.x) < x && fabsf(d.m_cDesc.m_vPos.y - cam.y) < y)
+        q.Add(d.m_cDesc, d.m_eLayer);
+    }; //queue
+
+    for(const CObjectDesc& d: vecObject)
+      queue(d);
+
+    queue(player);
+    q.Submit(&r);
+
+    //the heads-up display, placed as CHud places it
+
+    bar.m_vPos.x = cam.x + HUD_MARGIN + 0.5f*(r.GetWidth(eSprite::HealthBar) - W);
+    bar.m_vPos.y = cam.y + HUD_MARGIN + 0.5f*(r.GetHeight(eSprite::HealthBar) - H);
+    r.Draw(&bar);
+    minimap.Draw(&r, cam, &pos, vecEnemy);
+
+    r.EndFrame();
+    AddFrame(r, summary);
+  } //for
+
+  printf("%s, %zu by %zu tiles, %d frames in a %d by %d window, %zu textures\n",
+    mapfile.c_str(), w, h, frames, r.GetWinWidth(), r.GetWinHeight(),
+    r.GetNumTextures());
+
+  printf("draws %7.1f avg %5zu max, switches %6.1f avg %4zu max, overdraw %.2f avg %.2f max\n",
+    (double)summary.m_cTotal.m_nDraws/frames, summary.m_nMaxDraws,
+    (double)summary.m_cTotal.m_nTextureSwitches/frames, summary.m_nMaxSwitches,
+    r.GetOverdraw(summary.m_cTotal, frames), summary.m_fMaxOverdraw);
+
+  bool ok = true;
+
+  if(maxSwitches >= 0 && summary.m_nMaxSwitches > (size_t)maxSwitches){
+    fprintf(stderr, "Texture switches %zu exceed %ld\n", summary.m_nMaxSwitches, maxSwitches);
+    ok = false;
+  } //if
+
+  if(maxOverdraw >= 0.0 && summary.m_fMaxOverdraw > maxOverdraw){
+    fprintf(stderr, "Overdraw %.2f exceeds %.2f\n", summary.m_fMaxOverdraw, maxOverdraw);
+    ok = false;
+  } //if
+
+  return ok? 0: 1;
+} //main